@@ -0,0 +1,580 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logger.h>
+#include <log4cxx/logmanager.h>
+#include <log4cxx/level.h>
+#include <log4cxx/appenderskeleton.h>
+#include <log4cxx/asyncappender.h>
+#include <log4cxx/fileappender.h>
+#include <log4cxx/patternlayout.h>
+#include <log4cxx/jsonlayout.h>
+#include <log4cxx/xml/xmllayout.h>
+#include <log4cxx/pattern/patternparser.h>
+#include <log4cxx/spi/loggingevent.h>
+#include <log4cxx/helpers/thread.h>
+#include <apr_general.h>
+#include <apr_time.h>
+#include <iostream>
+#include <exception>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+
+/**
+An appender that discards every event, so that a benchmark measures
+the cost of the logging framework rather than that of the output.
+*/
+class NullAppender : public AppenderSkeleton
+{
+public:
+        DECLARE_LOG4CXX_OBJECT(NullAppender)
+        BEGIN_LOG4CXX_CAST_MAP()
+                LOG4CXX_CAST_ENTRY(NullAppender)
+                LOG4CXX_CAST_ENTRY_CHAIN(AppenderSkeleton)
+        END_LOG4CXX_CAST_MAP()
+
+        void append(const spi::LoggingEventPtr&, Pool&)
+        {
+        }
+
+        void close()
+        {
+                closed = true;
+        }
+
+        bool requiresLayout() const
+        {
+                return false;
+        }
+};
+
+IMPLEMENT_LOG4CXX_OBJECT(NullAppender)
+
+
+/**
+A PatternLayout that formats by calling each converter and field
+in turn, as PatternLayout did before it compiled its pattern, so
+that the two can be compared.
+*/
+class InterpretedPatternLayout : public PatternLayout
+{
+public:
+        InterpretedPatternLayout(const LogString& pattern) : PatternLayout(pattern)
+        {
+                std::vector<pattern::PatternConverterPtr> parsed;
+                FormattingInfoList parsedFields;
+                pattern::PatternParser::parse(pattern, parsed, parsedFields, getFormatSpecifiers());
+                for(size_t i = 0; i < parsed.size(); i++)
+                {
+                        pattern::LoggingEventPatternConverterPtr converter(parsed[i]);
+                        if (converter != NULL)
+                        {
+                                converters.push_back(converter);
+                                fields.push_back(parsedFields[i]);
+                        }
+                }
+        }
+
+        void format(LogString& output, const spi::LoggingEventPtr& event, Pool& pool) const
+        {
+                for(size_t i = 0; i < converters.size(); i++)
+                {
+                        int startField = output.length();
+                        converters[i]->format(event, output, pool);
+                        fields[i]->format(startField, output);
+                }
+        }
+
+private:
+        LoggingEventPatternConverterList converters;
+        FormattingInfoList fields;
+};
+
+/**
+This program measures the per-call cost of the logging hot path.
+Run it against two builds to compare them; each benchmark prints the
+elapsed time and the average cost of a single operation.
+*/
+class Benchmark
+{
+public:
+        typedef void (*Function)(int iterations);
+
+        struct Entry
+        {
+                const char* name;
+                const char* description;
+                Function run;
+        };
+
+        static void main(int argc, const char * const argv[])
+        {
+                int iterations = 1000000;
+                int first = 1;
+
+                if (argc > 1 && argv[1][0] >= '0' && argv[1][0] <= '9')
+                {
+                        iterations = atoi(argv[1]);
+                        first = 2;
+                }
+
+                const Entry* entries = getEntries();
+                for(const Entry* entry = entries; entry->name != 0; entry++)
+                {
+                        bool selected = (first >= argc);
+                        for(int i = first; i < argc && !selected; i++)
+                        {
+                                selected = (strcmp(argv[i], entry->name) == 0);
+                        }
+
+                        if (selected)
+                        {
+                                run(*entry, iterations);
+                        }
+                }
+        }
+
+        static LoggerPtr getLogger(const char* name)
+        {
+                LoggerPtr logger(Logger::getLogger(name));
+                logger->removeAllAppenders();
+                logger->setAdditivity(false);
+                logger->setLevel(Level::getInfo());
+                logger->addAppender(new NullAppender());
+                return logger;
+        }
+
+        static LoggerPtr getAsyncLogger(const char* name, bool ringBuffer)
+        {
+                LoggerPtr logger(Logger::getLogger(name));
+                logger->removeAllAppenders();
+                logger->setAdditivity(false);
+                logger->setLevel(Level::getInfo());
+                AsyncAppenderPtr async(new AsyncAppender());
+                async->setBufferSize(1024);
+                async->setRingBuffer(ringBuffer);
+                async->addAppender(new NullAppender());
+                Pool p;
+                async->activateOptions(p);
+                logger->addAppender(async);
+                return logger;
+        }
+
+        /**
+        Runs a benchmark concurrently on each of the given number of
+        threads and returns the elapsed time in microseconds.
+        */
+        static apr_time_t runThreads(Function function, int threadCount, int iterations)
+        {
+                ThreadArgs args = { function, iterations };
+                Thread* threads = new Thread[threadCount];
+                apr_time_t start = apr_time_now();
+                for(int i = 0; i < threadCount; i++)
+                {
+                        threads[i].run(runThread, &args);
+                }
+                for(int i = 0; i < threadCount; i++)
+                {
+                        threads[i].join();
+                }
+                apr_time_t elapsed = apr_time_now() - start;
+                delete [] threads;
+                return elapsed;
+        }
+
+        /**
+        Reports events per second as the thread count grows, keeping
+        the total number of events constant.
+        */
+        static void scale(const char* name, Function function, int iterations)
+        {
+                static const int threadCounts[] = { 1, 2, 4, 8, 16, 32 };
+                for(size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++)
+                {
+                        int threadCount = threadCounts[i];
+                        int perThread = iterations / threadCount;
+                        apr_time_t elapsed = runThreads(function, threadCount, perThread);
+                        if (elapsed <= 0)
+                        {
+                                elapsed = 1;
+                        }
+                        std::cout << "  " << name << " x" << threadCount << ": "
+                                  << ((double) perThread * threadCount * 1000000 / elapsed)
+                                  << " events/s" << std::endl;
+                }
+        }
+
+private:
+        enum { FILE_BATCH = 64 };
+
+        struct ThreadArgs
+        {
+                Function run;
+                int iterations;
+        };
+
+        static void* LOG4CXX_THREAD_FUNC runThread(apr_thread_t*, void* data)
+        {
+                ThreadArgs* args = (ThreadArgs*) data;
+                args->run(args->iterations);
+                return 0;
+        }
+
+        static void run(const Entry& entry, int iterations)
+        {
+                apr_time_t start = apr_time_now();
+                entry.run(iterations);
+                apr_time_t elapsed = apr_time_now() - start;
+
+                std::cout << entry.name << ": " << iterations << " iterations in "
+                          << (elapsed / 1000) << " ms, "
+                          << ((double) elapsed * 1000 / iterations) << " ns/op ("
+                          << entry.description << ")" << std::endl;
+        }
+
+        static void levelGetter(int iterations)
+        {
+                int sum = 0;
+                for(int i = 0; i < iterations; i++)
+                {
+                        sum += Level::getDebug()->toInt();
+                }
+                if (sum == 0)
+                {
+                        std::cout << sum;
+                }
+        }
+
+        static void disabledDebug(int iterations)
+        {
+                LoggerPtr logger(getLogger("benchmark.disabled"));
+                for(int i = 0; i < iterations; i++)
+                {
+                        LOG4CXX_DEBUG(logger, "disabled message " << i);
+                }
+        }
+
+        static void deepDisabledDebug(int iterations)
+        {
+                getLogger("benchmark.deep");
+                LoggerPtr logger(Logger::getLogger("benchmark.deep.a.b.c.d.e.f.g.h"));
+                for(int i = 0; i < iterations; i++)
+                {
+                        LOG4CXX_DEBUG(logger, "disabled message " << i);
+                }
+        }
+
+        static void enabledInfo(int iterations)
+        {
+                LoggerPtr logger(getLogger("benchmark.enabled"));
+                for(int i = 0; i < iterations; i++)
+                {
+                        LOG4CXX_INFO(logger, "enabled message");
+                }
+        }
+
+        static void streamInfo(int iterations)
+        {
+                LoggerPtr logger(getLogger("benchmark.stream"));
+                for(int i = 0; i < iterations; i++)
+                {
+                        LOG4CXX_INFO(logger, "x=" << i << " y=" << 2.5 << " name=" << "request");
+                }
+        }
+
+        static void deferredInfo(int iterations)
+        {
+                LoggerPtr logger(getLogger("benchmark.deferred"));
+                for(int i = 0; i < iterations; i++)
+                {
+                        LOG4CXX_INFO_FMT(logger, "x={} y={} name={}", i, 2.5, "request");
+                }
+        }
+
+        static void threadedInfo(int iterations)
+        {
+                getLogger("benchmark.threaded");
+                scale("enabled", threadedInfoLoop, iterations);
+        }
+
+        static void threadedInfoLoop(int iterations)
+        {
+                LoggerPtr logger(Logger::getLogger("benchmark.threaded"));
+                for(int i = 0; i < iterations; i++)
+                {
+                        LOG4CXX_INFO(logger, "enabled message");
+                }
+        }
+
+        static void fanoutInfo(int iterations)
+        {
+                getLogger("benchmark.fanout");
+                Logger::getLogger("benchmark.fanout.a.b")->addAppender(new NullAppender());
+                scale("fanout", fanoutInfoLoop, iterations);
+        }
+
+        static void fanoutInfoLoop(int iterations)
+        {
+                LoggerPtr logger(Logger::getLogger("benchmark.fanout.a.b.c.d"));
+                for(int i = 0; i < iterations; i++)
+                {
+                        LOG4CXX_INFO(logger, "enabled message");
+                }
+        }
+
+        static void lookup(int iterations)
+        {
+                getLogger("benchmark.lookup.a.b");
+                scale("lookup", lookupLoop, iterations);
+        }
+
+        static void lookupLoop(int iterations)
+        {
+                LogString name(LOG4CXX_STR("benchmark.lookup.a.b"));
+                for(int i = 0; i < iterations; i++)
+                {
+                        LogManager::getLoggerLS(name);
+                }
+        }
+
+        static void formatPattern(const Layout& layout, int iterations)
+        {
+                spi::LoggingEventPtr event(new spi::LoggingEvent(
+                        LOG4CXX_STR("benchmark.layout"), Level::getInfo(),
+                        LOG4CXX_STR("enabled message"), spi::LocationInfo::getLocationUnavailable()));
+                Pool p;
+                size_t total = 0;
+                for(int i = 0; i < iterations; i++)
+                {
+                        LogString output;
+                        layout.format(output, event, p);
+                        total += output.length();
+                }
+                if (total == 0)
+                {
+                        std::cout << total;
+                }
+        }
+
+        static void compiledLayout(int iterations)
+        {
+                PatternLayoutPtr layout(new PatternLayout(LOG4CXX_STR("%d [%t] %-5p %c - %m%n")));
+                formatPattern(*layout, iterations);
+        }
+
+        static void interpretedLayout(int iterations)
+        {
+                PatternLayoutPtr layout(new InterpretedPatternLayout(LOG4CXX_STR("%d [%t] %-5p %c - %m%n")));
+                formatPattern(*layout, iterations);
+        }
+
+        static void jsonLayout(int iterations)
+        {
+                LayoutPtr layout(new JSONLayout());
+                formatPattern(*layout, iterations);
+        }
+
+        static void xmlLayout(int iterations)
+        {
+                LayoutPtr layout(new xml::XMLLayout());
+                formatPattern(*layout, iterations);
+        }
+
+        static void asyncInfo(int iterations)
+        {
+                LoggerPtr logger(getAsyncLogger("benchmark.async", false));
+                scale("async", asyncInfoLoop, iterations);
+                logger->removeAllAppenders();
+        }
+
+        static void asyncInfoLoop(int iterations)
+        {
+                LoggerPtr logger(Logger::getLogger("benchmark.async"));
+                for(int i = 0; i < iterations; i++)
+                {
+                        LOG4CXX_INFO(logger, "enabled message");
+                }
+        }
+
+        static void asyncRingInfo(int iterations)
+        {
+                LoggerPtr logger(getAsyncLogger("benchmark.asyncring", true));
+                scale("asyncring", asyncRingInfoLoop, iterations);
+                logger->removeAllAppenders();
+        }
+
+        static void asyncRingInfoLoop(int iterations)
+        {
+                LoggerPtr logger(Logger::getLogger("benchmark.asyncring"));
+                for(int i = 0; i < iterations; i++)
+                {
+                        LOG4CXX_INFO(logger, "enabled message");
+                }
+        }
+
+        /**
+        Returns a FileAppender that flushes every append, so that each
+        doAppend or doAppendAll call is one trip to the kernel.
+        */
+        static FileAppenderPtr getFileAppender(const LogString& filename)
+        {
+                FileAppenderPtr appender(new FileAppender(
+                        new PatternLayout(LOG4CXX_STR("%d [%t] %-5p %c - %m%n")),
+                        filename, false));
+                appender->setImmediateFlush(true);
+                return appender;
+        }
+
+        static spi::LoggingEventList getFileEvents(size_t count)
+        {
+                spi::LoggingEventList events;
+                for(size_t i = 0; i < count; i++)
+                {
+                        events.push_back(new spi::LoggingEvent(
+                                LOG4CXX_STR("benchmark.file"), Level::getInfo(),
+                                LOG4CXX_STR("enabled message"), spi::LocationInfo::getLocationUnavailable()));
+                }
+                return events;
+        }
+
+        static void fileSingle(int iterations)
+        {
+                FileAppenderPtr appender(getFileAppender(LOG4CXX_STR("benchmark-single.log")));
+                spi::LoggingEventList events(getFileEvents(FILE_BATCH));
+                Pool p;
+                for(int i = 0; i < iterations; i += FILE_BATCH)
+                {
+                        for(spi::LoggingEventList::iterator iter = events.begin();
+                                iter != events.end();
+                                iter++)
+                        {
+                                appender->doAppend(*iter, p);
+                        }
+                }
+                appender->close();
+        }
+
+        static void fileBatch(int iterations)
+        {
+                FileAppenderPtr appender(getFileAppender(LOG4CXX_STR("benchmark-batch.log")));
+                spi::LoggingEventList events(getFileEvents(FILE_BATCH));
+                Pool p;
+                for(int i = 0; i < iterations; i += FILE_BATCH)
+                {
+                        appender->doAppendAll(events, p);
+                }
+                appender->close();
+        }
+
+        /**
+        Times each append to a file and prints latency percentiles.
+        To see the effect of disk stalls, throttle or delay the device
+        holding the working directory while this runs, for example
+        with a cgroup io.max limit or a dm-delay target.
+        */
+        static void appendLatency(const LogString& filename, bool ioUring, int iterations)
+        {
+                FileAppenderPtr appender(new FileAppender());
+                appender->setFile(filename);
+                appender->setAppend(false);
+                appender->setLayout(new PatternLayout(LOG4CXX_STR("%d [%t] %-5p %c - %m%n")));
+                appender->setIOUring(ioUring);
+                appender->setBufferSize(64 * 1024);
+                Pool p;
+                appender->activateOptions(p);
+
+                spi::LoggingEventPtr event(new spi::LoggingEvent(
+                        LOG4CXX_STR("benchmark.latency"), Level::getInfo(),
+                        LOG4CXX_STR("enabled message"), spi::LocationInfo::getLocationUnavailable()));
+                std::vector<apr_time_t> latencies(iterations > 0 ? iterations : 1);
+                for(int i = 0; i < iterations; i++)
+                {
+                        apr_time_t start = apr_time_now();
+                        appender->doAppend(event, p);
+                        latencies[i] = apr_time_now() - start;
+                }
+                appender->close();
+
+                std::sort(latencies.begin(), latencies.end());
+                size_t last = latencies.size() - 1;
+                std::cout << "  " << (ioUring ? "io_uring" : "write") << " latency us:"
+                          << " p50 " << latencies[last / 2]
+                          << " p99 " << latencies[last * 99 / 100]
+                          << " p99.9 " << latencies[last * 999 / 1000]
+                          << " max " << latencies[last] << std::endl;
+        }
+
+        static void writeLatency(int iterations)
+        {
+                appendLatency(LOG4CXX_STR("benchmark-latency.log"), false, iterations);
+        }
+
+        static void uringLatency(int iterations)
+        {
+                appendLatency(LOG4CXX_STR("benchmark-latency.log"), true, iterations);
+        }
+
+        static const Entry* getEntries()
+        {
+                static const Entry entries[] =
+                {
+                        { "level", "Level::getDebug()", levelGetter },
+                        { "disabled", "LOG4CXX_DEBUG below threshold", disabledDebug },
+                        { "deepdisabled", "LOG4CXX_DEBUG below an inherited threshold", deepDisabledDebug },
+                        { "enabled", "LOG4CXX_INFO to a null appender", enabledInfo },
+                        { "stream", "LOG4CXX_INFO with three inserted values", streamInfo },
+                        { "deferred", "LOG4CXX_INFO_FMT with three captured values", deferredInfo },
+                        { "threaded", "LOG4CXX_INFO to a null appender from 1-32 threads", threadedInfo },
+                        { "async", "LOG4CXX_INFO to an AsyncAppender from 1-32 threads", asyncInfo },
+                        { "asyncring", "LOG4CXX_INFO to a ring buffer AsyncAppender from 1-32 threads", asyncRingInfo },
+                        { "layout", "PatternLayout::format of %d [%t] %-5p %c - %m%n", compiledLayout },
+                        { "layoutinterpreted", "the same pattern, calling each converter in turn", interpretedLayout },
+                        { "json", "JSONLayout::format", jsonLayout },
+                        { "xml", "XMLLayout::format of the same event", xmlLayout },
+                        { "lookup", "LogManager::getLoggerLS of an existing logger from 1-32 threads", lookup },
+                        { "fanout", "LOG4CXX_INFO to null appenders on two ancestors from 1-32 threads", fanoutInfo },
+                        { "filesingle", "FileAppender::doAppend with immediate flush, one write per event", fileSingle },
+                        { "filebatch", "FileAppender::doAppendAll of 64 events, one gathered write per batch", fileBatch },
+                        { "latency", "FileAppender::doAppend latency percentiles writing the file directly", writeLatency },
+                        { "latencyuring", "FileAppender::doAppend latency percentiles with IOUring", uringLatency },
+                        { 0, 0, 0 }
+                };
+                return entries;
+        }
+};
+
+int main(int argc, const char * const argv[])
+{
+    apr_app_initialize(&argc, &argv, NULL);
+    int result = EXIT_SUCCESS;
+    try
+    {
+        Benchmark::main(argc, argv);
+    }
+    catch(std::exception&)
+    {
+        result = EXIT_FAILURE;
+    }
+
+    apr_terminate();
+    return result;
+}
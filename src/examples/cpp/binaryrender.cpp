@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logger.h>
+#include <log4cxx/logmanager.h>
+#include <log4cxx/level.h>
+#include <log4cxx/consoleappender.h>
+#include <log4cxx/patternlayout.h>
+#include <log4cxx/propertyconfigurator.h>
+#include <log4cxx/xml/domconfigurator.h>
+#include <log4cxx/spi/loggingevent.h>
+#include <log4cxx/helpers/binarylogreader.h>
+#include <log4cxx/helpers/fileinputstream.h>
+#include <log4cxx/helpers/exception.h>
+#include <log4cxx/helpers/pool.h>
+#include <log4cxx/helpers/transcoder.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::spi;
+
+static int usage() {
+    fputs("Renders files written by BinaryLayout\n"
+          "Usage: binaryrender [-p pattern | -c configuration] file...\n"
+          "  -p  PatternLayout pattern for standard output, by default\n"
+          "      \"%d %-5p %c [%t] %x - %m%n\"\n"
+          "  -c  configuration file, events are passed to the appenders\n"
+          "      of their loggers as configured there\n", stderr);
+    return 2;
+}
+
+/**
+ *   Configures the root logger to write to standard output
+ *   with a PatternLayout.
+ */
+static void configurePattern(const LogString& pattern) {
+    LayoutPtr layout(new PatternLayout(pattern));
+    AppenderPtr appender(new ConsoleAppender(layout));
+    LoggerPtr root(Logger::getRootLogger());
+    root->addAppender(appender);
+    root->setLevel(Level::getAll());
+    LogManager::getLoggerRepository()->setConfigured(true);
+}
+
+/**
+ *   Configures from a properties or, if the name ends in .xml,
+ *   an XML configuration file.
+ */
+static void configureFile(const std::string& configuration) {
+    size_t length = configuration.length();
+    if (length > 4 && configuration.compare(length - 4, 4, ".xml") == 0) {
+        xml::DOMConfigurator::configure(configuration);
+    } else {
+        PropertyConfigurator::configure(File(configuration));
+    }
+}
+
+/**
+ *   Reads the events of a file written by BinaryLayout and passes
+ *   them to the appenders of their loggers, subject to the
+ *   loggers' levels.
+ */
+static void render(const std::string& fileName) {
+    LOG4CXX_DECODE_CHAR(name, fileName);
+    BinaryLogReader reader(new FileInputStream(name));
+    Pool pool;
+    for(LoggingEventPtr event(reader.read()); event != NULL; event = reader.read()) {
+        LoggerPtr logger(Logger::getLogger(event->getLoggerName()));
+        if (event->getLevel()->isGreaterOrEqual(logger->getEffectiveLevel())) {
+            logger->callAppenders(event, pool);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int first = 1;
+    if (argc > 2 && strcmp(argv[1], "-p") == 0) {
+        LOG4CXX_DECODE_CHAR(pattern, std::string(argv[2]));
+        configurePattern(pattern);
+        first = 3;
+    } else if (argc > 2 && strcmp(argv[1], "-c") == 0) {
+        configureFile(std::string(argv[2]));
+        first = 3;
+    } else {
+        configurePattern(LogString(LOG4CXX_STR("%d %-5p %c [%t] %x - %m%n")));
+    }
+    if (first >= argc) {
+        return usage();
+    }
+
+    int result = 0;
+    for(int i = first; i < argc; i++) {
+        try {
+            render(argv[i]);
+        } catch(IOException& ex) {
+            fprintf(stderr, "%s: %s\n", argv[i], ex.what());
+            result = 1;
+        }
+    }
+    return result;
+}
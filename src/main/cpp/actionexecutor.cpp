@@ -0,0 +1,157 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/rolling/actionexecutor.h>
+#include <log4cxx/helpers/synchronized.h>
+#include <log4cxx/helpers/loglog.h>
+#include <log4cxx/helpers/exception.h>
+#include <apr_thread_proc.h>
+
+using namespace log4cxx;
+using namespace log4cxx::rolling;
+using namespace log4cxx::helpers;
+
+namespace
+{
+/**
+ *  Set once the shared executor has been destroyed at exit,
+ *  after which actions run on the caller's thread.
+ */
+bool executorDestroyed = false;
+}
+
+ActionExecutor::ActionExecutor()
+	: pool(), mutex(pool), pending(pool), queue(), workers(),
+	  threadCount(2), closed(false)
+{
+}
+
+ActionExecutor::~ActionExecutor()
+{
+	{
+		synchronized sync(mutex);
+		closed = true;
+		pending.signalAll();
+	}
+
+	//
+	//   workers finish the queued actions before exiting
+	//
+	for (std::vector<Thread*>::iterator iter = workers.begin();
+		iter != workers.end();
+		iter++)
+	{
+		(*iter)->join();
+		delete *iter;
+	}
+
+	executorDestroyed = true;
+}
+
+ActionExecutor& ActionExecutor::getInstance()
+{
+	static ActionExecutor instance;
+	return instance;
+}
+
+void ActionExecutor::execute(const ActionPtr& action)
+{
+#if APR_HAS_THREADS
+
+	if (!executorDestroyed)
+	{
+		getInstance().enqueue(action);
+		return;
+	}
+
+#endif
+	Pool p;
+	action->run(p);
+}
+
+void ActionExecutor::await(const ActionPtr& action)
+{
+	//
+	//   Action::run holds the action's mutex while executing and
+	//     does nothing once the action has run, so this either
+	//     runs a still queued action or waits for the worker
+	//     running it.  A worker reaching it later skips it.
+	//
+	Pool p;
+	action->run(p);
+}
+
+void ActionExecutor::setThreadCount(int count)
+{
+	ActionExecutor& executor = getInstance();
+	synchronized sync(executor.mutex);
+	executor.threadCount = count > 0 ? count : 1;
+}
+
+void ActionExecutor::enqueue(const ActionPtr& action)
+{
+	synchronized sync(mutex);
+	queue.push_back(action);
+
+	if (workers.size() < threadCount)
+	{
+		Thread* worker = new Thread();
+
+		try
+		{
+			worker->run(work, this);
+			workers.push_back(worker);
+		}
+		catch (ThreadException& ex)
+		{
+			delete worker;
+			LogLog::warn(LOG4CXX_STR("Unable to start rollover thread"), ex);
+		}
+	}
+
+	pending.signalAll();
+}
+
+void* LOG4CXX_THREAD_FUNC ActionExecutor::work(apr_thread_t* /* thread */, void* data)
+{
+	ActionExecutor* pThis = (ActionExecutor*) data;
+
+	for (;;)
+	{
+		ActionPtr action;
+		{
+			synchronized sync(pThis->mutex);
+
+			while (pThis->queue.empty() && !pThis->closed)
+			{
+				pThis->pending.await(pThis->mutex);
+			}
+
+			if (pThis->queue.empty())
+			{
+				return 0;
+			}
+
+			action = pThis->queue.front();
+			pThis->queue.pop_front();
+		}
+
+		Pool p;
+		action->run(p);
+	}
+}
@@ -17,6 +17,7 @@
 #include <log4cxx/logstring.h>
 #include <log4cxx/helpers/appenderattachableimpl.h>
 #include <log4cxx/appender.h>
+#include <log4cxx/appenderskeleton.h>
 #include <log4cxx/spi/loggingevent.h>
 #include <algorithm>
 #include <log4cxx/helpers/pool.h>
@@ -76,6 +77,34 @@ int AppenderAttachableImpl::appendLoopOnAppenders(
 	return appenderList.size();
 }
 
+int AppenderAttachableImpl::appendLoopOnAppenders(
+	const spi::LoggingEventList& events,
+	Pool& p)
+{
+	for (AppenderList::iterator it = appenderList.begin();
+		it != appenderList.end();
+		it++)
+	{
+		ObjectPtrT<AppenderSkeleton> skeleton(*it);
+
+		if (skeleton != 0)
+		{
+			skeleton->doAppendAll(events, p);
+		}
+		else
+		{
+			for (spi::LoggingEventList::const_iterator iter = events.begin();
+				iter != events.end();
+				iter++)
+			{
+				(*it)->doAppend(*iter, p);
+			}
+		}
+	}
+
+	return appenderList.size();
+}
+
 AppenderList AppenderAttachableImpl::getAllAppenders() const
 {
 	return appenderList;
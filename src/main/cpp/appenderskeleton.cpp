@@ -105,7 +105,7 @@ void AppenderSkeleton::clearFilters()
 
 bool AppenderSkeleton::isAsSevereAsThreshold(const LevelPtr& level) const
 {
-	return ((level == 0) || level->isGreaterOrEqual(threshold));
+	return ((level == 0) || level->toInt() >= threshold->toInt());
 }
 
 void AppenderSkeleton::doAppend(const spi::LoggingEventPtr& event, Pool& pool1)
@@ -124,11 +124,59 @@ void AppenderSkeleton::doAppendImpl(const spi::LoggingEventPtr& event, Pool& poo
 		return;
 	}
 
-	if (!isAsSevereAsThreshold(event->getLevel()))
+	if (isAccepted(event))
+	{
+		append(event, pool1);
+	}
+}
+
+void AppenderSkeleton::doAppendAll(const spi::LoggingEventList& events, Pool& pool1)
+{
+	LOCK_W sync(mutex);
+
+	if (closed)
 	{
+		LogLog::error(((LogString) LOG4CXX_STR("Attempted to append to closed appender named ["))
+			+ name + LOG4CXX_STR("]."));
 		return;
 	}
 
+	LoggingEventList accepted;
+	accepted.reserve(events.size());
+
+	for (LoggingEventList::const_iterator iter = events.begin();
+		iter != events.end();
+		iter++)
+	{
+		if (isAccepted(*iter))
+		{
+			accepted.push_back(*iter);
+		}
+	}
+
+	if (!accepted.empty())
+	{
+		appendAll(accepted, pool1);
+	}
+}
+
+void AppenderSkeleton::appendAll(const spi::LoggingEventList& events, Pool& pool1)
+{
+	for (LoggingEventList::const_iterator iter = events.begin();
+		iter != events.end();
+		iter++)
+	{
+		append(*iter, pool1);
+	}
+}
+
+bool AppenderSkeleton::isAccepted(const spi::LoggingEventPtr& event) const
+{
+	if (!isAsSevereAsThreshold(event->getLevel()))
+	{
+		return false;
+	}
+
 	FilterPtr f = headFilter;
 
 
@@ -137,18 +185,17 @@ void AppenderSkeleton::doAppendImpl(const spi::LoggingEventPtr& event, Pool& poo
 		switch (f->decide(event))
 		{
 			case Filter::DENY:
-				return;
+				return false;
 
 			case Filter::ACCEPT:
-				f = 0;
-				break;
+				return true;
 
 			case Filter::NEUTRAL:
 				f = f->getNext();
 		}
 	}
 
-	append(event, pool1);
+	return true;
 }
 
 void AppenderSkeleton::setErrorHandler(const spi::ErrorHandlerPtr& errorHandler1)
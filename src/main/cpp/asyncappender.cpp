@@ -32,12 +32,28 @@
 #include <log4cxx/helpers/stringhelper.h>
 #include <apr_atomic.h>
 #include <log4cxx/helpers/optionconverter.h>
+#include <log4cxx/helpers/threadspecificdata.h>
 
 
 using namespace log4cxx;
 using namespace log4cxx::helpers;
 using namespace log4cxx::spi;
 
+namespace
+{
+//
+//   Number of times the ring buffer dispatcher polls an empty ring,
+//      and then yields, before waiting to be signalled.
+//
+enum { DISPATCH_SPIN_COUNT = 100, DISPATCH_YIELD_COUNT = 10 };
+
+//
+//   Number of times a caller yields to the dispatcher when the
+//      ring buffer is full before waiting to be signalled.
+//
+enum { APPEND_YIELD_COUNT = 10 };
+}
+
 
 IMPLEMENT_LOG4CXX_OBJECT(AsyncAppender)
 
@@ -53,7 +69,12 @@ AsyncAppender::AsyncAppender()
 	  appenders(new AppenderAttachableImpl(pool)),
 	  dispatcher(),
 	  locationInfo(false),
-	  blocking(true)
+	  blocking(true),
+	  ringBuffer(false),
+	  ring(0),
+	  dispatcherWaiting(0),
+	  producersWaiting(0),
+	  discardPending(false)
 {
 #if APR_HAS_THREADS
 	dispatcher.run(dispatch, this);
@@ -63,6 +84,7 @@ AsyncAppender::AsyncAppender()
 AsyncAppender::~AsyncAppender()
 {
 	finalize();
+	delete ring;
 	delete discardMap;
 }
 
@@ -96,6 +118,11 @@ void AsyncAppender::setOption(const LogString& option,
 		setBufferSize(OptionConverter::toInt(value, DEFAULT_BUFFER_SIZE));
 	}
 
+	if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("RINGBUFFER"), LOG4CXX_STR("ringbuffer")))
+	{
+		setRingBuffer(OptionConverter::toBoolean(value, false));
+	}
+
 	if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("BLOCKING"), LOG4CXX_STR("blocking")))
 	{
 		setBlocking(OptionConverter::toBoolean(value, true));
@@ -107,6 +134,22 @@ void AsyncAppender::setOption(const LogString& option,
 }
 
 
+void AsyncAppender::activateOptions(Pool& p)
+{
+	AppenderSkeleton::activateOptions(p);
+#if APR_HAS_THREADS
+	synchronized sync(bufferMutex);
+
+	if (ringBuffer && ring == 0 && bufferSize > 0)
+	{
+		ring = new EventRingBuffer(bufferSize);
+		bufferNotEmpty.signalAll();
+	}
+
+#endif
+}
+
+
 void AsyncAppender::doAppend(const spi::LoggingEventPtr& event, Pool& pool1)
 {
 	LOCK_R sync(mutex);
@@ -138,10 +181,15 @@ void AsyncAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 	event->getMDCCopy();
 
 
+	if (ring == 0)
 	{
 		synchronized sync(bufferMutex);
 
-		while (true)
+		//
+		//   recheck while holding the lock, activateOptions
+		//      may have just created the ring
+		//
+		while (ring == 0)
 		{
 			int previousSize = buffer.size();
 
@@ -154,7 +202,7 @@ void AsyncAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 					bufferNotEmpty.signalAll();
 				}
 
-				break;
+				return;
 			}
 
 			//
@@ -164,7 +212,7 @@ void AsyncAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 			//   if blocking and thread is not already interrupted
 			//      and not the dispatcher then
 			//      wait for a buffer notification
-			bool discard = true;
+			bool discardEvent = true;
 
 			if (blocking
 				&& !Thread::interrupted()
@@ -173,7 +221,7 @@ void AsyncAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 				try
 				{
 					bufferNotFull.await(bufferMutex);
-					discard = false;
+					discardEvent = false;
 				}
 				catch (InterruptedException& e)
 				{
@@ -189,25 +237,15 @@ void AsyncAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 			//   if blocking is false or thread has been interrupted
 			//   add event to discard map.
 			//
-			if (discard)
+			if (discardEvent)
 			{
-				LogString loggerName = event->getLoggerName();
-				DiscardMap::iterator iter = discardMap->find(loggerName);
-
-				if (iter == discardMap->end())
-				{
-					DiscardSummary summary(event);
-					discardMap->insert(DiscardMap::value_type(loggerName, summary));
-				}
-				else
-				{
-					(*iter).second.add(event);
-				}
-
-				break;
+				discard(event);
+				return;
 			}
 		}
 	}
+
+	appendToRing(event);
 #else
 	synchronized sync(appenders->getMutex());
 	appenders->appendLoopOnAppenders(event, p);
@@ -215,6 +253,84 @@ void AsyncAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 }
 
 
+#if APR_HAS_THREADS
+void AsyncAppender::appendToRing(const LoggingEventPtr& event)
+{
+	EventRingBuffer* currentRing = ring;
+	bool added = currentRing->offer(event);
+
+	if (!added && blocking && !dispatcher.isCurrentThread())
+	{
+		//
+		//   give the dispatcher a chance to catch up
+		//      before resorting to the lock
+		for (int i = 0; i < APPEND_YIELD_COUNT && !added; i++)
+		{
+			apr_thread_yield();
+			added = currentRing->offer(event);
+		}
+	}
+
+	if (!added)
+	{
+		synchronized sync(bufferMutex);
+		apr_atomic_inc32(&producersWaiting);
+		added = currentRing->offer(event);
+
+		while (!added
+			&& blocking
+			&& !closed
+			&& !Thread::interrupted()
+			&& !dispatcher.isCurrentThread())
+		{
+			try
+			{
+				bufferNotFull.await(bufferMutex);
+				added = currentRing->offer(event);
+			}
+			catch (InterruptedException& e)
+			{
+				Thread::currentThreadInterrupt();
+				break;
+			}
+		}
+
+		apr_atomic_dec32(&producersWaiting);
+
+		if (!added)
+		{
+			discard(event);
+			return;
+		}
+	}
+
+	if (apr_atomic_read32(&dispatcherWaiting) != 0)
+	{
+		synchronized sync(bufferMutex);
+		bufferNotEmpty.signalAll();
+	}
+}
+
+void AsyncAppender::discard(const LoggingEventPtr& event)
+{
+	LogString loggerName = event->getLoggerName();
+	DiscardMap::iterator iter = discardMap->find(loggerName);
+
+	if (iter == discardMap->end())
+	{
+		DiscardSummary summary(event);
+		discardMap->insert(DiscardMap::value_type(loggerName, summary));
+	}
+	else
+	{
+		(*iter).second.add(event);
+	}
+
+	discardPending = true;
+}
+#endif
+
+
 void AsyncAppender::close()
 {
 	{
@@ -332,6 +448,16 @@ bool AsyncAppender::getBlocking() const
 	return blocking;
 }
 
+void AsyncAppender::setRingBuffer(bool value)
+{
+	ringBuffer = value;
+}
+
+bool AsyncAppender::getRingBuffer() const
+{
+	return ringBuffer;
+}
+
 AsyncAppender::DiscardSummary::DiscardSummary(const LoggingEventPtr& event) :
 	maxEvent(event), count(1)
 {
@@ -369,7 +495,8 @@ LoggingEventPtr AsyncAppender::DiscardSummary::createEvent(Pool& p)
 			maxEvent->getLoggerName(),
 			maxEvent->getLevel(),
 			msg,
-			LocationInfo::getLocationUnavailable());
+			LocationInfo::getLocationUnavailable(),
+			maxEvent->getInternedLoggerName());
 }
 
 ::log4cxx::spi::LoggingEventPtr
@@ -391,6 +518,7 @@ AsyncAppender::DiscardSummary::createEvent(::log4cxx::helpers::Pool& p,
 void* LOG4CXX_THREAD_FUNC AsyncAppender::dispatch(apr_thread_t* /*thread*/, void* data)
 {
 	AsyncAppender* pThis = (AsyncAppender*) data;
+	EventRingBuffer* ring = 0;
 	bool isActive = true;
 
 	try
@@ -400,18 +528,20 @@ void* LOG4CXX_THREAD_FUNC AsyncAppender::dispatch(apr_thread_t* /*thread*/, void
 			//
 			//   process events after lock on buffer is released.
 			//
-			Pool p;
+			ScratchPool p;
 			LoggingEventList events;
 			{
 				synchronized sync(pThis->bufferMutex);
 				size_t bufferSize = pThis->buffer.size();
 				isActive = !pThis->closed;
+				ring = pThis->ring;
 
-				while ((bufferSize == 0) && isActive)
+				while ((bufferSize == 0) && isActive && (ring == 0))
 				{
 					pThis->bufferNotEmpty.await(pThis->bufferMutex);
 					bufferSize = pThis->buffer.size();
 					isActive = !pThis->closed;
+					ring = pThis->ring;
 				}
 
 				for (LoggingEventList::iterator eventIter = pThis->buffer.begin();
@@ -433,12 +563,18 @@ void* LOG4CXX_THREAD_FUNC AsyncAppender::dispatch(apr_thread_t* /*thread*/, void
 				pThis->bufferNotFull.signalAll();
 			}
 
-			for (LoggingEventList::iterator iter = events.begin();
-				iter != events.end();
-				iter++)
 			{
 				synchronized sync(pThis->appenders->getMutex());
-				pThis->appenders->appendLoopOnAppenders(*iter, p);
+				pThis->appenders->appendLoopOnAppenders(events, p);
+			}
+
+			//
+			//   once the ring buffer exists no more events
+			//      are added to the buffer
+			if (ring != 0)
+			{
+				dispatchRing(pThis);
+				break;
 			}
 		}
 	}
@@ -452,4 +588,84 @@ void* LOG4CXX_THREAD_FUNC AsyncAppender::dispatch(apr_thread_t* /*thread*/, void
 
 	return 0;
 }
+
+void AsyncAppender::dispatchRing(AsyncAppender* pThis)
+{
+	EventRingBuffer* ring = pThis->ring;
+	size_t capacity = ring->getCapacity();
+	int idle = 0;
+	bool isActive = true;
+
+	while (isActive)
+	{
+		ScratchPool p;
+		LoggingEventList events;
+		//
+		//   read closed before draining so that events
+		//      added before close are still dispatched
+		isActive = !pThis->closed;
+		ring->drain(events, capacity);
+
+		if (!events.empty() && apr_atomic_read32(&pThis->producersWaiting) != 0)
+		{
+			synchronized sync(pThis->bufferMutex);
+			pThis->bufferNotFull.signalAll();
+		}
+
+		if (pThis->discardPending)
+		{
+			synchronized sync(pThis->bufferMutex);
+
+			for (DiscardMap::iterator discardIter = pThis->discardMap->begin();
+				discardIter != pThis->discardMap->end();
+				discardIter++)
+			{
+				events.push_back(discardIter->second.createEvent(p));
+			}
+
+			pThis->discardMap->clear();
+			pThis->discardPending = false;
+		}
+
+		if (events.empty())
+		{
+			if (!isActive)
+			{
+				break;
+			}
+
+			//
+			//   poll, then yield, then wait to be signalled
+			//
+			if (idle < DISPATCH_SPIN_COUNT)
+			{
+				idle++;
+			}
+			else if (idle < DISPATCH_SPIN_COUNT + DISPATCH_YIELD_COUNT)
+			{
+				idle++;
+				apr_thread_yield();
+			}
+			else
+			{
+				synchronized sync(pThis->bufferMutex);
+				apr_atomic_xchg32(&pThis->dispatcherWaiting, 1);
+
+				if (ring->isEmpty() && !pThis->closed && !pThis->discardPending)
+				{
+					pThis->bufferNotEmpty.await(pThis->bufferMutex);
+				}
+
+				apr_atomic_xchg32(&pThis->dispatcherWaiting, 0);
+				idle = 0;
+			}
+
+			continue;
+		}
+
+		idle = 0;
+		synchronized sync(pThis->appenders->getMutex());
+		pThis->appenders->appendLoopOnAppenders(events, p);
+	}
+}
 #endif
@@ -32,6 +32,7 @@
 #include <log4cxx/helpers/stringhelper.h>
 #include <apr_atomic.h>
 #include <log4cxx/helpers/optionconverter.h>
+#include <log4cxx/helpers/threadspecificdata.h>
 
 
 using namespace log4cxx;
@@ -53,7 +54,8 @@ AsyncAppender::AsyncAppender()
 	  appenders(new AppenderAttachableImpl(pool)),
 	  dispatcher(),
 	  locationInfo(false),
-	  blocking(true)
+	  blocking(true),
+	  ringBuffer(false)
 {
 #if APR_HAS_THREADS
 	dispatcher.run(dispatch, this);
@@ -96,6 +98,11 @@ void AsyncAppender::setOption(const LogString& option,
 		setBufferSize(OptionConverter::toInt(value, DEFAULT_BUFFER_SIZE));
 	}
 
+	if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("RINGBUFFER"), LOG4CXX_STR("ringbuffer")))
+	{
+		setRingBuffer(OptionConverter::toBoolean(value, false));
+	}
+
 	if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("BLOCKING"), LOG4CXX_STR("blocking")))
 	{
 		setBlocking(OptionConverter::toBoolean(value, true));
@@ -107,6 +114,15 @@ void AsyncAppender::setOption(const LogString& option,
 }
 
 
+void AsyncAppender::activateOptions(Pool& p)
+{
+	//
+	//   the buffer is already a lock-free queue,
+	//      so the RingBuffer option has no effect
+	AppenderSkeleton::activateOptions(p);
+}
+
+
 void AsyncAppender::doAppend(const spi::LoggingEventPtr& event, Pool& pool1)
 {
 	LOCK_R sync(mutex);
@@ -326,6 +342,16 @@ bool AsyncAppender::getBlocking() const
 	return blocking;
 }
 
+void AsyncAppender::setRingBuffer(bool value)
+{
+	ringBuffer = value;
+}
+
+bool AsyncAppender::getRingBuffer() const
+{
+	return ringBuffer;
+}
+
 AsyncAppender::DiscardSummary::DiscardSummary(const LoggingEventPtr& event) :
 	maxEvent(event), count(1)
 {
@@ -363,7 +389,8 @@ LoggingEventPtr AsyncAppender::DiscardSummary::createEvent(Pool& p)
 			maxEvent->getLoggerName(),
 			maxEvent->getLevel(),
 			msg,
-			LocationInfo::getLocationUnavailable());
+			LocationInfo::getLocationUnavailable(),
+			maxEvent->getInternedLoggerName());
 }
 
 ::log4cxx::spi::LoggingEventPtr
@@ -396,7 +423,7 @@ void* LOG4CXX_THREAD_FUNC AsyncAppender::dispatch(apr_thread_t* /*thread*/, void
 			//
 			//   process events after lock on buffer is released.
 			//
-			Pool p;
+			ScratchPool p;
 			LoggingEventList events;
 			{
 				LOCK_R sync(pThis->bufferMutex);
@@ -425,12 +452,9 @@ void* LOG4CXX_THREAD_FUNC AsyncAppender::dispatch(apr_thread_t* /*thread*/, void
 				}
 			}
 
-			for (LoggingEventList::iterator iter = events.begin();
-				iter != events.end();
-				iter++)
 			{
 				synchronized sync(pThis->appenders->getMutex());
-				pThis->appenders->appendLoopOnAppenders(*iter, p);
+				pThis->appenders->appendLoopOnAppenders(events, p);
 			}
 		}
 	}
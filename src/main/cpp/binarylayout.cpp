@@ -0,0 +1,282 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/binarylayout.h>
+#include <log4cxx/spi/loggingevent.h>
+#include <log4cxx/helpers/optionconverter.h>
+#include <log4cxx/level.h>
+#include <log4cxx/helpers/stringhelper.h>
+#include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/helpers/loglog.h>
+#include <apr_atomic.h>
+#include <vector>
+
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::spi;
+
+IMPLEMENT_LOG4CXX_OBJECT(BinaryLayout)
+
+BinaryLayout::BinaryLayout()
+	: locationInfo(false), properties(false),
+	  dictionary(), locationDictionary(), previousTime(0)
+{
+}
+
+void BinaryLayout::setOption(const LogString& option,
+	const LogString& value)
+{
+	if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("LOCATIONINFO"), LOG4CXX_STR("locationinfo")))
+	{
+		setLocationInfo(OptionConverter::toBoolean(value, false));
+	}
+
+	if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("PROPERTIES"), LOG4CXX_STR("properties")))
+	{
+		setProperties(OptionConverter::toBoolean(value, false));
+	}
+}
+
+void BinaryLayout::format(LogString& /* output */,
+	const spi::LoggingEventPtr& /* event */,
+	Pool& /* p */) const
+{
+	//  format may be called by several appenders at once,
+	//  only the first caller warns.
+	static volatile apr_uint32_t warned = 0;
+
+	if (apr_atomic_xchg32(&warned, 1) == 0)
+	{
+		LogLog::warn(LOG4CXX_STR("BinaryLayout produces no text, use it with an appender writing to an unbuffered output stream."));
+	}
+}
+
+void BinaryLayout::formatBytes(std::string& output,
+	const spi::LoggingEventPtr& event,
+	const CharsetEncoderPtr& /* encoder */,
+	Pool& p) const
+{
+	formatRecord(output, event, p);
+}
+
+void BinaryLayout::appendVarint(std::string& output, log4cxx_int64_t value)
+{
+	//
+	//   shift in the unsigned sense, clearing the sign bit
+	//
+	const log4cxx_int64_t mask = (((log4cxx_int64_t) 1) << 57) - 1;
+
+	while (value < 0 || value >= 0x80)
+	{
+		output.append(1, (char) ((value & 0x7F) | 0x80));
+		value = (value >> 7) & mask;
+	}
+
+	output.append(1, (char) value);
+}
+
+void BinaryLayout::appendSigned(std::string& output, log4cxx_int64_t value)
+{
+	appendVarint(output, value < 0 ? ((~value) << 1) | 1 : value << 1);
+}
+
+void BinaryLayout::appendString(std::string& output, const LogString& value)
+{
+#if LOG4CXX_LOGCHAR_IS_UTF8
+	appendVarint(output, value.length());
+	output.append(value);
+#else
+	std::string bytes;
+	Transcoder::encodeUTF8(value, bytes);
+	appendVarint(output, bytes.length());
+	output.append(bytes);
+#endif
+}
+
+unsigned int BinaryLayout::define(std::string& output, const LogString& value) const
+{
+	output.append(1, (char) DEFINITION);
+	appendString(output, value);
+	return (unsigned int) (dictionary.size() + locationDictionary.size());
+}
+
+unsigned int BinaryLayout::lookup(std::string& output, const LogString& value) const
+{
+	std::map<LogString, unsigned int>::const_iterator iter = dictionary.find(value);
+
+	if (iter != dictionary.end())
+	{
+		return iter->second;
+	}
+
+	unsigned int id = define(output, value);
+	dictionary.insert(std::map<LogString, unsigned int>::value_type(value, id));
+	return id;
+}
+
+unsigned int BinaryLayout::lookup(std::string& output, const char* value) const
+{
+	std::string key(value);
+	std::map<std::string, unsigned int>::const_iterator iter = locationDictionary.find(key);
+
+	if (iter != locationDictionary.end())
+	{
+		return iter->second;
+	}
+
+	LOG4CXX_DECODE_CHAR(decoded, key);
+	unsigned int id = define(output, decoded);
+	locationDictionary.insert(std::map<std::string, unsigned int>::value_type(key, id));
+	return id;
+}
+
+void BinaryLayout::formatHeader(std::string& output) const
+{
+	dictionary.clear();
+	locationDictionary.clear();
+	previousTime = 0;
+	output.append(1, (char) HEADER);
+	output.append("4CB");
+	output.append(1, (char) VERSION);
+}
+
+void BinaryLayout::formatRecord(std::string& output,
+	const spi::LoggingEventPtr& event,
+	Pool& /* p */) const
+{
+	if (dictionary.size() + locationDictionary.size() >= MAX_DICTIONARY_SIZE)
+	{
+		formatHeader(output);
+	}
+
+	//
+	//   look up every name first so that any definitions
+	//     precede the event record
+	//
+	const LevelPtr& level = event->getLevel();
+	unsigned int levelId = lookup(output, level->toString());
+	unsigned int loggerId = lookup(output, event->getLoggerName());
+	unsigned int threadId = lookup(output, event->getThreadName());
+	unsigned int fileId = 0;
+	unsigned int functionId = 0;
+	int flags = 0;
+
+	if (locationInfo)
+	{
+		const LocationInfo& locInfo = event->getLocationInformation();
+		fileId = lookup(output, locInfo.getFileName());
+		functionId = lookup(output, locInfo.getFunctionName());
+		flags |= HAS_LOCATION;
+	}
+
+	LoggingEvent::KeySet mdcKeys;
+	LoggingEvent::KeySet propertyKeys;
+	std::vector<unsigned int> keyIds;
+
+	if (properties)
+	{
+		mdcKeys = event->getMDCKeySet();
+		propertyKeys = event->getPropertyKeySet();
+
+		for (LoggingEvent::KeySet::const_iterator i = mdcKeys.begin();
+			i != mdcKeys.end();
+			i++)
+		{
+			keyIds.push_back(lookup(output, *i));
+		}
+
+		for (LoggingEvent::KeySet::const_iterator i = propertyKeys.begin();
+			i != propertyKeys.end();
+			i++)
+		{
+			keyIds.push_back(lookup(output, *i));
+		}
+
+		if (!mdcKeys.empty())
+		{
+			flags |= HAS_MDC;
+		}
+
+		if (!propertyKeys.empty())
+		{
+			flags |= HAS_PROPERTIES;
+		}
+	}
+
+	LogString ndc;
+
+	if (event->getNDC(ndc))
+	{
+		flags |= HAS_NDC;
+	}
+
+	output.append(1, (char) EVENT);
+	output.append(1, (char) flags);
+	appendSigned(output, event->getTimeStamp() - previousTime);
+	previousTime = event->getTimeStamp();
+	appendVarint(output, levelId);
+	appendSigned(output, level->toInt());
+	appendVarint(output, loggerId);
+	appendVarint(output, threadId);
+	appendString(output, event->getRenderedMessage());
+
+	if (flags & HAS_NDC)
+	{
+		appendString(output, ndc);
+	}
+
+	if (flags & HAS_LOCATION)
+	{
+		appendVarint(output, fileId);
+		appendVarint(output, functionId);
+		appendSigned(output, event->getLocationInformation().getLineNumber());
+	}
+
+	std::vector<unsigned int>::const_iterator keyId = keyIds.begin();
+
+	if (flags & HAS_MDC)
+	{
+		appendVarint(output, mdcKeys.size());
+
+		for (LoggingEvent::KeySet::const_iterator i = mdcKeys.begin();
+			i != mdcKeys.end();
+			i++, keyId++)
+		{
+			LogString value;
+			event->getMDC(*i, value);
+			appendVarint(output, *keyId);
+			appendString(output, value);
+		}
+	}
+
+	if (flags & HAS_PROPERTIES)
+	{
+		appendVarint(output, propertyKeys.size());
+
+		for (LoggingEvent::KeySet::const_iterator i = propertyKeys.begin();
+			i != propertyKeys.end();
+			i++, keyId++)
+		{
+			LogString value;
+			event->getProperty(*i, value);
+			appendVarint(output, *keyId);
+			appendString(output, value);
+		}
+	}
+}
@@ -0,0 +1,278 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/helpers/binarylogreader.h>
+#include <log4cxx/binarylayout.h>
+#include <log4cxx/level.h>
+#include <log4cxx/helpers/bytebuffer.h>
+#include <log4cxx/helpers/exception.h>
+#include <log4cxx/helpers/internedstrings.h>
+#include <log4cxx/helpers/transcoder.h>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::spi;
+
+IMPLEMENT_LOG4CXX_OBJECT(BinaryLogReader)
+
+BinaryLogReader::BinaryLogReader(const InputStreamPtr& in1)
+	: in(in1), buffer(8192), position(0), limit(0),
+	  dictionary(), locations(), threadNames(),
+	  previousTime(0)
+{
+}
+
+BinaryLogReader::~BinaryLogReader()
+{
+}
+
+int BinaryLogReader::readByte()
+{
+	if (position == limit)
+	{
+		ByteBuffer buf(&buffer[0], buffer.size());
+		int count = in->read(buf);
+
+		if (count <= 0)
+		{
+			return -1;
+		}
+
+		position = 0;
+		limit = count;
+	}
+
+	return (unsigned char) buffer[position++];
+}
+
+int BinaryLogReader::requireByte()
+{
+	int c = readByte();
+
+	if (c < 0)
+	{
+		throw IOException(LOG4CXX_STR("Truncated binary log record"));
+	}
+
+	return c;
+}
+
+log4cxx_int64_t BinaryLogReader::readVarint()
+{
+	log4cxx_int64_t value = 0;
+
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		int c = requireByte();
+		value |= ((log4cxx_int64_t) (c & 0x7F)) << shift;
+
+		if ((c & 0x80) == 0)
+		{
+			return value;
+		}
+	}
+
+	throw IOException(LOG4CXX_STR("Invalid varint in binary log"));
+}
+
+log4cxx_int64_t BinaryLogReader::readSigned()
+{
+	log4cxx_int64_t value = readVarint();
+	const log4cxx_int64_t bit62 = ((log4cxx_int64_t) 1) << 62;
+	log4cxx_int64_t half = (value >> 1) & (bit62 - 1 + bit62);
+	return (value & 1) ? ~half : half;
+}
+
+void BinaryLogReader::readString(LogString& value)
+{
+	log4cxx_int64_t length = readVarint();
+
+	if (length < 0)
+	{
+		throw IOException(LOG4CXX_STR("Invalid string length in binary log"));
+	}
+
+	std::string bytes;
+
+	while (length > 0)
+	{
+		if (position == limit)
+		{
+			bytes.append(1, (char) requireByte());
+			length--;
+		}
+
+		size_t count = limit - position;
+
+		if ((log4cxx_int64_t) count > length)
+		{
+			count = (size_t) length;
+		}
+
+		bytes.append(&buffer[position], count);
+		position += count;
+		length -= count;
+	}
+
+	Transcoder::decodeUTF8(bytes, value);
+}
+
+const LogString& BinaryLogReader::lookup(log4cxx_int64_t id) const
+{
+	if (id < 0 || id >= (log4cxx_int64_t) dictionary.size())
+	{
+		throw IOException(LOG4CXX_STR("Undefined name in binary log"));
+	}
+
+	return dictionary[(size_t) id];
+}
+
+const char* BinaryLogReader::lookupLocation(log4cxx_int64_t id)
+{
+	const LogString& name = lookup(id);
+
+	if (locations[(size_t) id] == 0)
+	{
+		LOG4CXX_ENCODE_CHAR(encoded, name);
+		locations[(size_t) id] = InternedStrings::intern(encoded.data(), encoded.length());
+	}
+
+	return locations[(size_t) id];
+}
+
+LevelPtr BinaryLogReader::toLevel(const LogString& name, int value) const
+{
+	LevelPtr level(Level::toLevelLS(name, LevelPtr()));
+
+	if (level == NULL || level->toInt() != value)
+	{
+		level = new Level(value, name, 7);
+	}
+
+	return level;
+}
+
+void BinaryLogReader::readMap(MDC::Map& map)
+{
+	for (log4cxx_int64_t count = readVarint(); count > 0; count--)
+	{
+		const LogString& key = lookup(readVarint());
+		readString(map[key]);
+	}
+}
+
+LoggingEventPtr BinaryLogReader::read()
+{
+	for (int type = readByte(); type >= 0; type = readByte())
+	{
+		switch (type)
+		{
+			case BinaryLayout::HEADER:
+				if (requireByte() != 0x34 /* 4 */ || requireByte() != 0x43 /* C */
+					|| requireByte() != 0x42 /* B */)
+				{
+					throw IOException(LOG4CXX_STR("Not a binary log"));
+				}
+
+				if (requireByte() > BinaryLayout::VERSION)
+				{
+					throw IOException(LOG4CXX_STR("Unsupported binary log version"));
+				}
+
+				dictionary.clear();
+				locations.clear();
+				previousTime = 0;
+				break;
+
+			case BinaryLayout::DEFINITION:
+				dictionary.push_back(LogString());
+				locations.push_back(0);
+				readString(dictionary.back());
+				break;
+
+			case BinaryLayout::EVENT:
+			{
+				int flags = requireByte();
+				log4cxx_time_t timeStamp = previousTime + readSigned();
+				previousTime = timeStamp;
+				const LogString& levelName = lookup(readVarint());
+				LevelPtr level(toLevel(levelName, (int) readSigned()));
+				const LogString& logger = lookup(readVarint());
+				const LogString& threadName = lookup(readVarint());
+				LogString message;
+				readString(message);
+
+				LogString ndc;
+
+				if (flags & BinaryLayout::HAS_NDC)
+				{
+					readString(ndc);
+				}
+
+				LocationInfo location;
+
+				if (flags & BinaryLayout::HAS_LOCATION)
+				{
+					const char* fileName = lookupLocation(readVarint());
+					const char* functionName = lookupLocation(readVarint());
+					int line = (int) readSigned();
+					location = LocationInfo(fileName, functionName, line);
+				}
+
+				MDC::Map mdc;
+
+				if (flags & BinaryLayout::HAS_MDC)
+				{
+					readMap(mdc);
+				}
+
+				MDC::Map properties;
+
+				if (flags & BinaryLayout::HAS_PROPERTIES)
+				{
+					readMap(properties);
+				}
+
+				ThreadNamePtr& thread = threadNames[threadName];
+
+				if (thread == NULL)
+				{
+					thread = new ThreadName(threadName);
+				}
+
+				LoggingEventPtr event(new LoggingEvent(timeStamp, logger, level,
+						message, thread, (flags & BinaryLayout::HAS_NDC) ? &ndc : 0,
+						mdc, location));
+
+				for (MDC::Map::const_iterator i = properties.begin();
+					i != properties.end();
+					i++)
+				{
+					event->setProperty(i->first, i->second);
+				}
+
+				return event;
+			}
+
+			default:
+				throw IOException(LOG4CXX_STR("Unknown record in binary log"));
+		}
+	}
+
+	return LoggingEventPtr();
+}
@@ -20,6 +20,9 @@
 
 
 #include <apr_time.h>
+#include <apr_atomic.h>
+#include <apr_portable.h>
+#include <apr_thread_proc.h>
 #include <log4cxx/helpers/pool.h>
 #include <limits>
 #include <log4cxx/helpers/exception.h>
@@ -58,6 +61,72 @@ const logchar CachedDateFormat::zeroString[] = { 0x30, 0x30, 0x30, 0 };
 
 #undef min
 
+/**
+ *  A previous conversion.  A slot is only read or written
+ *  by the thread that holds its lock.
+ */
+struct CachedDateFormat::Slot
+{
+	Slot() :
+		lock(0),
+		millisecondStart(0),
+		slotBegin(std::numeric_limits<log4cxx_time_t>::min()),
+		cache(50, 0x20),
+		previousTime(std::numeric_limits<log4cxx_time_t>::min())
+	{
+	}
+
+	/**
+	 *  1 while a thread is using the slot, otherwise 0.
+	 */
+	volatile apr_uint32_t lock;
+
+	/**
+	 *  Index of initial digit of millisecond pattern or
+	 *   UNRECOGNIZED_MILLISECONDS or NO_MILLISECONDS.
+	 */
+	int millisecondStart;
+
+	/**
+	 *  Integral second preceding the previous convered Date.
+	 */
+	log4cxx_time_t slotBegin;
+
+	/**
+	 *  Cache of previous conversion.
+	 */
+	LogString cache;
+
+	/**
+	 *  Date requested in previous conversion.
+	 */
+	log4cxx_time_t previousTime;
+};
+
+namespace
+{
+/**
+ *  Releases a slot lock when it goes out of scope.
+ */
+class SlotLock
+{
+	public:
+		SlotLock(volatile apr_uint32_t& lock1) : lock(lock1)
+		{
+		}
+
+		~SlotLock()
+		{
+			apr_atomic_xchg32(&lock, 0);
+		}
+
+	private:
+		volatile apr_uint32_t& lock;
+		SlotLock(const SlotLock&);
+		SlotLock& operator=(const SlotLock&);
+};
+}
+
 /**
  *  Creates a new CachedDateFormat object.
  *  @param dateFormat Date format, may not be null.
@@ -69,23 +138,27 @@ const logchar CachedDateFormat::zeroString[] = { 0x30, 0x30, 0x30, 0 };
 CachedDateFormat::CachedDateFormat(const DateFormatPtr& dateFormat,
 	int expiration1) :
 	formatter(dateFormat),
-	millisecondStart(0),
-	slotBegin(std::numeric_limits<log4cxx_time_t>::min()),
-	cache(50, 0x20),
 	expiration(expiration1),
-	previousTime(std::numeric_limits<log4cxx_time_t>::min())
+	slots(new Slot[SLOT_COUNT])
 {
 	if (dateFormat == NULL)
 	{
+		delete [] slots;
 		throw IllegalArgumentException(LOG4CXX_STR("dateFormat cannot be null"));
 	}
 
 	if (expiration1 < 0)
 	{
+		delete [] slots;
 		throw IllegalArgumentException(LOG4CXX_STR("expiration must be non-negative"));
 	}
 }
 
+CachedDateFormat::~CachedDateFormat()
+{
+	delete [] slots;
+}
+
 
 /**
  * Finds start of millisecond field in formatted time.
@@ -187,15 +260,40 @@ int CachedDateFormat::findMillisecondStart(
  *  @param sbuf the string buffer to write to
  */
 void CachedDateFormat::format(LogString& buf, log4cxx_time_t now, Pool& p) const
+{
+	unsigned int first = getSlotIndex();
+
+	for (unsigned int i = 0; i < SLOT_COUNT; i++)
+	{
+		Slot& slot = slots[(first + i) & (SLOT_COUNT - 1)];
+
+		if (apr_atomic_cas32(&slot.lock, 1, 0) == 0)
+		{
+			SlotLock sync(slot.lock);
+			format(slot, buf, now, p);
+			return;
+		}
+	}
+
+	//
+	//   every slot is in use, format without the cache.
+	//
+	formatter->format(buf, now, p);
+}
+
+/**
+ * Formats a date using a cache slot held by the calling thread.
+ */
+void CachedDateFormat::format(Slot& slot, LogString& buf, log4cxx_time_t now, Pool& p) const
 {
 
 	//
 	// If the current requested time is identical to the previously
 	//     requested time, then append the cache contents.
 	//
-	if (now == previousTime)
+	if (now == slot.previousTime)
 	{
-		buf.append(cache);
+		buf.append(slot.cache);
 		return;
 	}
 
@@ -203,28 +301,28 @@ void CachedDateFormat::format(LogString& buf, log4cxx_time_t now, Pool& p) const
 	//   If millisecond pattern was not unrecognized
 	//     (that is if it was found or milliseconds did not appear)
 	//
-	if (millisecondStart != UNRECOGNIZED_MILLISECONDS)
+	if (slot.millisecondStart != UNRECOGNIZED_MILLISECONDS)
 	{
 		//    Check if the cache is still valid.
 		//    If the requested time is within the same integral second
 		//       as the last request and a shorter expiration was not requested.
-		if (now < slotBegin + expiration
-			&& now >= slotBegin
-			&& now < slotBegin + 1000000L)
+		if (now < slot.slotBegin + expiration
+			&& now >= slot.slotBegin
+			&& now < slot.slotBegin + 1000000L)
 		{
 			//
 			//    if there was a millisecond field then update it
 			//
-			if (millisecondStart >= 0)
+			if (slot.millisecondStart >= 0)
 			{
-				millisecondFormat((int) ((now - slotBegin) / 1000), cache, millisecondStart);
+				millisecondFormat((int) ((now - slot.slotBegin) / 1000), slot.cache, slot.millisecondStart);
 			}
 
 			//
 			//   update the previously requested time
 			//      (the slot begin should be unchanged)
-			previousTime = now;
-			buf.append(cache);
+			slot.previousTime = now;
+			buf.append(slot.cache);
 
 			return;
 		}
@@ -233,24 +331,24 @@ void CachedDateFormat::format(LogString& buf, log4cxx_time_t now, Pool& p) const
 	//
 	//  could not use previous value.
 	//    Call underlying formatter to format date.
-	cache.erase(cache.begin(), cache.end());
-	formatter->format(cache, now, p);
-	buf.append(cache);
-	previousTime = now;
-	slotBegin = (previousTime / 1000000) * 1000000;
+	slot.cache.erase(slot.cache.begin(), slot.cache.end());
+	formatter->format(slot.cache, now, p);
+	buf.append(slot.cache);
+	slot.previousTime = now;
+	slot.slotBegin = (slot.previousTime / 1000000) * 1000000;
 
-	if (slotBegin > previousTime)
+	if (slot.slotBegin > slot.previousTime)
 	{
-		slotBegin -= 1000000;
+		slot.slotBegin -= 1000000;
 	}
 
 	//
 	//    if the milliseconds field was previous found
 	//       then reevaluate in case it moved.
 	//
-	if (millisecondStart >= 0)
+	if (slot.millisecondStart >= 0)
 	{
-		millisecondStart = findMillisecondStart(now, cache, formatter, p);
+		slot.millisecondStart = findMillisecondStart(now, slot.cache, formatter, p);
 	}
 }
 
@@ -280,8 +378,42 @@ void CachedDateFormat::millisecondFormat(int millis,
 void CachedDateFormat::setTimeZone(const TimeZonePtr& timeZone)
 {
 	formatter->setTimeZone(timeZone);
-	previousTime = std::numeric_limits<log4cxx_time_t>::min();
-	slotBegin = std::numeric_limits<log4cxx_time_t>::min();
+
+	for (int i = 0; i < SLOT_COUNT; i++)
+	{
+		Slot& slot = slots[i];
+
+		while (apr_atomic_cas32(&slot.lock, 1, 0) != 0)
+		{
+			apr_thread_yield();
+		}
+
+		SlotLock sync(slot.lock);
+		slot.previousTime = std::numeric_limits<log4cxx_time_t>::min();
+		slot.slotBegin = std::numeric_limits<log4cxx_time_t>::min();
+	}
+}
+
+/**
+ * Gets the slot at which the calling thread starts looking,
+ * a hash of the thread id.
+ */
+unsigned int CachedDateFormat::getSlotIndex()
+{
+#if APR_HAS_THREADS
+	apr_os_thread_t self = apr_os_thread_current();
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&self);
+	unsigned int hash = 2166136261U;
+
+	for (size_t i = 0; i < sizeof(self); i++)
+	{
+		hash = (hash ^ bytes[i]) * 16777619U;
+	}
+
+	return hash;
+#else
+	return 0;
+#endif
 }
 
 
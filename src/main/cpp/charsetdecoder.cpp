@@ -283,6 +283,9 @@ class UTF8CharsetDecoder : public CharsetDecoder
 		virtual log4cxx_status_t decode(ByteBuffer& in,
 			LogString& out)
 		{
+			in.position(in.position()
+				+ Transcoder::decodeASCII(in.current(), in.remaining(), out));
+
 			if (in.remaining() > 0)
 			{
 				std::string tmp(in.current(), in.remaining());
@@ -290,6 +293,14 @@ class UTF8CharsetDecoder : public CharsetDecoder
 
 				while (iter != tmp.end())
 				{
+					size_t ascii = iter - tmp.begin();
+					iter += Transcoder::decodeASCII(tmp.data() + ascii, tmp.length() - ascii, out);
+
+					if (iter == tmp.end())
+					{
+						break;
+					}
+
 					unsigned int sv = Transcoder::decode(tmp, iter);
 
 					if (sv == 0xFFFF)
@@ -343,8 +354,13 @@ class ISOLatinCharsetDecoder : public CharsetDecoder
 
 				while (src < srcEnd)
 				{
-					unsigned int sv = *(src++);
-					Transcoder::encode(sv, out);
+					src += Transcoder::decodeASCII((const char*) src, srcEnd - src, out);
+
+					if (src < srcEnd)
+					{
+						unsigned int sv = *(src++);
+						Transcoder::encode(sv, out);
+					}
 				}
 
 				in.position(in.limit());
@@ -389,20 +405,11 @@ class USASCIICharsetDecoder : public CharsetDecoder
 				const unsigned char* src = (unsigned char*) in.current();
 				const unsigned char* srcEnd = src + in.remaining();
 
-				while (src < srcEnd)
-				{
-					unsigned char sv = *src;
+				src += Transcoder::decodeASCII((const char*) src, srcEnd - src, out);
 
-					if (sv < 0x80)
-					{
-						src++;
-						Transcoder::encode(sv, out);
-					}
-					else
-					{
-						stat = APR_BADARG;
-						break;
-					}
+				if (src < srcEnd)
+				{
+					stat = APR_BADARG;
 				}
 
 				in.position(src - (const unsigned char*) in.data());
@@ -434,19 +441,12 @@ class LocaleCharsetDecoder : public CharsetDecoder
 		virtual log4cxx_status_t decode(ByteBuffer& in,
 			LogString& out)
 		{
-			const char* p = in.current();
-			size_t i = in.position();
 #if !LOG4CXX_CHARSET_EBCDIC
-
-			for (; i < in.limit() && ((unsigned int) *p) < 0x80; i++, p++)
-			{
-				out.append(1, *p);
-			}
-
-			in.position(i);
+			in.position(in.position()
+				+ Transcoder::decodeASCII(in.current(), in.remaining(), out));
 #endif
 
-			if (i < in.limit())
+			if (in.remaining() > 0)
 			{
 				Pool subpool;
 				const char* enc = apr_os_locale_encoding(subpool.getAPRPool());
@@ -232,6 +232,13 @@ class USASCIICharsetEncoder : public CharsetEncoder
 			{
 				while (out.remaining() > 0 && iter != in.end())
 				{
+					Transcoder::encodeASCII(in, iter, out);
+
+					if (iter == in.end() || out.remaining() == 0)
+					{
+						break;
+					}
+
 					LogString::const_iterator prev(iter);
 					unsigned int sv = Transcoder::decode(in, iter);
 
@@ -276,6 +283,13 @@ class ISOLatinCharsetEncoder : public CharsetEncoder
 			{
 				while (out.remaining() > 0 && iter != in.end())
 				{
+					Transcoder::encodeASCII(in, iter, out);
+
+					if (iter == in.end() || out.remaining() == 0)
+					{
+						break;
+					}
+
 					LogString::const_iterator prev(iter);
 					unsigned int sv = Transcoder::decode(in, iter);
 
@@ -334,6 +348,16 @@ class TrivialCharsetEncoder : public CharsetEncoder
 			return APR_SUCCESS;
 		}
 
+		virtual void encodeAll(const LogString& in, std::string& out)
+		{
+			out.append((const char*) in.data(), in.length() * sizeof(logchar));
+		}
+
+		virtual bool isTrivial() const
+		{
+			return true;
+		}
+
 	private:
 		TrivialCharsetEncoder(const TrivialCharsetEncoder&);
 		TrivialCharsetEncoder& operator=(const TrivialCharsetEncoder&);
@@ -358,6 +382,13 @@ class UTF8CharsetEncoder : public CharsetEncoder
 		{
 			while (iter != in.end() && out.remaining() >= 8)
 			{
+				Transcoder::encodeASCII(in, iter, out);
+
+				if (iter == in.end() || out.remaining() < 8)
+				{
+					break;
+				}
+
 				unsigned int sv = Transcoder::decode(in, iter);
 
 				if (sv == 0xFFFF)
@@ -371,6 +402,11 @@ class UTF8CharsetEncoder : public CharsetEncoder
 			return APR_SUCCESS;
 		}
 
+		virtual void encodeAll(const LogString& in, std::string& out)
+		{
+			Transcoder::encodeUTF8(in, out);
+		}
+
 	private:
 		UTF8CharsetEncoder(const UTF8CharsetEncoder&);
 		UTF8CharsetEncoder& operator=(const UTF8CharsetEncoder&);
@@ -393,6 +429,13 @@ class UTF16BECharsetEncoder : public CharsetEncoder
 		{
 			while (iter != in.end() && out.remaining() >= 4)
 			{
+				Transcoder::encodeASCIIUTF16(in, iter, out, true);
+
+				if (iter == in.end() || out.remaining() < 4)
+				{
+					break;
+				}
+
 				unsigned int sv = Transcoder::decode(in, iter);
 
 				if (sv == 0xFFFF)
@@ -428,6 +471,13 @@ class UTF16LECharsetEncoder : public CharsetEncoder
 		{
 			while (iter != in.end() && out.remaining() >= 4)
 			{
+				Transcoder::encodeASCIIUTF16(in, iter, out, false);
+
+				if (iter == in.end() || out.remaining() < 4)
+				{
+					break;
+				}
+
 				unsigned int sv = Transcoder::decode(in, iter);
 
 				if (sv == 0xFFFF)
@@ -463,17 +513,7 @@ class LocaleCharsetEncoder : public CharsetEncoder
 			ByteBuffer& out)
 		{
 #if !LOG4CXX_CHARSET_EBCDIC
-			char* current = out.current();
-			size_t remain = out.remaining();
-
-			for (;
-				iter != in.end() && ((unsigned int) *iter) < 0x80 && remain > 0;
-				iter++, remain--, current++)
-			{
-				*current = *iter;
-			}
-
-			out.position(current - out.data());
+			Transcoder::encodeASCII(in, iter, out);
 #endif
 
 			if (iter != in.end() && out.remaining() > 0)
@@ -614,6 +654,35 @@ CharsetEncoderPtr CharsetEncoder::getEncoder(const LogString& charset)
 }
 
 
+void CharsetEncoder::encodeAll(const LogString& in, std::string& out)
+{
+	CharsetEncoderPtr self(this);
+	LogString::const_iterator iter = in.begin();
+	size_t used = out.length();
+
+	//
+	//   grow the output in place, most encodings need no more
+	//     than two bytes for each logchar
+	//
+	while (iter != in.end())
+	{
+		out.resize(used + 2 * (in.end() - iter) + 16);
+		ByteBuffer buf(&out[used], out.length() - used);
+		encode(self, in, iter, buf);
+		used += buf.position();
+	}
+
+	out.resize(used + 16);
+	ByteBuffer buf(&out[used], out.length() - used);
+	flush(buf);
+	out.resize(used + buf.position());
+}
+
+bool CharsetEncoder::isTrivial() const
+{
+	return false;
+}
+
 void CharsetEncoder::reset()
 {
 }
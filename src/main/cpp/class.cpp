@@ -53,8 +53,10 @@
 #include <log4cxx/writerappender.h>
 #include <log4cxx/net/xmlsocketappender.h>
 #include <log4cxx/layout.h>
+#include <log4cxx/binarylayout.h>
 #include <log4cxx/patternlayout.h>
 #include <log4cxx/htmllayout.h>
+#include <log4cxx/jsonlayout.h>
 #include <log4cxx/simplelayout.h>
 #include <log4cxx/xml/xmllayout.h>
 #include <log4cxx/ttcclayout.h>
@@ -184,8 +186,10 @@ void Class::registerClasses()
 	TelnetAppender::registerClass();
 #endif
 	XMLSocketAppender::registerClass();
+	BinaryLayout::registerClass();
 	DateLayout::registerClass();
 	HTMLLayout::registerClass();
+	JSONLayout::registerClass();
 	PatternLayout::registerClass();
 	SimpleLayout::registerClass();
 	TTCCLayout::registerClass();
@@ -55,7 +55,19 @@ void ClassNamePatternConverter::format(
 	LogString& toAppendTo,
 	Pool& /* p */) const
 {
+	//
+	//   the class name is derived from the function name of the call site,
+	//      cache it by the address of that function name.
+	//
+	const char* function = event->getLocationInformation().getFunctionName();
+
+	if (appendCached(function, toAppendTo))
+	{
+		return;
+	}
+
 	int initialLength = toAppendTo.length();
 	append(toAppendTo, event->getLocationInformation().getClassName());
 	abbreviate(initialLength, toAppendTo);
+	addCached(function, toAppendTo.substr(initialLength));
 }
@@ -77,3 +77,32 @@ void Condition::await(Mutex& mutex)
 #endif
 }
 
+bool Condition::await(Mutex& mutex, log4cxx_time_t timeout)
+{
+#if APR_HAS_THREADS
+
+	if (Thread::interrupted())
+	{
+		throw InterruptedException();
+	}
+
+	apr_status_t stat = apr_thread_cond_timedwait(
+			condition,
+			mutex.getAPRMutex(),
+			timeout);
+
+	if (stat == APR_TIMEUP)
+	{
+		return false;
+	}
+
+	if (stat != APR_SUCCESS)
+	{
+		throw InterruptedException(stat);
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
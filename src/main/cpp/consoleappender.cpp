@@ -30,11 +30,13 @@ IMPLEMENT_LOG4CXX_OBJECT(ConsoleAppender)
 ConsoleAppender::ConsoleAppender()
 	: target(getSystemOut())
 {
+	setBatchingType(typeid(ConsoleAppender));
 }
 
 ConsoleAppender::ConsoleAppender(const LayoutPtr& layout1)
 	: target(getSystemOut())
 {
+	setBatchingType(typeid(ConsoleAppender));
 	setLayout(layout1);
 	Pool p;
 	WriterPtr writer1(new SystemOutWriter());
@@ -45,6 +47,7 @@ ConsoleAppender::ConsoleAppender(const LayoutPtr& layout1)
 ConsoleAppender::ConsoleAppender(const LayoutPtr& layout1, const LogString& target1)
 	: target(target1)
 {
+	setBatchingType(typeid(ConsoleAppender));
 	setLayout(layout1);
 	Pool p;
 	ConsoleAppender::activateOptions(p);
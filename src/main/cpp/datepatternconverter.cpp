@@ -26,11 +26,19 @@
 #include <log4cxx/helpers/absolutetimedateformat.h>
 #include <log4cxx/helpers/datetimedateformat.h>
 #include <log4cxx/helpers/iso8601dateformat.h>
+#include <log4cxx/helpers/fixeddateformat.h>
 #include <log4cxx/helpers/strftimedateformat.h>
 #include <log4cxx/helpers/stringhelper.h>
 #include <log4cxx/helpers/exception.h>
 #include <log4cxx/helpers/loglog.h>
 #include <log4cxx/helpers/date.h>
+#include <log4cxx/helpers/mutex.h>
+#include <log4cxx/helpers/synchronized.h>
+#if !defined(LOG4CXX)
+	#define LOG4CXX 1
+#endif
+#include <log4cxx/helpers/aprinitializer.h>
+#include <map>
 
 using namespace log4cxx;
 using namespace log4cxx::pattern;
@@ -46,7 +54,56 @@ DatePatternConverter::DatePatternConverter(
 {
 }
 
+namespace
+{
+/**
+ *  Date formats by converter options.
+ */
+class SharedDateFormats
+{
+	public:
+		SharedDateFormats() : mutex(APRInitializer::getRootPool())
+		{
+		}
+
+		Mutex mutex;
+		std::map<LogString, DateFormatPtr> formats;
+};
+
+SharedDateFormats& getSharedDateFormats()
+{
+	static SharedDateFormats shared;
+	return shared;
+}
+}
+
 DateFormatPtr DatePatternConverter::getDateFormat(const OptionsList& options)
+{
+	LogString key;
+
+	for (OptionsList::const_iterator iter = options.begin();
+		iter != options.end();
+		iter++)
+	{
+		key.append(*iter);
+		key.append(1, (logchar) 0);
+	}
+
+	SharedDateFormats& shared = getSharedDateFormats();
+	synchronized sync(shared.mutex);
+	std::map<LogString, DateFormatPtr>::const_iterator found = shared.formats.find(key);
+
+	if (found != shared.formats.end())
+	{
+		return found->second;
+	}
+
+	DateFormatPtr df(createDateFormat(options));
+	shared.formats.insert(std::map<LogString, DateFormatPtr>::value_type(key, df));
+	return df;
+}
+
+DateFormatPtr DatePatternConverter::createDateFormat(const OptionsList& options)
 {
 	DateFormatPtr df;
 	int maximumCacheValidity = 1000000;
@@ -65,6 +122,15 @@ DateFormatPtr DatePatternConverter::getDateFormat(const OptionsList& options)
 		{
 			df = new ISO8601DateFormat();
 		}
+		else if (StringHelper::equalsIgnoreCase(dateFormatStr,
+				LOG4CXX_STR("ISO8601_MICROS"), LOG4CXX_STR("iso8601_micros")))
+		{
+			//
+			//   the cache only knows how to update milliseconds
+			//
+			df = new FixedDateFormat(FixedDateFormat::ISO8601_MICROS);
+			maximumCacheValidity = 0;
+		}
 		else if (StringHelper::equalsIgnoreCase(dateFormatStr,
 				LOG4CXX_STR("ABSOLUTE"), LOG4CXX_STR("absolute")))
 		{
@@ -0,0 +1,283 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/helpers/deferredmessage.h>
+#include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/helpers/stringhelper.h>
+#include <sstream>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+
+namespace
+{
+void appendInteger(unsigned long long value, bool negative,
+	unsigned int radix, LogString& dest)
+{
+	static const char digits[] = "0123456789abcdef";
+	logchar buf[24];
+	logchar* end = buf + sizeof(buf) / sizeof(buf[0]);
+	logchar* pos = end;
+
+	do
+	{
+		*(--pos) = (logchar) digits[value % radix];
+		value /= radix;
+	}
+	while (value != 0);
+
+	if (negative)
+	{
+		*(--pos) = 0x2D; // '-'
+	}
+
+	dest.append(pos, end - pos);
+}
+
+void appendLiteral(const char* begin, const char* end, LogString& dest)
+{
+	if (end > begin)
+	{
+		Transcoder::decode(std::string(begin, end), dest);
+	}
+}
+}
+
+DeferredMessage::DeferredMessage(const char* format1) :
+	format(format1),
+	buffer(inlineBuffer),
+	length(0),
+	capacity(INLINE_CAPACITY)
+{
+}
+
+DeferredMessage::DeferredMessage(const DeferredMessage& src) :
+	format(src.format),
+	buffer(inlineBuffer),
+	length(src.length),
+	capacity(INLINE_CAPACITY)
+{
+	if (length > capacity)
+	{
+		buffer = new char[length];
+		capacity = length;
+	}
+
+	memcpy(buffer, src.buffer, length);
+}
+
+DeferredMessage::~DeferredMessage()
+{
+	if (buffer != inlineBuffer)
+	{
+		delete [] buffer;
+	}
+}
+
+void DeferredMessage::clear()
+{
+	if (buffer != inlineBuffer)
+	{
+		delete [] buffer;
+		buffer = inlineBuffer;
+		capacity = INLINE_CAPACITY;
+	}
+
+	length = 0;
+}
+
+void DeferredMessage::reserve(size_t size)
+{
+	size_t newCapacity = capacity * 2;
+
+	if (newCapacity < length + size)
+	{
+		newCapacity = length + size;
+	}
+
+	char* newBuffer = new char[newCapacity];
+	memcpy(newBuffer, buffer, length);
+
+	if (buffer != inlineBuffer)
+	{
+		delete [] buffer;
+	}
+
+	buffer = newBuffer;
+	capacity = newCapacity;
+}
+
+void DeferredMessage::putString(Type type, const void* value, size_t size)
+{
+	if (length + 1 + sizeof(size) + size > capacity)
+	{
+		reserve(1 + sizeof(size) + size);
+	}
+
+	buffer[length++] = (char) type;
+	memcpy(buffer + length, &size, sizeof(size));
+	length += sizeof(size);
+
+	if (size > 0)
+	{
+		memcpy(buffer + length, value, size);
+		length += size;
+	}
+}
+
+void DeferredMessage::render(LogString& dest) const
+{
+	if (format == 0)
+	{
+		return;
+	}
+
+	size_t offset = 0;
+	const char* literal = format;
+	const char* pos = format;
+
+	while (*pos != 0)
+	{
+		if ((pos[0] == '{' && pos[1] == '{') || (pos[0] == '}' && pos[1] == '}'))
+		{
+			appendLiteral(literal, pos + 1, dest);
+			pos += 2;
+			literal = pos;
+		}
+		else if (pos[0] == '{' && pos[1] == '}' && offset < length)
+		{
+			appendLiteral(literal, pos, dest);
+			renderArgument(offset, dest);
+			pos += 2;
+			literal = pos;
+		}
+		else
+		{
+			pos++;
+		}
+	}
+
+	appendLiteral(literal, pos, dest);
+}
+
+void DeferredMessage::renderArgument(size_t& offset, LogString& dest) const
+{
+	Type type = (Type) buffer[offset++];
+
+	switch (type)
+	{
+		case BOOLEAN:
+			StringHelper::toString(buffer[offset] != 0, dest);
+			offset++;
+			break;
+
+		case CHARACTER:
+			Transcoder::decode(std::string(1, buffer[offset]), dest);
+			offset++;
+			break;
+
+		case SIGNED:
+		{
+			long long value;
+			memcpy(&value, buffer + offset, sizeof(value));
+			offset += sizeof(value);
+			unsigned long long magnitude = value;
+
+			if (value < 0)
+			{
+				magnitude = 0 - magnitude;
+			}
+
+			appendInteger(magnitude, value < 0, 10, dest);
+		}
+		break;
+
+		case UNSIGNED:
+		{
+			unsigned long long value;
+			memcpy(&value, buffer + offset, sizeof(value));
+			offset += sizeof(value);
+			appendInteger(value, false, 10, dest);
+		}
+		break;
+
+		case FLOATING:
+		{
+			double value;
+			memcpy(&value, buffer + offset, sizeof(value));
+			offset += sizeof(value);
+			std::ostringstream os;
+			os << value;
+			Transcoder::decode(os.str(), dest);
+		}
+		break;
+
+		case POINTER:
+		{
+			const void* value;
+			memcpy(&value, buffer + offset, sizeof(value));
+			offset += sizeof(value);
+			dest.append(LOG4CXX_STR("0x"));
+			appendInteger((size_t) value, false, 16, dest);
+		}
+		break;
+
+		case STRING:
+		{
+			size_t size;
+			memcpy(&size, buffer + offset, sizeof(size));
+			offset += sizeof(size);
+			Transcoder::decode(std::string(buffer + offset, size), dest);
+			offset += size;
+		}
+		break;
+
+#if LOG4CXX_WCHAR_T_API
+
+		case WIDE_CHARACTER:
+		{
+			wchar_t value;
+			memcpy(&value, buffer + offset, sizeof(value));
+			offset += sizeof(value);
+			Transcoder::decode(std::wstring(1, value), dest);
+		}
+		break;
+
+		case WIDE_STRING:
+		{
+			size_t size;
+			memcpy(&size, buffer + offset, sizeof(size));
+			offset += sizeof(size);
+			std::wstring value(size / sizeof(wchar_t), 0);
+
+			if (size > 0)
+			{
+				memcpy(&value[0], buffer + offset, size);
+			}
+
+			Transcoder::decode(value, dest);
+			offset += size;
+		}
+		break;
+#endif
+
+		default:
+			offset = length;
+			break;
+	}
+}
@@ -0,0 +1,135 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <log4cxx/logstring.h>
+#include <log4cxx/helpers/eventringbuffer.h>
+#include <log4cxx/spi/loggingevent.h>
+#include <log4cxx/helpers/exception.h>
+#include <log4cxx/helpers/pool.h>
+#include <log4cxx/helpers/stringhelper.h>
+#include <apr_atomic.h>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::spi;
+
+
+EventRingBuffer::EventRingBuffer(int capacity)
+	: slots(0), mask(0), enqueuePosition(0), dequeuePosition(0)
+{
+	if (capacity < 1 || capacity > (1 << 30))
+	{
+		LogString msg(LOG4CXX_STR("The capacity argument ("));
+		Pool p;
+		StringHelper::toString(capacity, p, msg);
+		msg.append(LOG4CXX_STR(") is out of range."));
+		throw IllegalArgumentException(msg);
+	}
+
+	unsigned int size = 2;
+
+	while (size < (unsigned int) capacity)
+	{
+		size <<= 1;
+	}
+
+	slots = new Slot[size];
+	mask = size - 1;
+
+	for (unsigned int i = 0; i < size; i++)
+	{
+		slots[i].sequence = i;
+		slots[i].event = 0;
+	}
+}
+
+EventRingBuffer::~EventRingBuffer()
+{
+	LoggingEventList remaining;
+	drain(remaining, mask + 1);
+	delete [] slots;
+}
+
+bool EventRingBuffer::offer(const LoggingEventPtr& event)
+{
+	unsigned int position = enqueuePosition;
+	Slot* slot;
+
+	//
+	//   claim the slot at the enqueue position, a slot is free
+	//      when its sequence number equals the position
+	//
+	for (;;)
+	{
+		slot = &slots[position & mask];
+		int difference = (int) (slot->sequence - position);
+
+		if (difference == 0)
+		{
+			unsigned int previous = apr_atomic_cas32(&enqueuePosition, position + 1, position);
+
+			if (previous == position)
+			{
+				break;
+			}
+
+			position = previous;
+		}
+		else if (difference < 0)
+		{
+			return false;
+		}
+		else
+		{
+			position = enqueuePosition;
+		}
+	}
+
+	event->addRef();
+	slot->event = event;
+	apr_atomic_xchg32(&slot->sequence, position + 1);
+	return true;
+}
+
+size_t EventRingBuffer::drain(LoggingEventList& dest, size_t maxCount)
+{
+	size_t count = 0;
+
+	while (count < maxCount)
+	{
+		Slot* slot = &slots[dequeuePosition & mask];
+
+		if (apr_atomic_read32(&slot->sequence) != dequeuePosition + 1)
+		{
+			break;
+		}
+
+		LoggingEvent* event = slot->event;
+		slot->event = 0;
+		dest.push_back(event);
+		event->releaseRef();
+		apr_atomic_xchg32(&slot->sequence, dequeuePosition + mask + 1);
+		dequeuePosition++;
+		count++;
+	}
+
+	return count;
+}
+
+bool EventRingBuffer::isEmpty() const
+{
+	return apr_atomic_read32(&slots[dequeuePosition & mask].sequence) != dequeuePosition + 1;
+}
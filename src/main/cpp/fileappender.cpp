@@ -17,12 +17,16 @@
 
 #include <log4cxx/logstring.h>
 #include <log4cxx/fileappender.h>
+#include <log4cxx/binarylayout.h>
 #include <log4cxx/helpers/stringhelper.h>
 #include <log4cxx/helpers/loglog.h>
 #include <log4cxx/helpers/optionconverter.h>
 #include <log4cxx/helpers/synchronized.h>
 #include <log4cxx/helpers/pool.h>
 #include <log4cxx/helpers/fileoutputstream.h>
+#include <log4cxx/helpers/groupcommitoutputstream.h>
+#include <log4cxx/helpers/iouringoutputstream.h>
+#include <log4cxx/helpers/mappedfileoutputstream.h>
 #include <log4cxx/helpers/outputstreamwriter.h>
 #include <log4cxx/helpers/bufferedwriter.h>
 #include <log4cxx/helpers/bytebuffer.h>
@@ -41,6 +45,13 @@ FileAppender::FileAppender()
 	fileAppend = true;
 	bufferedIO = false;
 	bufferSize = 8 * 1024;
+	groupCommit = false;
+	groupCommitLatency = 5;
+	syncInterval = 0;
+	memoryMapped = false;
+	mappedChunkSize = 4 * 1024 * 1024;
+	ioUring = false;
+	setBatchingType(typeid(FileAppender));
 }
 
 FileAppender::FileAppender(const LayoutPtr& layout1, const LogString& fileName1,
@@ -53,7 +64,14 @@ FileAppender::FileAppender(const LayoutPtr& layout1, const LogString& fileName1,
 		fileName = fileName1;
 		bufferedIO = bufferedIO1;
 		bufferSize = bufferSize1;
+		groupCommit = false;
+		groupCommitLatency = 5;
+		syncInterval = 0;
+		memoryMapped = false;
+		mappedChunkSize = 4 * 1024 * 1024;
+		ioUring = false;
 	}
+	setBatchingType(typeid(FileAppender));
 	Pool p;
 	activateOptions(p);
 }
@@ -68,7 +86,14 @@ FileAppender::FileAppender(const LayoutPtr& layout1, const LogString& fileName1,
 		fileName = fileName1;
 		bufferedIO = false;
 		bufferSize = 8 * 1024;
+		groupCommit = false;
+		groupCommitLatency = 5;
+		syncInterval = 0;
+		memoryMapped = false;
+		mappedChunkSize = 4 * 1024 * 1024;
+		ioUring = false;
 	}
+	setBatchingType(typeid(FileAppender));
 	Pool p;
 	activateOptions(p);
 }
@@ -82,7 +107,14 @@ FileAppender::FileAppender(const LayoutPtr& layout1, const LogString& fileName1)
 		fileName = fileName1;
 		bufferedIO = false;
 		bufferSize = 8 * 1024;
+		groupCommit = false;
+		groupCommitLatency = 5;
+		syncInterval = 0;
+		memoryMapped = false;
+		mappedChunkSize = 4 * 1024 * 1024;
+		ioUring = false;
 	}
+	setBatchingType(typeid(FileAppender));
 	Pool p;
 	activateOptions(p);
 }
@@ -117,6 +149,24 @@ void FileAppender::setBufferedIO(bool bufferedIO1)
 	}
 }
 
+void FileAppender::setGroupCommit(bool groupCommit1)
+{
+	LOCK_W sync(mutex);
+	this->groupCommit = groupCommit1;
+}
+
+void FileAppender::setMemoryMapped(bool memoryMapped1)
+{
+	LOCK_W sync(mutex);
+	this->memoryMapped = memoryMapped1;
+}
+
+void FileAppender::setIOUring(bool ioUring1)
+{
+	LOCK_W sync(mutex);
+	this->ioUring = ioUring1;
+}
+
 void FileAppender::setOption(const LogString& option,
 	const LogString& value)
 {
@@ -146,6 +196,36 @@ void FileAppender::setOption(const LogString& option,
 		LOCK_W sync(mutex);
 		bufferSize = OptionConverter::toFileSize(value, 8 * 1024);
 	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("GROUPCOMMIT"), LOG4CXX_STR("groupcommit")))
+	{
+		LOCK_W sync(mutex);
+		groupCommit = OptionConverter::toBoolean(value, false);
+	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("GROUPCOMMITLATENCY"), LOG4CXX_STR("groupcommitlatency")))
+	{
+		LOCK_W sync(mutex);
+		groupCommitLatency = OptionConverter::toInt(value, 5);
+	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("SYNCINTERVAL"), LOG4CXX_STR("syncinterval")))
+	{
+		LOCK_W sync(mutex);
+		syncInterval = OptionConverter::toInt(value, 0);
+	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("MEMORYMAPPED"), LOG4CXX_STR("memorymapped")))
+	{
+		LOCK_W sync(mutex);
+		memoryMapped = OptionConverter::toBoolean(value, false);
+	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("MAPPEDCHUNKSIZE"), LOG4CXX_STR("mappedchunksize")))
+	{
+		LOCK_W sync(mutex);
+		mappedChunkSize = OptionConverter::toFileSize(value, 4 * 1024 * 1024);
+	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("IOURING"), LOG4CXX_STR("iouring")))
+	{
+		LOCK_W sync(mutex);
+		ioUring = OptionConverter::toBoolean(value, false);
+	}
 	else
 	{
 		WriterAppender::setOption(option, value);
@@ -304,7 +384,7 @@ void FileAppender::setFile(
 
 	try
 	{
-		outStream = new FileOutputStream(filename, append1);
+		outStream = createOutputStream(filename, append1);
 	}
 	catch (IOException& ex)
 	{
@@ -317,7 +397,7 @@ void FileAppender::setFile(
 
 			if (!parentDir.exists(p) && parentDir.mkdirs(p))
 			{
-				outStream = new FileOutputStream(filename, append1);
+				outStream = createOutputStream(filename, append1);
 			}
 			else
 			{
@@ -343,7 +423,16 @@ void FileAppender::setFile(
 
 	WriterPtr newWriter(createWriter(outStream));
 
-	if (bufferedIO1)
+	//
+	//   group commit, mapped and io_uring streams collect
+	//      small writes themselves, a binary layout writes
+	//      bytes past the writer and needs it unwrapped
+	//
+	bool collects = groupCommit || memoryMapped
+		|| IOUringOutputStreamPtr(outStream) != NULL;
+	bool binary = BinaryLayoutPtr(layout) != NULL;
+
+	if (bufferedIO1 && !collects && !binary)
 	{
 		newWriter = new BufferedWriter(newWriter, bufferSize1);
 	}
@@ -358,3 +447,46 @@ void FileAppender::setFile(
 
 }
 
+OutputStreamPtr FileAppender::createOutputStream(const LogString& filename, bool append1)
+{
+	if (memoryMapped)
+	{
+		return new MappedFileOutputStream(filename, append1,
+				mappedChunkSize > 0 ? mappedChunkSize : 4 * 1024 * 1024,
+				syncInterval);
+	}
+
+	if (ioUring)
+	{
+		if (IOUringOutputStream::isAvailable())
+		{
+			//
+			//   64 segments in flight before appending waits,
+			//      the probe only sizes a small ring so the
+			//      real one can still be refused
+			//
+			try
+			{
+				return new IOUringOutputStream(filename, append1,
+						bufferSize > 0 ? bufferSize : 8 * 1024, 64);
+			}
+			catch (IOException&)
+			{
+			}
+		}
+
+		LogLog::warn(LOG4CXX_STR("io_uring is not available, writing [")
+			+ filename + LOG4CXX_STR("] without it."));
+	}
+
+	OutputStreamPtr outStream(new FileOutputStream(filename, append1));
+
+	if (groupCommit)
+	{
+		outStream = new GroupCommitOutputStream(outStream,
+			bufferSize > 0 ? bufferSize : 8 * 1024,
+			groupCommitLatency, syncInterval);
+	}
+
+	return outStream;
+}
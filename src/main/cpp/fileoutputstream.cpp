@@ -20,6 +20,17 @@
 #include <log4cxx/helpers/exception.h>
 #include <log4cxx/helpers/bytebuffer.h>
 #include <apr_file_io.h>
+#define APR_WANT_IOVEC
+#include <apr_want.h>
+#include <apr_version.h>
+#if !APR_VERSION_AT_LEAST(1, 7, 0)
+	#include <apr_portable.h>
+	#if defined(_WIN32)
+		#include <windows.h>
+	#else
+		#include <unistd.h>
+	#endif
+#endif
 #include <log4cxx/helpers/transcoder.h>
 #if !defined(LOG4CXX)
 	#define LOG4CXX 1
@@ -123,3 +134,77 @@ void FileOutputStream::write(ByteBuffer& buf, Pool& /* p */ )
 	}
 }
 
+void FileOutputStream::writeAll(const ByteStringList& buffers, Pool& /* p */)
+{
+	if (fileptr == NULL)
+	{
+		throw IOException(-1);
+	}
+
+	//
+	//   POSIX only promises that 16 buffers can be gathered in a
+	//      single call, Linux and the BSDs allow 1024
+	//
+	enum { MAX_IOVEC = 64 };
+	struct iovec vec[MAX_IOVEC];
+	ByteStringList::const_iterator iter = buffers.begin();
+
+	while (iter != buffers.end())
+	{
+		apr_size_t nvec = 0;
+
+		for (; iter != buffers.end() && nvec < MAX_IOVEC; iter++)
+		{
+			if (!iter->empty())
+			{
+				vec[nvec].iov_base = const_cast<char*>(iter->data());
+				vec[nvec].iov_len = iter->length();
+				nvec++;
+			}
+		}
+
+		if (nvec > 0)
+		{
+			apr_size_t nbytes = 0;
+			apr_status_t stat = apr_file_writev_full(fileptr, vec, nvec, &nbytes);
+
+			if (stat != APR_SUCCESS)
+			{
+				throw IOException(stat);
+			}
+		}
+	}
+}
+
+void FileOutputStream::sync(Pool& /* p */)
+{
+	if (fileptr == NULL)
+	{
+		throw IOException(-1);
+	}
+
+#if APR_VERSION_AT_LEAST(1, 7, 0)
+	apr_status_t stat = apr_file_datasync(fileptr);
+#else
+	//
+	//   apr_file_datasync is not available before APR 1.7
+	//
+	apr_os_file_t fd;
+	apr_status_t stat = apr_os_file_get(&fd, fileptr);
+
+	if (stat == APR_SUCCESS)
+	{
+#if defined(_WIN32)
+		stat = FlushFileBuffers(fd) ? APR_SUCCESS : apr_get_os_error();
+#else
+		stat = fsync(fd) == 0 ? APR_SUCCESS : apr_get_os_error();
+#endif
+	}
+
+#endif
+
+	if (stat != APR_SUCCESS)
+	{
+		throw IOException(stat);
+	}
+}
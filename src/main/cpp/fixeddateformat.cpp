@@ -0,0 +1,286 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/helpers/fixeddateformat.h>
+#include <log4cxx/helpers/pool.h>
+#include <apr_time.h>
+#include <apr_atomic.h>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+
+namespace
+{
+/**
+ *  "00" to "99", two characters per value.
+ */
+const logchar digitPairs[] =
+{
+	0x30, 0x30, 0x30, 0x31, 0x30, 0x32, 0x30, 0x33, 0x30, 0x34,
+	0x30, 0x35, 0x30, 0x36, 0x30, 0x37, 0x30, 0x38, 0x30, 0x39,
+	0x31, 0x30, 0x31, 0x31, 0x31, 0x32, 0x31, 0x33, 0x31, 0x34,
+	0x31, 0x35, 0x31, 0x36, 0x31, 0x37, 0x31, 0x38, 0x31, 0x39,
+	0x32, 0x30, 0x32, 0x31, 0x32, 0x32, 0x32, 0x33, 0x32, 0x34,
+	0x32, 0x35, 0x32, 0x36, 0x32, 0x37, 0x32, 0x38, 0x32, 0x39,
+	0x33, 0x30, 0x33, 0x31, 0x33, 0x32, 0x33, 0x33, 0x33, 0x34,
+	0x33, 0x35, 0x33, 0x36, 0x33, 0x37, 0x33, 0x38, 0x33, 0x39,
+	0x34, 0x30, 0x34, 0x31, 0x34, 0x32, 0x34, 0x33, 0x34, 0x34,
+	0x34, 0x35, 0x34, 0x36, 0x34, 0x37, 0x34, 0x38, 0x34, 0x39,
+	0x35, 0x30, 0x35, 0x31, 0x35, 0x32, 0x35, 0x33, 0x35, 0x34,
+	0x35, 0x35, 0x35, 0x36, 0x35, 0x37, 0x35, 0x38, 0x35, 0x39,
+	0x36, 0x30, 0x36, 0x31, 0x36, 0x32, 0x36, 0x33, 0x36, 0x34,
+	0x36, 0x35, 0x36, 0x36, 0x36, 0x37, 0x36, 0x38, 0x36, 0x39,
+	0x37, 0x30, 0x37, 0x31, 0x37, 0x32, 0x37, 0x33, 0x37, 0x34,
+	0x37, 0x35, 0x37, 0x36, 0x37, 0x37, 0x37, 0x38, 0x37, 0x39,
+	0x38, 0x30, 0x38, 0x31, 0x38, 0x32, 0x38, 0x33, 0x38, 0x34,
+	0x38, 0x35, 0x38, 0x36, 0x38, 0x37, 0x38, 0x38, 0x38, 0x39,
+	0x39, 0x30, 0x39, 0x31, 0x39, 0x32, 0x39, 0x33, 0x39, 0x34,
+	0x39, 0x35, 0x39, 0x36, 0x39, 0x37, 0x39, 0x38, 0x39, 0x39
+};
+
+inline logchar* putTwoDigits(logchar* out, int value)
+{
+	out[0] = digitPairs[value * 2];
+	out[1] = digitPairs[value * 2 + 1];
+	return out + 2;
+}
+
+inline logchar* putThreeDigits(logchar* out, int value)
+{
+	out[0] = digitPairs[(value / 100) * 2 + 1];
+	return putTwoDigits(out + 1, value % 100);
+}
+
+inline logchar* putYear(logchar* out, int year)
+{
+	return putTwoDigits(putTwoDigits(out, year / 100), year % 100);
+}
+
+const log4cxx_time_t MICROSECONDS_PER_QUARTER_HOUR = APR_INT64_C(900000000);
+
+/**
+ *  Seconds from 1970-01-01 to 10000-01-01.
+ */
+const log4cxx_time_t FIVE_DIGIT_YEARS = APR_INT64_C(2932897) * 86400;
+}
+
+FixedDateFormat::FixedDateFormat(Style style1) :
+	SimpleDateFormat(getPattern(style1)),
+	style(style1),
+	timeZone(TimeZone::getDefault()),
+	monthNames(),
+	offsetCache(0)
+{
+	if (style == DATE)
+	{
+		SimpleDateFormat monthFormat(LOG4CXX_STR("MMM"));
+		setMonthNames(monthFormat);
+	}
+}
+
+FixedDateFormat::FixedDateFormat(Style style1, const std::locale* locale) :
+	SimpleDateFormat(getPattern(style1), locale),
+	style(style1),
+	timeZone(TimeZone::getDefault()),
+	monthNames(),
+	offsetCache(0)
+{
+	if (style == DATE)
+	{
+		SimpleDateFormat monthFormat(LOG4CXX_STR("MMM"), locale);
+		setMonthNames(monthFormat);
+	}
+}
+
+LogString FixedDateFormat::getPattern(Style style)
+{
+	switch (style)
+	{
+		case ABSOLUTE:
+			return LOG4CXX_STR("HH:mm:ss,SSS");
+
+		case DATE:
+			return LOG4CXX_STR("dd MMM yyyy HH:mm:ss,SSS");
+
+		default:
+			//
+			//   ISO8601_MICROS appends the sub-millisecond digits itself.
+			//
+			return LOG4CXX_STR("yyyy-MM-dd HH:mm:ss,SSS");
+	}
+}
+
+/**
+ *  Renders the month names through the pattern parser so that
+ *  they follow the same locale as the base class.
+ */
+void FixedDateFormat::setMonthNames(SimpleDateFormat& monthFormat)
+{
+	Pool p;
+	monthFormat.setTimeZone(TimeZone::getGMT());
+
+	for (int month = 0; month < 12; month++)
+	{
+		//
+		//   day 31 * month + 5 of 1970 always falls within that month
+		//
+		LogString name;
+		monthFormat.format(name,
+			(log4cxx_time_t) (month * 31 + 5) * 86400 * APR_USEC_PER_SEC, p);
+		monthNames.push_back(name);
+	}
+}
+
+void FixedDateFormat::setTimeZone(const TimeZonePtr& zone)
+{
+	SimpleDateFormat::setTimeZone(zone);
+	timeZone = zone;
+	apr_atomic_set32(&offsetCache, 0);
+}
+
+/**
+ *  Gets the offset from UTC in seconds.  Time zone rules change
+ *  on quarter hour boundaries, so the offset found by exploding one
+ *  time is reused for the rest of its quarter hour.
+ */
+bool FixedDateFormat::getOffset(log4cxx_time_t tm, int& offset) const
+{
+	log4cxx_time_t quarter = tm / MICROSECONDS_PER_QUARTER_HOUR;
+	unsigned int cached = apr_atomic_read32(&offsetCache);
+
+	if (cached != 0 && (log4cxx_time_t) (cached >> 8) == quarter)
+	{
+		offset = ((int) (cached & 0xFF) - 128) * 900;
+		return true;
+	}
+
+	apr_time_exp_t exploded;
+
+	if (timeZone->explode(&exploded, tm) != APR_SUCCESS)
+	{
+		return false;
+	}
+
+	offset = exploded.tm_gmtoff;
+
+	if (quarter < 0x1000000 && offset % 900 == 0
+		&& offset >= -128 * 900 && offset < 128 * 900)
+	{
+		apr_atomic_set32(&offsetCache,
+			((unsigned int) quarter << 8) | (unsigned int) (offset / 900 + 128));
+	}
+
+	return true;
+}
+
+void FixedDateFormat::format(LogString& s, log4cxx_time_t tm, Pool& p) const
+{
+	int offset = 0;
+	log4cxx_time_t seconds = -1;
+
+	if (tm >= 0 && getOffset(tm, offset))
+	{
+		seconds = tm / APR_USEC_PER_SEC + offset;
+	}
+
+	//
+	//   days before 1970 in the time zone or years past 9999,
+	//     let the base class do it.
+	//
+	if (seconds < 0 || seconds >= FIVE_DIGIT_YEARS)
+	{
+		SimpleDateFormat::format(s, tm, p);
+
+		if (style == ISO8601_MICROS)
+		{
+			int micros = (int) (tm % 1000);
+
+			if (micros < 0)
+			{
+				micros += 1000;
+			}
+
+			logchar digits[3];
+			putThreeDigits(digits, micros);
+			s.append(digits, 3);
+		}
+
+		return;
+	}
+
+	int days = (int) (seconds / 86400);
+	int secondOfDay = (int) (seconds % 86400);
+	int micros = (int) (tm % APR_USEC_PER_SEC);
+	logchar buf[32];
+	logchar* out = buf;
+
+	if (style != ABSOLUTE)
+	{
+		//
+		//   civil date from days since 1970-01-01,
+		//     with years starting in March so that
+		//     the leap day is last.
+		//
+		int z = days + 719468;
+		int era = z / 146097;
+		int dayOfEra = z - era * 146097;
+		int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524
+				- dayOfEra / 146096) / 365;
+		int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+		int shiftedMonth = (5 * dayOfYear + 2) / 153;
+		int day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+		int month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+		int year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+		if (style == DATE)
+		{
+			out = putTwoDigits(out, day);
+			*out++ = 0x20; // ' '
+			s.append(buf, out - buf);
+			s.append(monthNames[month - 1]);
+			out = buf;
+			*out++ = 0x20; // ' '
+			out = putYear(out, year);
+		}
+		else
+		{
+			out = putYear(out, year);
+			*out++ = 0x2D; // '-'
+			out = putTwoDigits(out, month);
+			*out++ = 0x2D; // '-'
+			out = putTwoDigits(out, day);
+		}
+
+		*out++ = 0x20; // ' '
+	}
+
+	out = putTwoDigits(out, secondOfDay / 3600);
+	*out++ = 0x3A; // ':'
+	out = putTwoDigits(out, (secondOfDay / 60) % 60);
+	*out++ = 0x3A; // ':'
+	out = putTwoDigits(out, secondOfDay % 60);
+	*out++ = 0x2C; // ','
+	out = putThreeDigits(out, micros / 1000);
+
+	if (style == ISO8601_MICROS)
+	{
+		out = putThreeDigits(out, micros % 1000);
+	}
+
+	s.append(buf, out - buf);
+}
@@ -29,8 +29,6 @@
 #include <log4cxx/helpers/exception.h>
 #include <log4cxx/rolling/rolloverdescription.h>
 #include <log4cxx/rolling/filerenameaction.h>
-#include <log4cxx/rolling/gzcompressaction.h>
-#include <log4cxx/rolling/zipcompressaction.h>
 #include <log4cxx/pattern/integerpatternconverter.h>
 
 using namespace log4cxx;
@@ -169,26 +167,8 @@ RolloverDescriptionPtr FixedWindowRollingPolicy::rollover(
 
 	LogString renameTo(buf);
 	LogString compressedName(renameTo);
-	ActionPtr compressAction ;
-
-	if (StringHelper::endsWith(renameTo, LOG4CXX_STR(".gz")))
-	{
-		renameTo.resize(renameTo.size() - 3);
-		compressAction =
-			new GZCompressAction(
-			File().setPath(renameTo),
-			File().setPath(compressedName),
-			true);
-	}
-	else if (StringHelper::endsWith(renameTo, LOG4CXX_STR(".zip")))
-	{
-		renameTo.resize(renameTo.size() - 4);
-		compressAction =
-			new ZipCompressAction(
-			File().setPath(renameTo),
-			File().setPath(compressedName),
-			true);
-	}
+	ActionPtr compressAction(createCompressAction(compressedName, true));
+	renameTo.resize(renameTo.size() - getCompressionSuffixLength(renameTo));
 
 	FileRenameActionPtr renameAction =
 		new FileRenameAction(
@@ -231,23 +211,13 @@ int FixedWindowRollingPolicy::getMinIndex() const
  */
 bool FixedWindowRollingPolicy::purge(int lowIndex, int highIndex, Pool& p) const
 {
-	int suffixLength = 0;
-
 	std::vector<FileRenameActionPtr> renames;
 	LogString buf;
 	ObjectPtr obj = new Integer(lowIndex);
 	formatFileName(obj, buf, p);
 
 	LogString lowFilename(buf);
-
-	if (lowFilename.compare(lowFilename.length() - 3, 3, LOG4CXX_STR(".gz")) == 0)
-	{
-		suffixLength = 3;
-	}
-	else if (lowFilename.compare(lowFilename.length() - 4, 4, LOG4CXX_STR(".zip")) == 0)
-	{
-		suffixLength = 4;
-	}
+	size_t suffixLength = getCompressionSuffixLength(lowFilename);
 
 	for (int i = lowIndex; i <= highIndex; i++)
 	{
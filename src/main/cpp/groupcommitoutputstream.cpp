@@ -0,0 +1,294 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/helpers/groupcommitoutputstream.h>
+#include <log4cxx/helpers/fileoutputstream.h>
+#include <log4cxx/helpers/bytebuffer.h>
+#include <log4cxx/helpers/exception.h>
+#include <log4cxx/helpers/synchronized.h>
+#include <log4cxx/helpers/loglog.h>
+#include <apr_time.h>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+
+IMPLEMENT_LOG4CXX_OBJECT(GroupCommitOutputStream)
+
+GroupCommitOutputStream::GroupCommitOutputStream(const OutputStreamPtr& out1,
+	size_t threshold1, int maxLatency1, int syncInterval1)
+	: pool(), mutex(pool), pendingData(pool), bufferSpace(pool), out(out1),
+	  threshold(threshold1 > 0 ? threshold1 : 1),
+	  maxLatency((log4cxx_time_t) maxLatency1 * 1000),
+	  syncInterval((log4cxx_time_t) syncInterval1 * 1000),
+	  active(), writing(), oldest(0), unsynced(0), idle(false), closed(false),
+	  flusher()
+{
+	active.reserve(threshold);
+	writing.reserve(threshold);
+#if APR_HAS_THREADS
+	flusher.run(commit, this);
+#endif
+}
+
+GroupCommitOutputStream::~GroupCommitOutputStream()
+{
+	try
+	{
+		Pool p;
+		stop(p);
+	}
+	catch (std::exception&)
+	{
+	}
+}
+
+void GroupCommitOutputStream::close(Pool& p)
+{
+	stop(p);
+	out->close(p);
+}
+
+void GroupCommitOutputStream::flush(Pool& /* p */)
+{
+	//
+	//   the flusher writes buffered data within maxLatency,
+	//      waiting for it here would give up the batching
+}
+
+#if APR_HAS_THREADS
+void GroupCommitOutputStream::write(ByteBuffer& buf, Pool& /* p */)
+{
+	synchronized sync(mutex);
+	append(buf.current(), buf.remaining());
+	buf.position(buf.limit());
+}
+
+void GroupCommitOutputStream::writeAll(const ByteStringList& buffers, Pool& /* p */)
+{
+	synchronized sync(mutex);
+
+	for (ByteStringList::const_iterator iter = buffers.begin();
+		iter != buffers.end();
+		iter++)
+	{
+		append(iter->data(), iter->length());
+	}
+}
+#else
+void GroupCommitOutputStream::write(ByteBuffer& buf, Pool& p)
+{
+	out->write(buf, p);
+}
+
+void GroupCommitOutputStream::writeAll(const ByteStringList& buffers, Pool& p)
+{
+	out->writeAll(buffers, p);
+}
+#endif
+
+/**
+ *  Copies data to the active buffer, the caller must hold mutex.
+ */
+void GroupCommitOutputStream::append(const char* data, size_t length)
+{
+	//
+	//   only block when the flusher has fallen well behind
+	//
+	while (active.length() >= 4 * threshold && !closed)
+	{
+		bufferSpace.await(mutex);
+	}
+
+	if (closed)
+	{
+		throw IOException(-1);
+	}
+
+	size_t used = active.length();
+
+	if (used == 0)
+	{
+		oldest = apr_time_now();
+	}
+
+	active.append(data, length);
+
+	if ((used == 0 && idle) || (used < threshold && active.length() >= threshold))
+	{
+		pendingData.signalAll();
+	}
+}
+
+void GroupCommitOutputStream::stop(Pool& p)
+{
+	{
+		synchronized sync(mutex);
+
+		if (closed)
+		{
+			return;
+		}
+
+		closed = true;
+		pendingData.signalAll();
+		bufferSpace.signalAll();
+	}
+
+	flusher.join();
+
+	//
+	//   the flusher has exited, write whatever it left behind
+	//
+	writeOut(active, p);
+
+	if (syncInterval > 0)
+	{
+		sync(p);
+	}
+}
+
+void* LOG4CXX_THREAD_FUNC GroupCommitOutputStream::commit(apr_thread_t* /* thread */, void* data)
+{
+	GroupCommitOutputStream* pThis = (GroupCommitOutputStream*) data;
+	Pool p;
+
+	try
+	{
+		while (pThis->commitNext(p))
+		{
+		}
+	}
+	catch (InterruptedException&)
+	{
+		Thread::currentThreadInterrupt();
+	}
+
+	return 0;
+}
+
+/**
+ *  Waits until the active buffer is due to be written or the written
+ *  data is due to be synced, then does so.
+ *  @return false once the stream has been closed.
+ */
+bool GroupCommitOutputStream::commitNext(Pool& p)
+{
+	{
+		synchronized sync(mutex);
+
+		for (;;)
+		{
+			if (closed)
+			{
+				return false;
+			}
+
+			log4cxx_time_t now = apr_time_now();
+			log4cxx_time_t deadline = 0;
+
+			if (!active.empty())
+			{
+				if (active.length() >= threshold || now >= oldest + maxLatency)
+				{
+					active.swap(writing);
+					bufferSpace.signalAll();
+					break;
+				}
+
+				deadline = oldest + maxLatency;
+			}
+
+			if (unsynced != 0)
+			{
+				if (now >= unsynced + syncInterval)
+				{
+					break;
+				}
+
+				if (deadline == 0 || unsynced + syncInterval < deadline)
+				{
+					deadline = unsynced + syncInterval;
+				}
+			}
+
+			if (deadline == 0)
+			{
+				idle = true;
+				pendingData.await(mutex);
+				idle = false;
+			}
+			else
+			{
+				pendingData.await(mutex, deadline - now);
+			}
+		}
+	}
+
+	if (!writing.empty())
+	{
+		try
+		{
+			writeOut(writing, p);
+		}
+		catch (IOException& e)
+		{
+			writing.clear();
+			LogLog::error(LOG4CXX_STR("Unable to write buffered output"), e);
+		}
+
+		if (syncInterval > 0 && unsynced == 0)
+		{
+			unsynced = apr_time_now();
+		}
+	}
+
+	if (unsynced != 0 && apr_time_now() >= unsynced + syncInterval)
+	{
+		try
+		{
+			sync(p);
+		}
+		catch (IOException& e)
+		{
+			LogLog::error(LOG4CXX_STR("Unable to sync buffered output"), e);
+		}
+	}
+
+	return true;
+}
+
+void GroupCommitOutputStream::writeOut(std::string& data, Pool& p)
+{
+	if (!data.empty())
+	{
+		ByteBuffer buf(&data[0], data.length());
+		out->write(buf, p);
+		data.clear();
+	}
+}
+
+void GroupCommitOutputStream::sync(Pool& p)
+{
+	unsynced = 0;
+	FileOutputStreamPtr file(out);
+
+	if (file != NULL)
+	{
+		file->sync(p);
+	}
+}
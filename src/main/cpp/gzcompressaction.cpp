@@ -20,6 +20,13 @@
 #include <apr_strings.h>
 #include <log4cxx/helpers/exception.h>
 #include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/private/log4cxx_private.h>
+
+#if LOG4CXX_HAVE_ZLIB
+	#include <zlib.h>
+	#include <string.h>
+	#include <vector>
+#endif
 
 using namespace log4cxx;
 using namespace log4cxx::rolling;
@@ -27,10 +34,20 @@ using namespace log4cxx::helpers;
 
 IMPLEMENT_LOG4CXX_OBJECT(GZCompressAction)
 
+#define GZ_BUFFER_SIZE 65536
+
 GZCompressAction::GZCompressAction(const File& src,
 	const File& dest,
 	bool del)
-	: source(src), destination(dest), deleteSource(del)
+	: source(src), destination(dest), deleteSource(del), level(-1)
+{
+}
+
+GZCompressAction::GZCompressAction(const File& src,
+	const File& dest,
+	bool del,
+	int lvl)
+	: source(src), destination(dest), deleteSource(del), level(lvl)
 {
 }
 
@@ -38,6 +55,90 @@ bool GZCompressAction::execute(log4cxx::helpers::Pool& p) const
 {
 	if (source.exists(p))
 	{
+#if LOG4CXX_HAVE_ZLIB
+		//
+		//   deflate in-process with a gzip wrapper
+		//
+		apr_file_t* in;
+		apr_status_t stat = source.open(&in, APR_FOPEN_READ | APR_FOPEN_BINARY,
+				APR_OS_DEFAULT, p);
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(stat);
+		}
+
+		apr_file_t* out;
+		stat = destination.open(&out, APR_FOPEN_WRITE | APR_FOPEN_CREATE |
+				APR_FOPEN_TRUNCATE | APR_FOPEN_BINARY, APR_OS_DEFAULT, p);
+
+		if (stat != APR_SUCCESS)
+		{
+			apr_file_close(in);
+			throw IOException(stat);
+		}
+
+		z_stream zs;
+		memset(&zs, 0, sizeof(zs));
+
+		if (deflateInit2(&zs, level, Z_DEFLATED, MAX_WBITS + 16, 8,
+				Z_DEFAULT_STRATEGY) != Z_OK)
+		{
+			apr_file_close(in);
+			apr_file_close(out);
+			throw IOException(APR_EINVAL);
+		}
+
+		std::vector<Bytef> inBuf(GZ_BUFFER_SIZE);
+		std::vector<Bytef> outBuf(GZ_BUFFER_SIZE);
+		int flush = Z_NO_FLUSH;
+
+		while (stat == APR_SUCCESS && flush != Z_FINISH)
+		{
+			apr_size_t count = inBuf.size();
+			stat = apr_file_read(in, &inBuf[0], &count);
+
+			if (stat == APR_EOF)
+			{
+				stat = APR_SUCCESS;
+				count = 0;
+			}
+
+			flush = (count == 0) ? Z_FINISH : Z_NO_FLUSH;
+			zs.next_in = &inBuf[0];
+			zs.avail_in = (uInt) count;
+
+			while (stat == APR_SUCCESS)
+			{
+				zs.next_out = &outBuf[0];
+				zs.avail_out = (uInt) outBuf.size();
+				deflate(&zs, flush);
+				stat = apr_file_write_full(out, &outBuf[0],
+						outBuf.size() - zs.avail_out, NULL);
+
+				if (zs.avail_out != 0)
+				{
+					break;
+				}
+			}
+		}
+
+		deflateEnd(&zs);
+		apr_file_close(in);
+		apr_status_t closeStat = apr_file_close(out);
+
+		if (stat == APR_SUCCESS)
+		{
+			stat = closeStat;
+		}
+
+		if (stat != APR_SUCCESS)
+		{
+			destination.deleteFile(p);
+			throw IOException(stat);
+		}
+
+#else
 		apr_pool_t* aprpool = p.getAPRPool();
 		apr_procattr_t* attr;
 		apr_status_t stat = apr_procattr_create(&attr, aprpool);
@@ -98,10 +199,16 @@ bool GZCompressAction::execute(log4cxx::helpers::Pool& p) const
 		}
 
 		const char** args = (const char**)
-			apr_palloc(aprpool, 4 * sizeof(*args));
+			apr_palloc(aprpool, 5 * sizeof(*args));
 		int i = 0;
 		args[i++] = "gzip";
 		args[i++] = "-c";
+
+		if (level >= 1 && level <= 9)
+		{
+			args[i++] = apr_psprintf(aprpool, "-%d", level);
+		}
+
 		args[i++] = Transcoder::encode(source.getPath(), p);
 		args[i++] = NULL;
 
@@ -122,6 +229,8 @@ bool GZCompressAction::execute(log4cxx::helpers::Pool& p) const
 			throw IOException(stat);
 		}
 
+#endif
+
 		if (deleteSource)
 		{
 			source.deleteFile(p);
@@ -32,6 +32,7 @@
 #include <log4cxx/helpers/synchronized.h>
 #include <log4cxx/logstring.h>
 #include <log4cxx/helpers/stringhelper.h>
+#include <log4cxx/helpers/threadspecificdata.h>
 #if !defined(LOG4CXX)
 	#define LOG4CXX 1
 #endif
@@ -48,10 +49,130 @@ using namespace log4cxx::helpers;
 
 IMPLEMENT_LOG4CXX_OBJECT(Hierarchy)
 
+struct Hierarchy::LookupTable
+{
+	struct Entry
+	{
+		Entry(const LoggerPtr& logger1, unsigned int hash1, Entry* next1) :
+			logger(logger1), hash(hash1), next(next1)
+		{
+		}
+
+		const LoggerPtr logger;
+		const unsigned int hash;
+		Entry* const next;
+	};
+
+	explicit LookupTable(size_t bucketCount) :
+		mask(bucketCount - 1),
+		buckets(new Entry* volatile[bucketCount]),
+		count(0),
+		epoch(0),
+		next(0)
+	{
+		for (size_t i = 0; i < bucketCount; i++)
+		{
+			buckets[i] = 0;
+		}
+	}
+
+	~LookupTable()
+	{
+		for (size_t i = 0; i <= mask; i++)
+		{
+			Entry* entry = buckets[i];
+
+			while (entry != 0)
+			{
+				Entry* next = entry->next;
+				delete entry;
+				entry = next;
+			}
+		}
+
+		delete [] buckets;
+	}
+
+	static void deleteList(LookupTable* table)
+	{
+		while (table != 0)
+		{
+			LookupTable* next = table->next;
+			delete table;
+			table = next;
+		}
+	}
+
+	static unsigned int hashName(const LogString& name)
+	{
+		// FNV-1a
+		unsigned int hash = 2166136261U;
+
+		for (LogString::const_iterator iter = name.begin();
+			iter != name.end();
+			iter++)
+		{
+			hash = (hash ^ (unsigned int) *iter) * 16777619U;
+		}
+
+		return hash;
+	}
+
+	Logger* find(const LogString& name, unsigned int hash) const
+	{
+		for (Entry* entry = buckets[hash & mask]; entry != 0; entry = entry->next)
+		{
+			if (entry->hash == hash && entry->logger->getName() == name)
+			{
+				return entry->logger;
+			}
+		}
+
+		return 0;
+	}
+
+	/**
+	 *  Adds a logger, publishing it to concurrent readers.
+	 *  Called with the hierarchy's mutex held.
+	 */
+	void add(const LoggerPtr& logger, unsigned int hash)
+	{
+		Entry* volatile* bucket = buckets + (hash & mask);
+		Entry* entry = new Entry(logger, hash, *bucket);
+		apr_atomic_xchgptr((volatile void**) bucket, entry);
+		count++;
+	}
+
+	bool isFull() const
+	{
+		return count > mask;
+	}
+
+	const size_t mask;
+	Entry* volatile* const buckets;
+	size_t count;
+
+	/**
+	 *  Reader epoch the table was retired in.
+	 */
+	unsigned int epoch;
+
+	/**
+	 *  Next retired table.
+	 */
+	LookupTable* next;
+
+	private:
+		LookupTable(const LookupTable&);
+		LookupTable& operator=(const LookupTable&);
+};
+
 Hierarchy::Hierarchy() :
 	pool(),
 	mutex(pool),
 	loggers(new LoggerMap()),
+	lookupTable(new LookupTable(64)),
+	retiredTables(0),
 	provisionNodes(new ProvisionNodeMap())
 {
 	synchronized sync(mutex);
@@ -71,6 +192,8 @@ Hierarchy::~Hierarchy()
 	// https://issues.apache.org/jira/browse/LOGCXX-430?focusedCommentId=15175254&page=com.atlassian.jira.plugin.system.issuetabpanels:comment-tabpanel#comment-15175254
 #ifndef APR_HAS_THREADS
 	delete loggers;
+	delete lookupTable;
+	LookupTable::deleteList(retiredTables);
 	delete provisionNodes;
 #endif
 }
@@ -103,6 +226,10 @@ void Hierarchy::clear()
 {
 	synchronized sync(mutex);
 	loggers->clear();
+	LookupTable* table = lookupTable;
+	apr_atomic_xchgptr((volatile void**) &lookupTable,
+		new LookupTable(table->mask + 1));
+	retireLookupTable(table);
 }
 
 void Hierarchy::emitNoAppenderWarning(const LoggerPtr& logger)
@@ -126,18 +253,17 @@ void Hierarchy::emitNoAppenderWarning(const LoggerPtr& logger)
 
 LoggerPtr Hierarchy::exists(const LogString& name)
 {
-	synchronized sync(mutex);
-
-	LoggerPtr logger;
-	LoggerMap::iterator it = loggers->find(name);
-
-	if (it != loggers->end())
+	unsigned int hash = LookupTable::hashName(name);
 	{
-		logger = it->second;
-	}
-
+		EpochRead read;
 
-	return logger;
+		if (read.isRecorded())
+		{
+			return lookupTable->find(name, hash);
+		}
+	}
+	synchronized sync(mutex);
+	return lookupTable->find(name, hash);
 }
 
 void Hierarchy::setThreshold(const LevelPtr& l)
@@ -147,6 +273,7 @@ void Hierarchy::setThreshold(const LevelPtr& l)
 		synchronized sync(mutex);
 		thresholdInt = l->toInt();
 		threshold = l;
+		Logger::invalidateEffectiveLevels();
 
 		if (thresholdInt != Level::ALL_INT)
 		{
@@ -220,6 +347,21 @@ LoggerPtr Hierarchy::getLogger(const LogString& name)
 LoggerPtr Hierarchy::getLogger(const LogString& name,
 	const spi::LoggerFactoryPtr& factory)
 {
+	unsigned int hash = LookupTable::hashName(name);
+	{
+		EpochRead read;
+
+		if (read.isRecorded())
+		{
+			Logger* existing = lookupTable->find(name, hash);
+
+			if (existing != 0)
+			{
+				return existing;
+			}
+		}
+	}
+
 	synchronized sync(mutex);
 
 	LoggerMap::iterator it = loggers->find(name);
@@ -243,6 +385,9 @@ LoggerPtr Hierarchy::getLogger(const LogString& name,
 		}
 
 		updateParents(logger);
+		Logger::invalidateAppenders();
+		//  only visible to lock-free lookups once fully linked
+		addToLookupTable(logger, hash);
 		return logger;
 	}
 
@@ -341,6 +486,56 @@ void Hierarchy::shutdown()
 }
 
 
+void Hierarchy::addToLookupTable(const LoggerPtr& logger, unsigned int hash)
+{
+	LookupTable* table = lookupTable;
+
+	if (!table->isFull())
+	{
+		table->add(logger, hash);
+		return;
+	}
+
+	//
+	//   rehash into a table twice the size, built from the map
+	//   so that readers of the current table are not disturbed
+	//
+	LookupTable* larger = new LookupTable((table->mask + 1) * 2);
+
+	for (LoggerMap::const_iterator it = loggers->begin(); it != loggers->end(); it++)
+	{
+		larger->add(it->second, LookupTable::hashName(it->first));
+	}
+
+	apr_atomic_xchgptr((volatile void**) &lookupTable, larger);
+	retireLookupTable(table);
+}
+
+void Hierarchy::retireLookupTable(LookupTable* table)
+{
+	table->epoch = ThreadSpecificData::advanceReaderEpoch();
+	table->next = retiredTables;
+	retiredTables = table;
+
+	unsigned int oldest = ThreadSpecificData::getOldestReaderEpoch(0);
+	LookupTable** link = &retiredTables;
+
+	while (*link != 0)
+	{
+		LookupTable* retired = *link;
+
+		if (retired->epoch <= oldest)
+		{
+			*link = retired->next;
+			delete retired;
+		}
+		else
+		{
+			link = &retired->next;
+		}
+	}
+}
+
 void Hierarchy::updateParents(LoggerPtr logger)
 {
 	synchronized sync(mutex);
@@ -411,6 +606,7 @@ void Hierarchy::setConfigured(bool newValue)
 {
 	synchronized sync(mutex);
 	configured = newValue;
+	Logger::invalidateEffectiveLevels();
 }
 
 bool Hierarchy::isConfigured()
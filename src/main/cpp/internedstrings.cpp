@@ -0,0 +1,137 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/helpers/internedstrings.h>
+#include <apr_atomic.h>
+#include <string>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+
+namespace
+{
+/**
+ *  Insert-only hash set.  Entries are added with a compare-and-swap
+ *  on the bucket head and are never deleted, so readers need no lock.
+ *  The buckets are zero initialized before any constructor runs,
+ *  which lets loggers created during static initialization intern
+ *  their names.
+ */
+template<class S>
+struct InternTable
+{
+	enum { BUCKET_COUNT = 1024 };
+
+	struct Entry
+	{
+		Entry(const S& value1, unsigned int hash1) :
+			value(value1), hash(hash1), next(0)
+		{
+		}
+
+		const S value;
+		const unsigned int hash;
+		Entry* next;
+	};
+
+	static unsigned int hashValue(const S& value)
+	{
+		// FNV-1a
+		const unsigned char* bytes = (const unsigned char*) value.data();
+		const size_t length = value.length() * sizeof(typename S::value_type);
+		unsigned int hash = 2166136261U;
+
+		for (size_t i = 0; i < length; i++)
+		{
+			hash = (hash ^ bytes[i]) * 16777619U;
+		}
+
+		return hash;
+	}
+
+	static const Entry* find(const Entry* entry, const Entry* end,
+		const S& value, unsigned int hash)
+	{
+		for (; entry != end; entry = entry->next)
+		{
+			if (entry->hash == hash && entry->value == value)
+			{
+				return entry;
+			}
+		}
+
+		return 0;
+	}
+
+	static const S* intern(const S& value)
+	{
+		unsigned int hash = hashValue(value);
+		Entry* volatile* bucket = buckets + (hash % BUCKET_COUNT);
+		Entry* head = *bucket;
+		const Entry* existing = find(head, 0, value, hash);
+
+		if (existing != 0)
+		{
+			return &existing->value;
+		}
+
+		Entry* entry = new Entry(value, hash);
+
+		for (;;)
+		{
+			entry->next = head;
+			Entry* previous = (Entry*) apr_atomic_casptr(
+					(volatile void**) bucket, entry, head);
+
+			if (previous == head)
+			{
+				return &entry->value;
+			}
+
+			//
+			//   only the entries added since the last attempt
+			//      need to be searched again
+			//
+			existing = find(previous, head, value, hash);
+
+			if (existing != 0)
+			{
+				delete entry;
+				return &existing->value;
+			}
+
+			head = previous;
+		}
+	}
+
+	static Entry* volatile buckets[BUCKET_COUNT];
+};
+
+template<class S>
+typename InternTable<S>::Entry* volatile InternTable<S>::buckets[InternTable<S>::BUCKET_COUNT];
+}
+
+const LogString* InternedStrings::intern(const LogString& value)
+{
+	return InternTable<LogString>::intern(value);
+}
+
+const char* InternedStrings::intern(const char* value, size_t length)
+{
+	return InternTable<std::string>::intern(std::string(value, length))->c_str();
+}
@@ -0,0 +1,543 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/helpers/iouringoutputstream.h>
+#include <log4cxx/helpers/bytebuffer.h>
+#include <log4cxx/helpers/exception.h>
+#include <log4cxx/helpers/synchronized.h>
+#include <log4cxx/file.h>
+#include <apr_file_io.h>
+#include <apr_portable.h>
+#include <string.h>
+#include <log4cxx/private/log4cxx_private.h>
+#if LOG4CXX_HAVE_LIBURING && APR_HAS_THREADS
+	#define LOG4CXX_IOURING 1
+	#include <liburing.h>
+	#include <errno.h>
+	#include <sys/uio.h>
+#else
+	#define LOG4CXX_IOURING 0
+#endif
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+
+IMPLEMENT_LOG4CXX_OBJECT(IOUringOutputStream)
+
+namespace
+{
+#if LOG4CXX_IOURING
+bool probe()
+{
+	struct io_uring ring;
+
+	if (io_uring_queue_init(2, &ring, 0) < 0)
+	{
+		return false;
+	}
+
+	io_uring_queue_exit(&ring);
+	return true;
+}
+#endif
+}
+
+bool IOUringOutputStream::isAvailable()
+{
+#if LOG4CXX_IOURING
+	//
+	//   kernels may lack io_uring or have it disabled
+	//
+	static const bool available = probe();
+	return available;
+#else
+	return false;
+#endif
+}
+
+IOUringOutputStream::IOUringOutputStream(const LogString& filename,
+	bool append, size_t segmentSize1, int segmentCount)
+	: pool(), mutex(pool), segmentFree(pool), drained(pool),
+	  fileptr(0), fd(-1), ring(0), registered(false),
+	  segmentSize(segmentSize1 > 0 ? segmentSize1 : 64 * 1024),
+	  memory(), segments(segmentCount > 0 ? segmentCount : 1), freeSegments(),
+	  current(-1), inFlight(0), nextOffset(0), flushPending(false),
+	  unsubmitted(false), error(0), closed(false), reaper()
+{
+#if LOG4CXX_IOURING
+	ring = new struct io_uring;
+	int rc = io_uring_queue_init(2 * segments.size() + 1, ring, 0);
+
+	if (rc < 0)
+	{
+		delete ring;
+		ring = 0;
+		throw IOException(-rc);
+	}
+
+	apr_int32_t flags = APR_WRITE | APR_CREATE;
+
+	if (!append)
+	{
+		flags |= APR_TRUNCATE;
+	}
+
+	File fn;
+	fn.setPath(filename);
+	apr_status_t stat = fn.open(&fileptr, flags, APR_OS_DEFAULT, pool);
+
+	if (stat == APR_SUCCESS)
+	{
+		stat = apr_os_file_get(&fd, fileptr);
+	}
+
+	if (stat == APR_SUCCESS && append)
+	{
+		apr_finfo_t finfo;
+		stat = apr_file_info_get(&finfo, APR_FINFO_SIZE, fileptr);
+		nextOffset = finfo.size;
+	}
+
+	if (stat != APR_SUCCESS)
+	{
+		if (fileptr != 0)
+		{
+			apr_file_close(fileptr);
+			fileptr = 0;
+		}
+
+		io_uring_queue_exit(ring);
+		delete ring;
+		ring = 0;
+		throw IOException(stat);
+	}
+
+	memory.resize(segmentSize * segments.size());
+	std::vector<struct iovec> vecs(segments.size());
+
+	for (size_t i = 0; i < segments.size(); i++)
+	{
+		vecs[i].iov_base = &memory[i * segmentSize];
+		vecs[i].iov_len = segmentSize;
+		freeSegments.push_back((int) (segments.size() - 1 - i));
+	}
+
+	//
+	//   registration fails when the buffers exceed the locked
+	//      memory limit, plain writes still work
+	//
+	registered = io_uring_register_buffers(ring, &vecs[0], vecs.size()) == 0;
+	reaper.run(reap, this);
+#else
+	(void) filename;
+	(void) append;
+	throw IOException(APR_ENOTIMPL);
+#endif
+}
+
+IOUringOutputStream::~IOUringOutputStream()
+{
+	try
+	{
+		stop();
+	}
+	catch (std::exception&)
+	{
+	}
+}
+
+void IOUringOutputStream::close(Pool& /* p */)
+{
+	stop();
+
+	synchronized sync(mutex);
+	checkError();
+}
+
+void IOUringOutputStream::flush(Pool& /* p */)
+{
+	synchronized sync(mutex);
+	checkError();
+
+	if (closed || current < 0)
+	{
+		return;
+	}
+
+	//
+	//   while writes are in flight, let more output collect and
+	//      submit it when they complete
+	//
+	if (inFlight > 0)
+	{
+		flushPending = true;
+	}
+	else
+	{
+		int index = current;
+		current = -1;
+		submit(index);
+	}
+}
+
+void IOUringOutputStream::write(ByteBuffer& buf, Pool& /* p */)
+{
+	synchronized sync(mutex);
+	append(buf.current(), buf.remaining());
+	buf.position(buf.limit());
+}
+
+void IOUringOutputStream::writeAll(const ByteStringList& buffers, Pool& /* p */)
+{
+	synchronized sync(mutex);
+
+	for (ByteStringList::const_iterator iter = buffers.begin();
+		iter != buffers.end();
+		iter++)
+	{
+		append(iter->data(), iter->length());
+	}
+}
+
+/**
+ *  Throws the first error reported by a completion, the caller
+ *  must hold mutex.
+ */
+void IOUringOutputStream::checkError()
+{
+	if (error != 0)
+	{
+		int stat = error;
+		error = 0;
+		throw IOException(stat);
+	}
+}
+
+/**
+ *  Copies data into segments, submitting each that fills, the caller
+ *  must hold mutex.
+ */
+void IOUringOutputStream::append(const char* data, size_t length)
+{
+	while (length > 0)
+	{
+		if (current < 0)
+		{
+			while (freeSegments.empty() && !closed && error == 0)
+			{
+				segmentFree.await(mutex);
+			}
+
+			checkError();
+
+			if (closed)
+			{
+				throw IOException(-1);
+			}
+
+			current = freeSegments.back();
+			freeSegments.pop_back();
+			segments[current].length = 0;
+		}
+
+		Segment& segment = segments[current];
+		size_t count = segmentSize - segment.length;
+
+		if (count > length)
+		{
+			count = length;
+		}
+
+		memcpy(&memory[current * segmentSize + segment.length], data, count);
+		segment.length += count;
+		data += count;
+		length -= count;
+
+		if (segment.length == segmentSize)
+		{
+			int index = current;
+			current = -1;
+			submit(index);
+		}
+	}
+}
+
+/**
+ *  Assigns the segment its place in the file and submits it, the
+ *  caller must hold mutex.
+ */
+void IOUringOutputStream::submit(int index)
+{
+	Segment& segment = segments[index];
+	segment.offset = nextOffset;
+	segment.written = 0;
+	nextOffset += segment.length;
+	inFlight++;
+	queue(index);
+}
+
+/**
+ *  Submits the unwritten part of a segment, the caller must hold mutex.
+ */
+void IOUringOutputStream::queue(int index)
+{
+#if LOG4CXX_IOURING
+	Segment& segment = segments[index];
+	struct io_uring_sqe* sqe = io_uring_get_sqe(ring);
+
+	if (sqe == NULL)
+	{
+		push();
+		sqe = io_uring_get_sqe(ring);
+	}
+
+	if (sqe == NULL)
+	{
+		//
+		//   nothing was placed in the ring, so the segment
+		//      can be released at once
+		//
+		complete(index, -EBUSY);
+		return;
+	}
+
+	char* data = &memory[index * segmentSize] + segment.written;
+	unsigned length = (unsigned) (segment.length - segment.written);
+	log4cxx_int64_t offset = segment.offset + segment.written;
+
+	if (registered)
+	{
+		io_uring_prep_write_fixed(sqe, fd, data, length, offset, index);
+	}
+	else
+	{
+		io_uring_prep_write(sqe, fd, data, length, offset);
+	}
+
+	io_uring_sqe_set_data(sqe, &segment);
+	push();
+#else
+	(void) index;
+#endif
+}
+
+/**
+ *  Passes the entries in the submission ring to the kernel, the
+ *  caller must hold mutex.  An entry stays in the ring when this
+ *  fails and its segment stays in flight until the entry completes,
+ *  so a failure is only remembered and retried by the next push.
+ *  While the kernel lacks the resources to accept entries, mutex is
+ *  released between attempts so that the reaper can free some.
+ */
+void IOUringOutputStream::push()
+{
+#if LOG4CXX_IOURING
+	int rc;
+
+	for (;;)
+	{
+		rc = io_uring_submit(ring);
+
+		if (rc == -EAGAIN)
+		{
+			//
+			//   completing writes release kernel resources,
+			//      retry after the next one or a millisecond
+			//
+			segmentFree.await(mutex, 1000);
+		}
+		else if (rc != -EINTR)
+		{
+			break;
+		}
+	}
+
+	//
+	//   -EBUSY means completions must be reaped first, the reaper
+	//      pushes again after each one
+	//
+	unsubmitted = rc < 0;
+#endif
+}
+
+/**
+ *  Handles the completion of a write, the caller must hold mutex.
+ */
+void IOUringOutputStream::complete(int index, int result)
+{
+#if LOG4CXX_IOURING
+	Segment& segment = segments[index];
+
+	if (result == -EINTR || result == -EAGAIN)
+	{
+		queue(index);
+		return;
+	}
+
+	if (result > 0)
+	{
+		segment.written += result;
+
+		if (segment.written < segment.length)
+		{
+			queue(index);
+			return;
+		}
+	}
+	else if (error == 0)
+	{
+		error = (result < 0) ? -result : EIO;
+	}
+
+	inFlight--;
+	freeSegments.push_back(index);
+	segmentFree.signalAll();
+
+	if (flushPending && inFlight == 0 && current >= 0)
+	{
+		flushPending = false;
+		int next = current;
+		current = -1;
+		submit(next);
+	}
+
+	if (inFlight == 0)
+	{
+		drained.signalAll();
+	}
+
+#else
+	(void) index;
+	(void) result;
+#endif
+}
+
+void IOUringOutputStream::stop()
+{
+#if LOG4CXX_IOURING
+	{
+		synchronized sync(mutex);
+
+		if (closed)
+		{
+			return;
+		}
+
+		if (current >= 0)
+		{
+			int index = current;
+			current = -1;
+			submit(index);
+		}
+
+		if (unsubmitted)
+		{
+			push();
+		}
+
+		while (inFlight > 0)
+		{
+			drained.await(mutex);
+		}
+
+		closed = true;
+		segmentFree.signalAll();
+
+		//
+		//   a write-free completion tells the reaper to exit
+		//
+		struct io_uring_sqe* sqe = io_uring_get_sqe(ring);
+
+		if (sqe != NULL)
+		{
+			io_uring_prep_nop(sqe);
+			io_uring_sqe_set_data(sqe, NULL);
+			push();
+		}
+	}
+
+	reaper.join();
+
+	if (registered)
+	{
+		io_uring_unregister_buffers(ring);
+	}
+
+	io_uring_queue_exit(ring);
+	delete ring;
+	ring = 0;
+	apr_file_close(fileptr);
+	fileptr = 0;
+#endif
+}
+
+void* LOG4CXX_THREAD_FUNC IOUringOutputStream::reap(apr_thread_t* /* thread */, void* data)
+{
+#if LOG4CXX_IOURING
+	IOUringOutputStream* pThis = (IOUringOutputStream*) data;
+
+	for (;;)
+	{
+		struct io_uring_cqe* cqe = NULL;
+		int rc = io_uring_wait_cqe(pThis->ring, &cqe);
+
+		if (rc == -EINTR)
+		{
+			continue;
+		}
+
+		synchronized sync(pThis->mutex);
+
+		if (rc < 0)
+		{
+			//
+			//   nothing more will complete, release any waiters
+			//
+			if (pThis->error == 0)
+			{
+				pThis->error = -rc;
+			}
+
+			pThis->inFlight = 0;
+			pThis->segmentFree.signalAll();
+			pThis->drained.signalAll();
+			break;
+		}
+
+		Segment* segment = (Segment*) io_uring_cqe_get_data(cqe);
+		int result = cqe->res;
+		io_uring_cqe_seen(pThis->ring, cqe);
+
+		if (segment == NULL)
+		{
+			break;
+		}
+
+		pThis->complete((int) (segment - &pThis->segments[0]), result);
+
+		if (pThis->unsubmitted)
+		{
+			pThis->push();
+		}
+	}
+
+#else
+	(void) data;
+#endif
+	return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <log4cxx/logstring.h>
+#include <log4cxx/jsonlayout.h>
+#include <log4cxx/spi/loggingevent.h>
+#include <log4cxx/helpers/optionconverter.h>
+#include <log4cxx/level.h>
+#include <log4cxx/helpers/transform.h>
+#include <log4cxx/helpers/stringhelper.h>
+#include <log4cxx/helpers/transcoder.h>
+
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::spi;
+
+IMPLEMENT_LOG4CXX_OBJECT(JSONLayout)
+
+JSONLayout::JSONLayout()
+	: locationInfo(false), properties(false),
+	  dateFormat()
+{
+	dateFormat.setTimeZone(TimeZone::getGMT());
+}
+
+void JSONLayout::setOption(const LogString& option,
+	const LogString& value)
+{
+	if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("LOCATIONINFO"), LOG4CXX_STR("locationinfo")))
+	{
+		setLocationInfo(OptionConverter::toBoolean(value, false));
+	}
+
+	if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("PROPERTIES"), LOG4CXX_STR("properties")))
+	{
+		setProperties(OptionConverter::toBoolean(value, false));
+	}
+}
+
+void JSONLayout::appendQuoted(LogString& output, const LogString& value)
+{
+	output.append(1, (logchar) 0x22 /* '"' */);
+	Transform::appendEscapingJSON(output, value);
+	output.append(1, (logchar) 0x22 /* '"' */);
+}
+
+void JSONLayout::appendMember(LogString& output, const logchar* name,
+	const LogString& value)
+{
+	output.append(LOG4CXX_STR(",\""));
+	output.append(name);
+	output.append(LOG4CXX_STR("\":"));
+	appendQuoted(output, value);
+}
+
+void JSONLayout::format(LogString& output,
+	const spi::LoggingEventPtr& event,
+	Pool& p) const
+{
+	const LogString& message = event->getRenderedMessage();
+	output.reserve(output.length() + message.length() + 128);
+
+	output.append(LOG4CXX_STR("{\"timestamp\":\""));
+	dateFormat.format(output, event->getTimeStamp(), p);
+	output.append(1, (logchar) 0x22 /* '"' */);
+	appendMember(output, LOG4CXX_STR("level"), event->getLevel()->toString());
+	appendMember(output, LOG4CXX_STR("logger"), event->getLoggerName());
+	appendMember(output, LOG4CXX_STR("thread"), event->getThreadName());
+	appendMember(output, LOG4CXX_STR("message"), message);
+
+	LogString ndc;
+
+	if (event->getNDC(ndc))
+	{
+		appendMember(output, LOG4CXX_STR("ndc"), ndc);
+	}
+
+	if (locationInfo)
+	{
+		const LocationInfo& locInfo = event->getLocationInformation();
+		output.append(LOG4CXX_STR(",\"locationInfo\":{\"class\":"));
+		LOG4CXX_DECODE_CHAR(className, locInfo.getClassName());
+		appendQuoted(output, className);
+		LOG4CXX_DECODE_CHAR(method, locInfo.getMethodName());
+		appendMember(output, LOG4CXX_STR("method"), method);
+		LOG4CXX_DECODE_CHAR(fileName, locInfo.getFileName());
+		appendMember(output, LOG4CXX_STR("file"), fileName);
+		output.append(LOG4CXX_STR(",\"line\":"));
+		StringHelper::toString(locInfo.getLineNumber(), p, output);
+		output.append(1, (logchar) 0x7D /* '}' */);
+	}
+
+	if (properties)
+	{
+		LoggingEvent::KeySet propertySet(event->getPropertyKeySet());
+		LoggingEvent::KeySet keySet(event->getMDCKeySet());
+
+		if (!(keySet.empty() && propertySet.empty()))
+		{
+			output.append(LOG4CXX_STR(",\"properties\":{"));
+			bool first = true;
+
+			for (LoggingEvent::KeySet::const_iterator i = keySet.begin();
+				i != keySet.end();
+				i++)
+			{
+				LogString value;
+
+				if (event->getMDC(*i, value))
+				{
+					if (!first)
+					{
+						output.append(1, (logchar) 0x2C /* ',' */);
+					}
+
+					first = false;
+					appendQuoted(output, *i);
+					output.append(1, (logchar) 0x3A /* ':' */);
+					appendQuoted(output, value);
+				}
+			}
+
+			for (LoggingEvent::KeySet::const_iterator i2 = propertySet.begin();
+				i2 != propertySet.end();
+				i2++)
+			{
+				LogString value;
+
+				if (event->getProperty(*i2, value))
+				{
+					if (!first)
+					{
+						output.append(1, (logchar) 0x2C /* ',' */);
+					}
+
+					first = false;
+					appendQuoted(output, *i2);
+					output.append(1, (logchar) 0x3A /* ':' */);
+					appendQuoted(output, value);
+				}
+			}
+
+			output.append(1, (logchar) 0x7D /* '}' */);
+		}
+	}
+
+	output.append(1, (logchar) 0x7D /* '}' */);
+	output.append(LOG4CXX_EOL);
+}
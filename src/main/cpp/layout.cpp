@@ -40,6 +40,25 @@ LogString Layout::getContentType() const
 	return LOG4CXX_STR("text/plain");
 }
 
+void Layout::formatBytes(std::string& output,
+	const spi::LoggingEventPtr& event,
+	const CharsetEncoderPtr& encoder,
+	Pool& pool) const
+{
+#if LOG4CXX_LOGCHAR_IS_UTF8
+
+	if (encoder->isTrivial())
+	{
+		format(output, event, pool);
+		return;
+	}
+
+#endif
+	LogString text;
+	format(text, event, pool);
+	encoder->encodeAll(text, output);
+}
+
 void Layout::appendHeader(LogString&, log4cxx::helpers::Pool&) {}
 
 void Layout::appendFooter(LogString&, log4cxx::helpers::Pool&) {}
@@ -29,45 +29,59 @@ using namespace log4cxx::helpers;
 
 IMPLEMENT_LOG4CXX_OBJECT_WITH_CUSTOM_CLASS(Level, LevelClass)
 
-LevelPtr Level::getOff()
+//
+//   The built-in levels are interned: each getter hands out a reference
+//   to a single, immutable instance that is constructed on first use
+//   and shared by the whole process, so the LOG4CXX_* macros neither
+//   allocate nor touch a reference count to obtain their level.
+//
+const LevelPtr& Level::getOff()
 {
-	return LevelPtr(new Level(Level::OFF_INT, LOG4CXX_STR("OFF"), 0));
+	static const LevelPtr offLevel(new Level(Level::OFF_INT, LOG4CXX_STR("OFF"), 0));
+	return offLevel;
 }
 
-LevelPtr Level::getFatal()
+const LevelPtr& Level::getFatal()
 {
-	return LevelPtr(new Level(Level::FATAL_INT, LOG4CXX_STR("FATAL"), 0));
+	static const LevelPtr fatalLevel(new Level(Level::FATAL_INT, LOG4CXX_STR("FATAL"), 0));
+	return fatalLevel;
 }
 
-LevelPtr Level::getError()
+const LevelPtr& Level::getError()
 {
-	return LevelPtr(new Level(Level::ERROR_INT, LOG4CXX_STR("ERROR"), 3));
+	static const LevelPtr errorLevel(new Level(Level::ERROR_INT, LOG4CXX_STR("ERROR"), 3));
+	return errorLevel;
 }
 
-LevelPtr Level::getWarn()
+const LevelPtr& Level::getWarn()
 {
-	return LevelPtr(new Level(Level::WARN_INT, LOG4CXX_STR("WARN"), 4));
+	static const LevelPtr warnLevel(new Level(Level::WARN_INT, LOG4CXX_STR("WARN"), 4));
+	return warnLevel;
 }
 
-LevelPtr Level::getInfo()
+const LevelPtr& Level::getInfo()
 {
-	return LevelPtr(new Level(Level::INFO_INT, LOG4CXX_STR("INFO"), 6));
+	static const LevelPtr infoLevel(new Level(Level::INFO_INT, LOG4CXX_STR("INFO"), 6));
+	return infoLevel;
 }
 
-LevelPtr Level::getDebug()
+const LevelPtr& Level::getDebug()
 {
-	return LevelPtr(new Level(Level::DEBUG_INT, LOG4CXX_STR("DEBUG"), 7));
+	static const LevelPtr debugLevel(new Level(Level::DEBUG_INT, LOG4CXX_STR("DEBUG"), 7));
+	return debugLevel;
 }
 
-LevelPtr Level::getTrace()
+const LevelPtr& Level::getTrace()
 {
-	return LevelPtr(new Level(Level::TRACE_INT, LOG4CXX_STR("TRACE"), 7));
+	static const LevelPtr traceLevel(new Level(Level::TRACE_INT, LOG4CXX_STR("TRACE"), 7));
+	return traceLevel;
 }
 
 
-LevelPtr Level::getAll()
+const LevelPtr& Level::getAll()
 {
-	return LevelPtr(new Level(Level::ALL_INT, LOG4CXX_STR("ALL"), 7));
+	static const LevelPtr allLevel(new Level(Level::ALL_INT, LOG4CXX_STR("ALL"), 7));
+	return allLevel;
 }
 
 
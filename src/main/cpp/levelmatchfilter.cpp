@@ -65,7 +65,7 @@ LogString LevelMatchFilter::getLevelToMatch() const
 Filter::FilterDecision LevelMatchFilter::decide(
 	const log4cxx::spi::LoggingEventPtr& event) const
 {
-	if (levelToMatch != 0 && levelToMatch->equals(event->getLevel()))
+	if (levelToMatch != 0 && levelToMatch->toInt() == event->getLevel()->toInt())
 	{
 		if (acceptOnMatch)
 		{
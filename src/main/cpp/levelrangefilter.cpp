@@ -59,13 +59,15 @@ void LevelRangeFilter::setOption(const LogString& option,
 Filter::FilterDecision LevelRangeFilter::decide(
 	const spi::LoggingEventPtr& event) const
 {
-	if (levelMin != 0 && !event->getLevel()->isGreaterOrEqual(levelMin))
+	const int eventLevel = event->getLevel()->toInt();
+
+	if (levelMin != 0 && eventLevel < levelMin->toInt())
 	{
 		// level of event is less than minimum
 		return Filter::DENY;
 	}
 
-	if (levelMax != 0 && event->getLevel()->toInt() > levelMax->toInt())
+	if (levelMax != 0 && eventLevel > levelMax->toInt())
 	{
 		// level of event is greater than maximum
 		// Alas, there is no Level.isGreater method. and using
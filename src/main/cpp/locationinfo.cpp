@@ -104,6 +104,11 @@ const char* LocationInfo::getFileName() const
 	return fileName;
 }
 
+const char* LocationInfo::getFunctionName() const
+{
+	return methodName;
+}
+
 /**
   *   Returns the line number of the caller.
   * @returns line number, -1 if not available.
@@ -29,11 +29,15 @@
 #include <log4cxx/helpers/transcoder.h>
 #include <log4cxx/helpers/appenderattachableimpl.h>
 #include <log4cxx/helpers/exception.h>
+#include <log4cxx/helpers/threadspecificdata.h>
+#include <log4cxx/helpers/internedstrings.h>
 #if !defined(LOG4CXX)
 	#define LOG4CXX 1
 #endif
 #include <log4cxx/private/log4cxx_private.h>
 #include <log4cxx/helpers/aprinitializer.h>
+#include <apr_atomic.h>
+#include <apr_thread_proc.h>
 
 using namespace log4cxx;
 using namespace log4cxx::helpers;
@@ -41,9 +45,79 @@ using namespace log4cxx::spi;
 
 IMPLEMENT_LOG4CXX_OBJECT(Logger)
 
+namespace
+{
+//
+//   Incremented whenever anything that contributes to a logger's
+//   effective threshold changes.  Loggers cache their threshold
+//   together with the generation it was computed in, so the check
+//   made by every logging request is a couple of plain loads.
+//   Zero is older than any generation; the maximum value is never
+//   reached and marks a cache entry that is being rewritten.
+//
+unsigned int volatile levelGeneration = 1;
+const unsigned int REWRITING_GENERATION = 0xFFFFFFFF;
+
+//
+//   Incremented whenever the appenders reached from any logger may
+//   have changed.  Loggers rebuild their appender snapshot when it
+//   was taken in an earlier generation.
+//
+unsigned int volatile appenderGeneration = 1;
+}
+
+/**
+ *  Immutable list of the appenders called for a logger's events.
+ */
+struct Logger::AppenderSnapshot
+{
+	typedef std::vector<Appender*> AppenderVector;
+
+	AppenderSnapshot(unsigned int generation1,
+		const AppenderVector& appenders1) :
+		generation(generation1), appenders(appenders1),
+		released(), epoch(0), next(0)
+	{
+	}
+
+	unsigned int volatile generation;
+
+	/**
+	 *  Appenders to call, kept alive by the loggers they are attached
+	 *  to.  Removing an appender moves the logger's reference to
+	 *  <code>released</code> of a retired snapshot, so that it lives
+	 *  until no request can still be calling it.
+	 */
+	const AppenderVector appenders;
+	AppenderList released;
+
+	/**
+	 *  Reader epoch this snapshot was retired in.
+	 */
+	unsigned int epoch;
+
+	/**
+	 *  Next retired snapshot.
+	 */
+	AppenderSnapshot* next;
+
+	static void deleteList(AppenderSnapshot* snapshot)
+	{
+		while (snapshot != 0)
+		{
+			AppenderSnapshot* next = snapshot->next;
+			delete snapshot;
+			snapshot = next;
+		}
+	}
+};
+
 Logger::Logger(Pool& p, const LogString& name1)
 	: pool(&p), name(), level(), parent(), resourceBundle(),
-	  repository(), aai(), SHARED_MUTEX_INIT(mutex, p)
+	  repository(), aai(), SHARED_MUTEX_INIT(mutex, p),
+	  effectiveThreshold(Level::ALL_INT), thresholdGeneration(0),
+	  appenderSnapshot(0), retiredSnapshots(0),
+	  internedName(InternedStrings::intern(name1))
 {
 	name = name1;
 	additive = true;
@@ -51,6 +125,8 @@ Logger::Logger(Pool& p, const LogString& name1)
 
 Logger::~Logger()
 {
+	delete appenderSnapshot;
+	AppenderSnapshot::deleteList(retiredSnapshots);
 }
 
 void Logger::addRef() const
@@ -77,6 +153,7 @@ void Logger::addAppender(const AppenderPtr& newAppender)
 		aai->addAppender(newAppender);
 		rep = repository;
 	}
+	invalidateAppenders();
 
 	if (rep != 0)
 	{
@@ -86,6 +163,49 @@ void Logger::addAppender(const AppenderPtr& newAppender)
 
 
 void Logger::callAppenders(const spi::LoggingEventPtr& event, Pool& p) const
+{
+	bool empty = false;
+	{
+		//
+		//   a request made from within an appender stays in the
+		//      epoch of the request that called the appender
+		//
+		EpochRead read;
+
+		if (!read.isRecorded())
+		{
+			callAppendersLocked(event, p);
+			return;
+		}
+
+		const AppenderSnapshot* snapshot = appenderSnapshot;
+
+		if (snapshot == 0 || snapshot->generation != appenderGeneration)
+		{
+			snapshot = updateAppenderSnapshot();
+		}
+
+		for (AppenderSnapshot::AppenderVector::const_iterator it = snapshot->appenders.begin();
+			it != snapshot->appenders.end();
+			it++)
+		{
+			(*it)->doAppend(event, p);
+		}
+
+		empty = snapshot->appenders.empty();
+	}
+
+	if (empty && repository != 0)
+	{
+		repository->emitNoAppenderWarning(const_cast<Logger*>(this));
+	}
+}
+
+/**
+ *  Calls the appenders while holding each logger's lock, for a
+ *  thread that has no reader epoch.
+ */
+void Logger::callAppendersLocked(const spi::LoggingEventPtr& event, Pool& p) const
 {
 	int writes = 0;
 
@@ -113,6 +233,141 @@ void Logger::callAppenders(const spi::LoggingEventPtr& event, Pool& p) const
 	}
 }
 
+/**
+ *  Retires a snapshot that is no longer published.
+ *  @return epoch the snapshot was retired in.
+ */
+unsigned int Logger::retireAppenderSnapshot(AppenderSnapshot* snapshot) const
+{
+	LOCK_W sync(mutex);
+	unsigned int epoch = ThreadSpecificData::advanceReaderEpoch();
+	snapshot->epoch = epoch;
+	snapshot->next = retiredSnapshots;
+	retiredSnapshots = snapshot;
+	reclaimAppenderSnapshots();
+	return epoch;
+}
+
+/**
+ *  Deletes the retired snapshots no request can still be reading.
+ *  Must be called with the mutex held.
+ */
+void Logger::reclaimAppenderSnapshots() const
+{
+	unsigned int oldest = ThreadSpecificData::getOldestReaderEpoch(0);
+	AppenderSnapshot** link = &retiredSnapshots;
+
+	while (*link != 0)
+	{
+		AppenderSnapshot* snapshot = *link;
+
+		if (snapshot->epoch <= oldest)
+		{
+			*link = snapshot->next;
+			delete snapshot;
+		}
+		else
+		{
+			link = &snapshot->next;
+		}
+	}
+}
+
+/**
+ *  Holds on to appenders just removed until no other thread can
+ *  still be calling them, so that they may be closed as soon as
+ *  the removal returns.  A request of the current thread that is
+ *  calling an appender keeps them alive until it has left.
+ */
+void Logger::releaseAppenders(const AppenderList& removed) const
+{
+	if (removed.empty())
+	{
+		return;
+	}
+
+	AppenderSnapshot* retired = new AppenderSnapshot(0, AppenderSnapshot::AppenderVector());
+	retired->released = removed;
+	unsigned int epoch = retireAppenderSnapshot(retired);
+	const ReaderEpoch* self = ThreadSpecificData::getReaderEpoch();
+
+	while (ThreadSpecificData::getOldestReaderEpoch(self) < epoch)
+	{
+		apr_thread_yield();
+	}
+
+	LOCK_W sync(mutex);
+	reclaimAppenderSnapshots();
+}
+
+const Logger::AppenderSnapshot* Logger::updateAppenderSnapshot() const
+{
+	//
+	//   read the generation first so that a change made while
+	//      the appenders are collected leaves the snapshot stale
+	unsigned int generation = apr_atomic_read32(&appenderGeneration);
+	AppenderList appenders;
+
+	for (const Logger* logger = this; logger != 0; logger = logger->parent)
+	{
+		// Protected against simultaneous call to addAppender, removeAppender,...
+		LOCK_R sync(logger->mutex);
+
+		if (logger->aai != 0)
+		{
+			AppenderList ancestorAppenders(logger->aai->getAllAppenders());
+			appenders.insert(appenders.end(),
+				ancestorAppenders.begin(), ancestorAppenders.end());
+		}
+
+		if (!logger->additive)
+		{
+			break;
+		}
+	}
+
+	AppenderSnapshot::AppenderVector pointers;
+	pointers.reserve(appenders.size());
+
+	for (AppenderList::const_iterator it = appenders.begin(); it != appenders.end(); it++)
+	{
+		pointers.push_back(*it);
+	}
+
+	AppenderSnapshot* current = appenderSnapshot;
+
+	if (current != 0 && current->appenders == pointers)
+	{
+		unsigned int stamped = current->generation;
+
+		if (stamped < generation)
+		{
+			apr_atomic_cas32(&current->generation, generation, stamped);
+		}
+
+		return current;
+	}
+
+	AppenderSnapshot* replacement = new AppenderSnapshot(generation, pointers);
+
+	if (apr_atomic_casptr((volatile void**) &appenderSnapshot, replacement, current) != current)
+	{
+		//
+		//   another thread published or released first, use the
+		//      unpublished snapshot for this request only
+		//
+		retireAppenderSnapshot(replacement);
+		return replacement;
+	}
+
+	if (current != 0)
+	{
+		retireAppenderSnapshot(current);
+	}
+
+	return replacement;
+}
+
 void Logger::closeNestedAppenders()
 {
 	AppenderList appenders = getAllAppenders();
@@ -127,27 +382,61 @@ void Logger::closeNestedAppenders()
 void Logger::forcedLog(const LevelPtr& level1, const std::string& message,
 	const LocationInfo& location) const
 {
-	Pool p;
+	ScratchPool p;
 	LOG4CXX_DECODE_CHAR(msg, message);
-	LoggingEventPtr event(new LoggingEvent(name, level1, msg, location));
+	LoggingEventPtr event(new LoggingEvent(name, level1, &msg, location, internedName));
+	callAppenders(event, p);
+}
+
+void Logger::forcedLog(const LevelPtr& level1, const char* message, size_t length,
+	const LocationInfo& location) const
+{
+	ScratchPool p;
+#if LOG4CXX_CHARSET_UTF8 && LOG4CXX_LOGCHAR_IS_UTF8
+	LogString msg(message, length);
+#else
+	LOG4CXX_DECODE_CHAR(msg, std::string(message, length));
+#endif
+	LoggingEventPtr event(new LoggingEvent(name, level1, &msg, location, internedName));
+	callAppenders(event, p);
+}
+
+void Logger::forcedLogSwap(const LevelPtr& level1, std::string& message,
+	const LocationInfo& location) const
+{
+	ScratchPool p;
+#if LOG4CXX_CHARSET_UTF8 && LOG4CXX_LOGCHAR_IS_UTF8
+	LoggingEventPtr event(new LoggingEvent(name, level1, &message, location, internedName));
+#else
+	LOG4CXX_DECODE_CHAR(msg, message);
+	LoggingEventPtr event(new LoggingEvent(name, level1, &msg, location, internedName));
+#endif
 	callAppenders(event, p);
 }
 
 
 void Logger::forcedLog(const LevelPtr& level1, const std::string& message) const
 {
-	Pool p;
+	ScratchPool p;
 	LOG4CXX_DECODE_CHAR(msg, message);
-	LoggingEventPtr event(new LoggingEvent(name, level1, msg,
-			LocationInfo::getLocationUnavailable()));
+	LoggingEventPtr event(new LoggingEvent(name, level1, &msg,
+			LocationInfo::getLocationUnavailable(), internedName));
+	callAppenders(event, p);
+}
+
+void Logger::forcedLog(const LevelPtr& level1, const DeferredMessage& message,
+	const LocationInfo& location) const
+{
+	ScratchPool p;
+	LoggingEventPtr event(new LoggingEvent(name, level1, message, location, internedName));
 	callAppenders(event, p);
 }
 
 void Logger::forcedLogLS(const LevelPtr& level1, const LogString& message,
 	const LocationInfo& location) const
 {
-	Pool p;
-	LoggingEventPtr event(new LoggingEvent(name, level1, message, location));
+	ScratchPool p;
+	LoggingEventPtr event(new LoggingEvent(name, level1, message, location, internedName));
 	callAppenders(event, p);
 }
 
@@ -273,73 +562,83 @@ bool Logger::isAttached(const AppenderPtr& appender) const
 
 bool Logger::isTraceEnabled() const
 {
-	if (repository == 0 || repository->isDisabled(Level::TRACE_INT))
-	{
-		return false;
-	}
-
-	return getEffectiveLevel()->toInt() <= Level::TRACE_INT;
+	return isEnabledForLevel(Level::TRACE_INT);
 }
 
 bool Logger::isDebugEnabled() const
 {
-	if (repository == 0 || repository->isDisabled(Level::DEBUG_INT))
+	return isEnabledForLevel(Level::DEBUG_INT);
+}
+
+bool Logger::isEnabledFor(const LevelPtr& level1) const
+{
+	return isEnabledForLevel(level1->toInt());
+}
+
+bool Logger::isEnabledForLevel(int level1) const
+{
+	const unsigned int generation = thresholdGeneration;
+	const int threshold = effectiveThreshold;
+
+	if (generation == levelGeneration)
 	{
-		return false;
+		return level1 >= threshold;
 	}
 
-	return getEffectiveLevel()->toInt() <= Level::DEBUG_INT;
+	return updateEffectiveThreshold(level1);
 }
 
-bool Logger::isEnabledFor(const LevelPtr& level1) const
+bool Logger::updateEffectiveThreshold(int level1) const
 {
-	if (repository == 0 || repository->isDisabled(level1->toInt()))
+	const unsigned int generation = apr_atomic_read32(&levelGeneration);
+
+	if (repository == 0 || repository->isDisabled(level1))
 	{
 		return false;
 	}
 
-	return level1->isGreaterOrEqual(getEffectiveLevel());
-}
+	const int effective = getEffectiveLevel()->toInt();
+	const int repositoryThreshold = repository->getThreshold()->toInt();
+	const int threshold = effective > repositoryThreshold ? effective : repositoryThreshold;
 
+	//
+	//   Only a configured repository may be cached, otherwise the
+	//   next request would skip the default configuration attempt
+	//   made by isDisabled.  An entry is never replaced by one from
+	//   an older generation, and is marked as being rewritten while
+	//   the threshold is stored.
+	//
+	const unsigned int current = thresholdGeneration;
 
-bool Logger::isInfoEnabled() const
-{
-	if (repository == 0 || repository->isDisabled(Level::INFO_INT))
+	if (repository->isConfigured() && current < generation
+		&& apr_atomic_cas32(&thresholdGeneration, REWRITING_GENERATION, current) == current)
 	{
-		return false;
+		effectiveThreshold = threshold;
+		apr_atomic_set32(&thresholdGeneration, generation);
 	}
 
-	return getEffectiveLevel()->toInt() <= Level::INFO_INT;
+	return level1 >= threshold;
 }
 
-bool Logger::isErrorEnabled() const
+
+bool Logger::isInfoEnabled() const
 {
-	if (repository == 0 || repository->isDisabled(Level::ERROR_INT))
-	{
-		return false;
-	}
+	return isEnabledForLevel(Level::INFO_INT);
+}
 
-	return getEffectiveLevel()->toInt() <= Level::ERROR_INT;
+bool Logger::isErrorEnabled() const
+{
+	return isEnabledForLevel(Level::ERROR_INT);
 }
 
 bool Logger::isWarnEnabled() const
 {
-	if (repository == 0 || repository->isDisabled(Level::WARN_INT))
-	{
-		return false;
-	}
-
-	return getEffectiveLevel()->toInt() <= Level::WARN_INT;
+	return isEnabledForLevel(Level::WARN_INT);
 }
 
 bool Logger::isFatalEnabled() const
 {
-	if (repository == 0 || repository->isDisabled(Level::FATAL_INT))
-	{
-		return false;
-	}
-
-	return getEffectiveLevel()->toInt() <= Level::FATAL_INT;
+	return isEnabledForLevel(Level::FATAL_INT);
 }
 
 /*void Logger::l7dlog(const LevelPtr& level, const String& key,
@@ -370,12 +669,7 @@ bool Logger::isFatalEnabled() const
 void Logger::l7dlog(const LevelPtr& level1, const LogString& key,
 	const LocationInfo& location, const std::vector<LogString>& params) const
 {
-	if (repository == 0 || repository->isDisabled(level1->toInt()))
-	{
-		return;
-	}
-
-	if (level1->isGreaterOrEqual(getEffectiveLevel()))
+	if (isEnabledForLevel(level1->toInt()))
 	{
 		LogString pattern = getResourceBundleString(key);
 		LogString msg;
@@ -447,43 +741,68 @@ void Logger::l7dlog(const LevelPtr& level1, const std::string& key,
 
 void Logger::removeAllAppenders()
 {
-	LOCK_W sync(mutex);
-
-	if (aai != 0)
+	AppenderList removed;
 	{
+		LOCK_W sync(mutex);
+
+		if (aai == 0)
+		{
+			return;
+		}
+
+		removed = aai->getAllAppenders();
 		aai->removeAllAppenders();
 		aai = 0;
 	}
+	invalidateAppenders();
+	releaseAppenders(removed);
 }
 
 void Logger::removeAppender(const AppenderPtr& appender)
 {
-	LOCK_W sync(mutex);
-
-	if (appender == 0 || aai == 0)
 	{
-		return;
-	}
+		LOCK_W sync(mutex);
 
-	aai->removeAppender(appender);
+		if (appender == 0 || aai == 0)
+		{
+			return;
+		}
+
+		aai->removeAppender(appender);
+	}
+	invalidateAppenders();
+	releaseAppenders(AppenderList(1, appender));
 }
 
 void Logger::removeAppender(const LogString& name1)
 {
-	LOCK_W sync(mutex);
-
-	if (name1.empty() || aai == 0)
+	AppenderPtr removed;
 	{
-		return;
+		LOCK_W sync(mutex);
+
+		if (name1.empty() || aai == 0)
+		{
+			return;
+		}
+
+		removed = aai->getAppender(name1);
+		aai->removeAppender(name1);
 	}
+	invalidateAppenders();
 
-	aai->removeAppender(name1);
+	if (removed != 0)
+	{
+		releaseAppenders(AppenderList(1, removed));
+	}
 }
 
 void Logger::setAdditivity(bool additive1)
 {
-	LOCK_W sync(mutex);
-	this->additive = additive1;
+	{
+		LOCK_W sync(mutex);
+		this->additive = additive1;
+	}
+	invalidateAppenders();
 }
 
 void Logger::setHierarchy(spi::LoggerRepository* repository1)
@@ -494,6 +813,17 @@ void Logger::setHierarchy(spi::LoggerRepository* repository1)
 void Logger::setLevel(const LevelPtr& level1)
 {
 	this->level = level1;
+	invalidateEffectiveLevels();
+}
+
+void Logger::invalidateEffectiveLevels()
+{
+	apr_atomic_inc32(&levelGeneration);
+}
+
+void Logger::invalidateAppenders()
+{
+	apr_atomic_inc32(&appenderGeneration);
 }
 
 
@@ -665,18 +995,32 @@ LoggerPtr Logger::getLoggerLS(const LogString& name)
 void Logger::forcedLog(const LevelPtr& level1, const std::wstring& message,
 	const LocationInfo& location) const
 {
-	Pool p;
+	ScratchPool p;
 	LOG4CXX_DECODE_WCHAR(msg, message);
-	LoggingEventPtr event(new LoggingEvent(name, level1, msg, location));
+	LoggingEventPtr event(new LoggingEvent(name, level1, msg, location, internedName));
+	callAppenders(event, p);
+}
+
+void Logger::forcedLogSwap(const LevelPtr& level1, std::wstring& message,
+	const LocationInfo& location) const
+{
+	ScratchPool p;
+#if LOG4CXX_LOGCHAR_IS_WCHAR
+	LoggingEventPtr event(new LoggingEvent(name, level1, &message, location, internedName));
+#else
+	LogString msg;
+	Transcoder::decode(message, msg);
+	LoggingEventPtr event(new LoggingEvent(name, level1, &msg, location, internedName));
+#endif
 	callAppenders(event, p);
 }
 
 void Logger::forcedLog(const LevelPtr& level1, const std::wstring& message) const
 {
-	Pool p;
+	ScratchPool p;
 	LOG4CXX_DECODE_WCHAR(msg, message);
 	LoggingEventPtr event(new LoggingEvent(name, level1, msg,
-			LocationInfo::getLocationUnavailable()));
+			LocationInfo::getLocationUnavailable(), internedName));
 	callAppenders(event, p);
 }
 
@@ -816,18 +1160,32 @@ void Logger::warn(const std::wstring& msg) const
 void Logger::forcedLog(const LevelPtr& level1, const std::basic_string<UniChar>& message,
 	const LocationInfo& location) const
 {
-	Pool p;
+	ScratchPool p;
 	LOG4CXX_DECODE_UNICHAR(msg, message);
-	LoggingEventPtr event(new LoggingEvent(name, level1, msg, location));
+	LoggingEventPtr event(new LoggingEvent(name, level1, msg, location, internedName));
+	callAppenders(event, p);
+}
+
+void Logger::forcedLogSwap(const LevelPtr& level1, std::basic_string<UniChar>& message,
+	const LocationInfo& location) const
+{
+	ScratchPool p;
+#if LOG4CXX_LOGCHAR_IS_UNICHAR
+	LoggingEventPtr event(new LoggingEvent(name, level1, &message, location, internedName));
+#else
+	LogString msg;
+	Transcoder::decode(message, msg);
+	LoggingEventPtr event(new LoggingEvent(name, level1, &msg, location, internedName));
+#endif
 	callAppenders(event, p);
 }
 
 void Logger::forcedLog(const LevelPtr& level1, const std::basic_string<UniChar>& message) const
 {
-	Pool p;
+	ScratchPool p;
 	LOG4CXX_DECODE_UNICHAR(msg, message);
 	LoggingEventPtr event(new LoggingEvent(name, level1, msg,
-			LocationInfo::getLocationUnavailable()));
+			LocationInfo::getLocationUnavailable(), internedName));
 	callAppenders(event, p);
 }
 #endif
@@ -964,18 +1322,18 @@ void Logger::warn(const std::basic_string<UniChar>& msg) const
 void Logger::forcedLog(const LevelPtr& level1, const CFStringRef& message,
 	const LocationInfo& location) const
 {
-	Pool p;
+	ScratchPool p;
 	LOG4CXX_DECODE_CFSTRING(msg, message);
-	LoggingEventPtr event(new LoggingEvent(name, level1, msg, location));
+	LoggingEventPtr event(new LoggingEvent(name, level1, msg, location, internedName));
 	callAppenders(event, p);
 }
 
 void Logger::forcedLog(const LevelPtr& level1, const CFStringRef& message) const
 {
-	Pool p;
+	ScratchPool p;
 	LOG4CXX_DECODE_CFSTRING(msg, message);
 	LoggingEventPtr event(new LoggingEvent(name, level1, msg,
-			LocationInfo::getLocationUnavailable()));
+			LocationInfo::getLocationUnavailable(), internedName));
 	callAppenders(event, p);
 }
 
@@ -54,7 +54,31 @@ void LoggerPatternConverter::format(
 	LogString& toAppendTo,
 	Pool& /* p */ ) const
 {
+	const LogString& name = event->getLoggerName();
+
+	if (!isAbbreviating())
+	{
+		toAppendTo.append(name);
+		return;
+	}
+
+	//
+	//   loggers are few, abbreviate each name once,
+	//      keyed by the address of the interned name
+	//
+	const LogString* interned = event->getInternedLoggerName();
+
+	if (interned != 0 && appendCached(interned, toAppendTo))
+	{
+		return;
+	}
+
 	int initialLength = toAppendTo.length();
-	toAppendTo.append(event->getLoggerName());
+	toAppendTo.append(name);
 	abbreviate(initialLength, toAppendTo);
+
+	if (interned != 0)
+	{
+		addCached(interned, toAppendTo.substr(initialLength));
+	}
 }
@@ -28,10 +28,13 @@
 #include <log4cxx/helpers/aprinitializer.h>
 #include <log4cxx/helpers/threadspecificdata.h>
 #include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/helpers/deferredmessage.h>
 
 #include <apr_time.h>
 #include <apr_portable.h>
 #include <apr_strings.h>
+#include <apr_atomic.h>
+#include <apr_thread_proc.h>
 #include <log4cxx/helpers/stringhelper.h>
 #include <log4cxx/helpers/objectoutputstream.h>
 #include <log4cxx/helpers/bytebuffer.h>
@@ -54,20 +57,26 @@ log4cxx_time_t LoggingEvent::getStartTime()
 }
 
 LoggingEvent::LoggingEvent() :
+	internedLogger(0),
 	ndc(0),
 	mdcCopy(0),
 	properties(0),
 	ndcLookupRequired(true),
 	mdcCopyLookupRequired(true),
+	deferredMessage(0),
+	messageState(MESSAGE_RENDERED),
 	timeStamp(0),
-	locationInfo()
+	locationInfo(),
+	threadName(new ThreadName())
 {
 }
 
 LoggingEvent::LoggingEvent(
 	const LogString& logger1, const LevelPtr& level1,
-	const LogString& message1, const LocationInfo& locationInfo1) :
+	const LogString& message1, const LocationInfo& locationInfo1,
+	const LogString* internedLogger1) :
 	logger(logger1),
+	internedLogger(internedLogger1),
 	level(level1),
 	ndc(0),
 	mdcCopy(0),
@@ -75,9 +84,76 @@ LoggingEvent::LoggingEvent(
 	ndcLookupRequired(true),
 	mdcCopyLookupRequired(true),
 	message(message1),
+	deferredMessage(0),
+	messageState(MESSAGE_RENDERED),
 	timeStamp(apr_time_now()),
 	locationInfo(locationInfo1),
-	threadName(getCurrentThreadName())
+	threadName(ThreadName::getCurrentThreadName())
+{
+}
+
+LoggingEvent::LoggingEvent(
+	const LogString& logger1, const LevelPtr& level1,
+	LogString* message1, const LocationInfo& locationInfo1,
+	const LogString* internedLogger1) :
+	logger(logger1),
+	internedLogger(internedLogger1),
+	level(level1),
+	ndc(0),
+	mdcCopy(0),
+	properties(0),
+	ndcLookupRequired(true),
+	mdcCopyLookupRequired(true),
+	message(),
+	deferredMessage(0),
+	messageState(MESSAGE_RENDERED),
+	timeStamp(apr_time_now()),
+	locationInfo(locationInfo1),
+	threadName(ThreadName::getCurrentThreadName())
+{
+	message.swap(*message1);
+}
+
+LoggingEvent::LoggingEvent(
+	const LogString& logger1, const LevelPtr& level1,
+	const DeferredMessage& message1, const LocationInfo& locationInfo1,
+	const LogString* internedLogger1) :
+	logger(logger1),
+	internedLogger(internedLogger1),
+	level(level1),
+	ndc(0),
+	mdcCopy(0),
+	properties(0),
+	ndcLookupRequired(true),
+	mdcCopyLookupRequired(true),
+	message(),
+	deferredMessage(message1),
+	messageState(MESSAGE_DEFERRED),
+	timeStamp(apr_time_now()),
+	locationInfo(locationInfo1),
+	threadName(ThreadName::getCurrentThreadName())
+{
+}
+
+LoggingEvent::LoggingEvent(log4cxx_time_t timeStamp1,
+	const LogString& logger1, const LevelPtr& level1,
+	const LogString& message1, const ThreadNamePtr& threadName1,
+	const LogString* ndc1, const MDC::Map& mdc1,
+	const LocationInfo& locationInfo1) :
+	logger(logger1),
+	internedLogger(0),
+	level(level1),
+	ndc(ndc1 == 0 ? 0 : new LogString(*ndc1)),
+	mdcCopy(new MDC::Map(mdc1)),
+	properties(0),
+	ndcLookupRequired(false),
+	mdcCopyLookupRequired(false),
+	message(message1),
+	deferredMessage(0),
+	messageState(MESSAGE_RENDERED),
+	timeStamp(timeStamp1),
+	locationInfo(locationInfo1),
+	threadName(threadName1)
 {
 }
 
@@ -88,6 +164,45 @@ LoggingEvent::~LoggingEvent()
 	delete properties;
 }
 
+void LoggingEvent::renderMessage() const
+{
+	apr_uint32_t volatile* state = (apr_uint32_t volatile*) &messageState;
+
+	if (apr_atomic_cas32(state, MESSAGE_RENDERING, MESSAGE_DEFERRED) == MESSAGE_DEFERRED)
+	{
+		try
+		{
+			deferredMessage.render(message);
+		}
+		catch (std::exception&)
+		{
+		}
+
+		deferredMessage.clear();
+		apr_atomic_xchg32(state, MESSAGE_RENDERED);
+		return;
+	}
+
+	//
+	//   another thread, the dispatcher of an AsyncAppender for
+	//   instance, is rendering the message
+	//
+	while (apr_atomic_read32(state) != MESSAGE_RENDERED)
+	{
+		apr_thread_yield();
+	}
+}
+
+void* LoggingEvent::operator new(size_t size)
+{
+	return ThreadSpecificData::allocateEvent(size);
+}
+
+void LoggingEvent::operator delete(void* ptr, size_t)
+{
+	ThreadSpecificData::releaseEvent(ptr);
+}
+
 bool LoggingEvent::getNDC(LogString& dest) const
 {
 	if (ndcLookupRequired)
@@ -219,28 +334,6 @@ LoggingEvent::KeySet LoggingEvent::getPropertyKeySet() const
 }
 
 
-const LogString LoggingEvent::getCurrentThreadName()
-{
-#if APR_HAS_THREADS
-#if defined(_WIN32)
-	char result[20];
-	DWORD threadId = GetCurrentThreadId();
-	apr_snprintf(result, sizeof(result), LOG4CXX_WIN32_THREAD_FMTSPEC, threadId);
-#else
-	// apr_os_thread_t encoded in HEX takes needs as many characters
-	// as two times the size of the type, plus an additional null byte.
-	char result[sizeof(apr_os_thread_t) * 3 + 10];
-	apr_os_thread_t threadId = apr_os_thread_current();
-	apr_snprintf(result, sizeof(result), LOG4CXX_APR_THREAD_FMTSPEC, (void*) &threadId);
-#endif
-	LOG4CXX_DECODE_CHAR(str, (const char*) result);
-	return str;
-#else
-	return LOG4CXX_STR("0x00000000");
-#endif
-}
-
-
 void LoggingEvent::setProperty(const LogString& key, const LogString& value)
 {
 	if (properties == 0)
@@ -344,8 +437,8 @@ void LoggingEvent::write(helpers::ObjectOutputStream& os, Pool& p) const
 		os.writeObject(*ndc, p);
 	}
 
-	os.writeObject(message, p);
-	os.writeObject(threadName, p);
+	os.writeObject(getRenderedMessage(), p);
+	os.writeObject(threadName->getName(), p);
 	//  throwable
 	os.writeNull(p);
 	os.writeByte(ObjectOutputStream::TC_BLOCKDATA, p);
@@ -0,0 +1,315 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/helpers/mappedfileoutputstream.h>
+#include <log4cxx/helpers/exception.h>
+#include <log4cxx/helpers/bytebuffer.h>
+#include <log4cxx/file.h>
+#include <apr_file_io.h>
+#include <apr_mmap.h>
+#include <apr_portable.h>
+#include <apr_time.h>
+#include <string.h>
+#include <log4cxx/private/log4cxx_private.h>
+#if defined(_WIN32)
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#if LOG4CXX_HAS_POSIX_FALLOCATE
+		#include <fcntl.h>
+	#endif
+#endif
+#if !defined(LOG4CXX)
+	#define LOG4CXX 1
+#endif
+#include <log4cxx/helpers/aprinitializer.h>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+
+IMPLEMENT_LOG4CXX_OBJECT(MappedFileOutputStream)
+
+namespace
+{
+/**
+ *  Mapping offsets must be a multiple of the page size, and on
+ *  Windows of the allocation granularity, which this covers.
+ */
+const size_t MAP_ALIGNMENT = 64 * 1024;
+
+/**
+ *  Starts, or with wait completes, writing back part of a mapping.
+ */
+bool flushView(void* addr, size_t length, bool wait)
+{
+#if defined(_WIN32)
+	return FlushViewOfFile(addr, length) != 0;
+#else
+	return msync(addr, length, wait ? MS_SYNC : MS_ASYNC) == 0;
+#endif
+}
+}
+
+MappedFileOutputStream::MappedFileOutputStream(const LogString& filename,
+	bool append, size_t chunkSize1, int syncInterval1)
+	: pool(), fileptr(0), mapping(0), mapOffset(0), position(0),
+	  allocated(0), chunkSize(chunkSize1), syncInterval(syncInterval1),
+	  lastSync(apr_time_now())
+{
+	chunkSize = (chunkSize + MAP_ALIGNMENT - 1) / MAP_ALIGNMENT * MAP_ALIGNMENT;
+
+	if (chunkSize == 0)
+	{
+		chunkSize = MAP_ALIGNMENT;
+	}
+
+	apr_int32_t flags = APR_READ | APR_WRITE | APR_CREATE;
+
+	if (!append)
+	{
+		flags |= APR_TRUNCATE;
+	}
+
+	File fn;
+	fn.setPath(filename);
+	apr_status_t stat = fn.open(&fileptr, flags, APR_OS_DEFAULT, pool);
+
+	if (stat != APR_SUCCESS)
+	{
+		throw IOException(stat);
+	}
+
+	apr_finfo_t finfo;
+	stat = apr_file_info_get(&finfo, APR_FINFO_SIZE, fileptr);
+
+	if (stat == APR_SUCCESS)
+	{
+		allocated = finfo.size;
+	}
+
+	//
+	//   map from the aligned offset at or before the end of
+	//     any existing content
+	//
+	log4cxx_int64_t end = allocated;
+
+	try
+	{
+		map(end - end % MAP_ALIGNMENT);
+	}
+	catch (IOException&)
+	{
+		apr_file_close(fileptr);
+		fileptr = 0;
+		throw;
+	}
+
+	position = (size_t) (end % MAP_ALIGNMENT);
+}
+
+MappedFileOutputStream::~MappedFileOutputStream()
+{
+	if (fileptr != NULL && !APRInitializer::isDestructed)
+	{
+		try
+		{
+			Pool p;
+			close(p);
+		}
+		catch (IOException&)
+		{
+		}
+	}
+}
+
+void MappedFileOutputStream::close(Pool& /* p */)
+{
+	if (fileptr != NULL)
+	{
+		log4cxx_int64_t length = mapOffset + position;
+		unmap(syncInterval > 0);
+		apr_status_t stat = apr_file_trunc(fileptr, length);
+		apr_status_t closeStat = apr_file_close(fileptr);
+		fileptr = NULL;
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(stat);
+		}
+
+		if (closeStat != APR_SUCCESS)
+		{
+			throw IOException(closeStat);
+		}
+	}
+}
+
+void MappedFileOutputStream::flush(Pool& p)
+{
+	if (syncInterval > 0 && fileptr != NULL)
+	{
+		log4cxx_time_t now = apr_time_now();
+
+		if (now - lastSync >= (log4cxx_time_t) syncInterval * 1000)
+		{
+			sync(p);
+		}
+	}
+}
+
+void MappedFileOutputStream::sync(Pool& /* p */)
+{
+	if (fileptr == NULL)
+	{
+		throw IOException(-1);
+	}
+
+	if (position > 0 && !flushView(mapping->mm, position, true))
+	{
+		throw IOException(apr_get_os_error());
+	}
+
+#if defined(_WIN32)
+	//
+	//   FlushViewOfFile does not wait for the device
+	//
+	apr_os_file_t handle;
+
+	if (apr_os_file_get(&handle, fileptr) == APR_SUCCESS)
+	{
+		FlushFileBuffers(handle);
+	}
+
+#endif
+	lastSync = apr_time_now();
+}
+
+void MappedFileOutputStream::write(ByteBuffer& buf, Pool& /* p */)
+{
+	append(buf.current(), buf.remaining());
+	buf.position(buf.limit());
+}
+
+void MappedFileOutputStream::writeAll(const ByteStringList& buffers, Pool& /* p */)
+{
+	for (ByteStringList::const_iterator iter = buffers.begin();
+		iter != buffers.end();
+		iter++)
+	{
+		append(iter->data(), iter->length());
+	}
+}
+
+void MappedFileOutputStream::append(const char* data, size_t length)
+{
+	if (fileptr == NULL)
+	{
+		throw IOException(-1);
+	}
+
+	while (length > 0)
+	{
+		if (position == chunkSize)
+		{
+			map(mapOffset + chunkSize);
+		}
+
+		size_t count = chunkSize - position;
+
+		if (count > length)
+		{
+			count = length;
+		}
+
+		memcpy((char*) mapping->mm + position, data, count);
+		position += count;
+		data += count;
+		length -= count;
+	}
+}
+
+/**
+ *  Replaces the current mapping with one of chunkSize bytes
+ *  at offset, extending the file as needed.
+ */
+void MappedFileOutputStream::map(log4cxx_int64_t offset)
+{
+	unmap(false);
+	preallocate(offset + chunkSize);
+	apr_status_t stat = apr_mmap_create(&mapping, fileptr, offset,
+			chunkSize, APR_MMAP_READ | APR_MMAP_WRITE, pool.getAPRPool());
+
+	if (stat != APR_SUCCESS)
+	{
+		mapping = NULL;
+		throw IOException(stat);
+	}
+
+	mapOffset = offset;
+	position = 0;
+}
+
+void MappedFileOutputStream::unmap(bool wait)
+{
+	if (mapping != NULL)
+	{
+		//
+		//   a full chunk is left to the system unless syncs were
+		//     requested, in which case its writeback is started
+		//
+		if (syncInterval > 0 && position > 0)
+		{
+			flushView(mapping->mm, position, wait);
+		}
+
+		apr_mmap_delete(mapping);
+		mapping = NULL;
+	}
+}
+
+void MappedFileOutputStream::preallocate(log4cxx_int64_t length)
+{
+	if (length <= allocated)
+	{
+		return;
+	}
+
+#if LOG4CXX_HAS_POSIX_FALLOCATE
+	//
+	//   reserve the blocks so that a full disk is reported here
+	//      rather than as a fault on writing to the mapping
+	//
+	apr_os_file_t fd;
+
+	if (apr_os_file_get(&fd, fileptr) == APR_SUCCESS
+		&& posix_fallocate(fd, allocated, length - allocated) == 0)
+	{
+		allocated = length;
+		return;
+	}
+
+#endif
+	apr_status_t stat = apr_file_trunc(fileptr, length);
+
+	if (stat != APR_SUCCESS)
+	{
+		throw IOException(stat);
+	}
+
+	allocated = length;
+}
@@ -145,7 +145,8 @@ CharMessageBuffer::operator std::basic_ostream<char>& ()
 
 const std::basic_string<char>& CharMessageBuffer::str(std::basic_ostream<char>&)
 {
-	buf = stream->str();
+	std::basic_string<char> content(stream->str());
+	buf.swap(content);
 
 	ResetStream(*stream);
 
@@ -157,6 +158,17 @@ const std::basic_string<char>& CharMessageBuffer::str(CharMessageBuffer&)
 	return buf;
 }
 
+std::basic_string<char>& CharMessageBuffer::extract(std::basic_ostream<char>& os)
+{
+	str(os);
+	return buf;
+}
+
+std::basic_string<char>& CharMessageBuffer::extract(CharMessageBuffer&)
+{
+	return buf;
+}
+
 bool CharMessageBuffer::hasStream() const
 {
 	return (stream != 0);
@@ -317,7 +329,8 @@ WideMessageBuffer::operator std::basic_ostream<wchar_t>& ()
 
 const std::basic_string<wchar_t>& WideMessageBuffer::str(std::basic_ostream<wchar_t>&)
 {
-	buf = stream->str();
+	std::basic_string<wchar_t> content(stream->str());
+	buf.swap(content);
 
 	ResetStream(*stream);
 
@@ -329,6 +342,17 @@ const std::basic_string<wchar_t>& WideMessageBuffer::str(WideMessageBuffer&)
 	return buf;
 }
 
+std::basic_string<wchar_t>& WideMessageBuffer::extract(std::basic_ostream<wchar_t>& os)
+{
+	str(os);
+	return buf;
+}
+
+std::basic_string<wchar_t>& WideMessageBuffer::extract(WideMessageBuffer&)
+{
+	return buf;
+}
+
 bool WideMessageBuffer::hasStream() const
 {
 	return (stream != 0);
@@ -448,6 +472,16 @@ const std::string& MessageBuffer::str(std::ostream& os)
 	return cbuf.str(os);
 }
 
+std::string& MessageBuffer::extract(CharMessageBuffer& buf)
+{
+	return cbuf.extract(buf);
+}
+
+std::string& MessageBuffer::extract(std::ostream& os)
+{
+	return cbuf.extract(os);
+}
+
 WideMessageBuffer& MessageBuffer::operator<<(const std::wstring& msg)
 {
 	wbuf = new WideMessageBuffer();
@@ -481,6 +515,16 @@ const std::wstring& MessageBuffer::str(std::basic_ostream<wchar_t>& os)
 	return wbuf->str(os);
 }
 
+std::wstring& MessageBuffer::extract(WideMessageBuffer& buf)
+{
+	return wbuf->extract(buf);
+}
+
+std::wstring& MessageBuffer::extract(std::basic_ostream<wchar_t>& os)
+{
+	return wbuf->extract(os);
+}
+
 std::ostream& MessageBuffer::operator<<(bool val)
 {
 	return cbuf.operator << (val);
@@ -560,6 +604,16 @@ const std::basic_string<log4cxx::UniChar>& MessageBuffer::str(std::basic_ostream
 	return ubuf->str(os);
 }
 
+std::basic_string<log4cxx::UniChar>& MessageBuffer::extract(UniCharMessageBuffer& buf)
+{
+	return ubuf->extract(buf);
+}
+
+std::basic_string<log4cxx::UniChar>& MessageBuffer::extract(std::basic_ostream<log4cxx::UniChar>& os)
+{
+	return ubuf->extract(os);
+}
+
 
 UniCharMessageBuffer::UniCharMessageBuffer() : stream(0)
 {
@@ -667,7 +721,8 @@ UniCharMessageBuffer::operator UniCharMessageBuffer::uostream& ()
 
 const std::basic_string<log4cxx::UniChar>& UniCharMessageBuffer::str(UniCharMessageBuffer::uostream&)
 {
-	buf = stream->str();
+	std::basic_string<log4cxx::UniChar> content(stream->str());
+	buf.swap(content);
 	ResetStream(*stream);
 	return buf;
 }
@@ -677,6 +732,17 @@ const std::basic_string<log4cxx::UniChar>& UniCharMessageBuffer::str(UniCharMess
 	return buf;
 }
 
+std::basic_string<log4cxx::UniChar>& UniCharMessageBuffer::extract(UniCharMessageBuffer::uostream& os)
+{
+	str(os);
+	return buf;
+}
+
+std::basic_string<log4cxx::UniChar>& UniCharMessageBuffer::extract(UniCharMessageBuffer&)
+{
+	return buf;
+}
+
 bool UniCharMessageBuffer::hasStream() const
 {
 	return (stream != 0);
@@ -23,6 +23,7 @@
 #include <log4cxx/pattern/namepatternconverter.h>
 #include <log4cxx/pattern/nameabbreviator.h>
 #include <log4cxx/spi/loggingevent.h>
+#include <apr_atomic.h>
 
 using namespace log4cxx;
 using namespace log4cxx::pattern;
@@ -30,13 +31,113 @@ using namespace log4cxx::spi;
 
 IMPLEMENT_LOG4CXX_OBJECT(NamePatternConverter)
 
+/**
+ *  Abbreviations by the address of a name that lives for the rest of
+ *  the process, so a lookup neither hashes nor compares the name.
+ *  Entries are only ever added, with a compare-and-swap on the bucket
+ *  head, and are deleted with the converter, so readers need no lock.
+ */
+struct NamePatternConverter::Cache
+{
+	enum
+	{
+		BUCKET_COUNT = 256,
+		MAXIMUM_SIZE = 1024
+	};
+
+	struct Entry
+	{
+		Entry(const void* key1, const LogString& abbreviated1) :
+			key(key1), abbreviated(abbreviated1), next(0)
+		{
+		}
+
+		const void* const key;
+		const LogString abbreviated;
+		Entry* next;
+	};
+
+	Cache() : size(0)
+	{
+		for (int i = 0; i < BUCKET_COUNT; i++)
+		{
+			buckets[i] = 0;
+		}
+	}
+
+	~Cache()
+	{
+		for (int i = 0; i < BUCKET_COUNT; i++)
+		{
+			Entry* entry = buckets[i];
+
+			while (entry != 0)
+			{
+				Entry* next = entry->next;
+				delete entry;
+				entry = next;
+			}
+		}
+	}
+
+	static size_t getBucket(const void* key)
+	{
+		return ((size_t) key / sizeof(void*)) % BUCKET_COUNT;
+	}
+
+	const Entry* find(const void* key) const
+	{
+		for (const Entry* entry = buckets[getBucket(key)]; entry != 0; entry = entry->next)
+		{
+			if (entry->key == key)
+			{
+				return entry;
+			}
+		}
+
+		return 0;
+	}
+
+	void add(const void* key, const LogString& abbreviated)
+	{
+		if (apr_atomic_inc32(&size) >= MAXIMUM_SIZE)
+		{
+			apr_atomic_dec32(&size);
+			return;
+		}
+
+		Entry* entry = new Entry(key, abbreviated);
+		Entry* volatile* bucket = buckets + getBucket(key);
+
+		for (;;)
+		{
+			Entry* head = *bucket;
+			entry->next = head;
+
+			if (apr_atomic_casptr((volatile void**) bucket, entry, head) == head)
+			{
+				break;
+			}
+		}
+	}
+
+	Entry* volatile buckets[BUCKET_COUNT];
+	volatile apr_uint32_t size;
+};
+
 NamePatternConverter::NamePatternConverter(
 	const LogString& name1,
 	const LogString& style1,
 	const std::vector<LogString>& options) :
 	LoggingEventPatternConverter(name1, style1),
-	abbreviator(getAbbreviator(options))
+	abbreviator(getAbbreviator(options)),
+	cache(isAbbreviating() ? new Cache() : 0)
+{
+}
+
+NamePatternConverter::~NamePatternConverter()
 {
+	delete cache;
 }
 
 NameAbbreviatorPtr NamePatternConverter::getAbbreviator(
@@ -59,3 +160,35 @@ void NamePatternConverter::abbreviate(int nameStart, LogString& buf) const
 {
 	abbreviator->abbreviate(nameStart, buf);
 }
+
+bool NamePatternConverter::appendCached(const void* key, LogString& buf) const
+{
+	if (cache == 0)
+	{
+		return false;
+	}
+
+	const Cache::Entry* entry = cache->find(key);
+
+	if (entry != 0)
+	{
+		buf.append(entry->abbreviated);
+		return true;
+	}
+
+	return false;
+}
+
+void NamePatternConverter::addCached(const void* key,
+	const LogString& abbreviated) const
+{
+	if (cache != 0)
+	{
+		cache->add(key, abbreviated);
+	}
+}
+
+bool NamePatternConverter::isAbbreviating() const
+{
+	return abbreviator != NameAbbreviator::getDefaultAbbreviator();
+}
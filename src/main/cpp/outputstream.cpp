@@ -17,6 +17,7 @@
 
 #include <log4cxx/logstring.h>
 #include <log4cxx/helpers/outputstream.h>
+#include <log4cxx/helpers/bytebuffer.h>
 #include <stdexcept>
 
 using namespace log4cxx;
@@ -32,6 +33,20 @@ OutputStream::~OutputStream()
 {
 }
 
+void OutputStream::writeAll(const ByteStringList& buffers, Pool& p)
+{
+	for (ByteStringList::const_iterator iter = buffers.begin();
+		iter != buffers.end();
+		iter++)
+	{
+		if (!iter->empty())
+		{
+			ByteBuffer buf(const_cast<char*>(iter->data()), iter->length());
+			write(buf, p);
+		}
+	}
+}
+
 #ifdef LOG4CXX_MULTI_PROCESS
 apr_file_t* OutputStream::getFilePtr()
 {
@@ -69,33 +69,23 @@ void OutputStreamWriter::write(const LogString& str, Pool& p)
 {
 	if (str.length() > 0)
 	{
-#ifdef LOG4CXX_MULTI_PROCESS
-		size_t bufSize = str.length() * 2;
-		char* rawbuf = new char[bufSize];
-		ByteBuffer buf(rawbuf, (size_t) bufSize);
-#else
-		enum { BUFSIZE = 1024 };
-		char rawbuf[BUFSIZE];
-		ByteBuffer buf(rawbuf, (size_t) BUFSIZE);
-#endif
+		//
+		//   encode the whole string so that it is a single write
+		//
+		std::string bytes;
 		enc->reset();
-		LogString::const_iterator iter = str.begin();
-
-		while (iter != str.end())
-		{
-			CharsetEncoder::encode(enc, str, iter, buf);
-			buf.flip();
-			out->write(buf, p);
-			buf.clear();
-		}
-
-		CharsetEncoder::encode(enc, str, iter, buf);
-		enc->flush(buf);
-		buf.flip();
+		enc->encodeAll(str, bytes);
+		ByteBuffer buf(&bytes[0], bytes.length());
 		out->write(buf, p);
-#ifdef LOG4CXX_MULTI_PROCESS
-		delete []rawbuf;
-#endif
 	}
 }
 
+void OutputStreamWriter::write(ByteBuffer& buf, Pool& p)
+{
+	out->write(buf, p);
+}
+
+void OutputStreamWriter::writeAll(const ByteStringList& buffers, Pool& p)
+{
+	out->writeAll(buffers, p);
+}
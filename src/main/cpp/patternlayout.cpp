@@ -26,6 +26,7 @@
 #include <log4cxx/helpers/stringhelper.h>
 #include <log4cxx/helpers/pool.h>
 #include <log4cxx/helpers/optionconverter.h>
+#include <limits.h>
 
 #include <log4cxx/pattern/loggerpatternconverter.h>
 #include <log4cxx/pattern/literalpatternconverter.h>
@@ -56,7 +57,9 @@ using namespace log4cxx::pattern;
 IMPLEMENT_LOG4CXX_OBJECT(PatternLayout)
 
 
-PatternLayout::PatternLayout()
+PatternLayout::PatternLayout() :
+	expectedLength(0),
+	formatsMessage(false)
 {
 }
 
@@ -64,7 +67,9 @@ PatternLayout::PatternLayout()
 Constructs a PatternLayout using the supplied conversion pattern.
 */
 PatternLayout::PatternLayout(const LogString& pattern)
-	: conversionPattern(pattern)
+	: conversionPattern(pattern),
+	  expectedLength(0),
+	  formatsMessage(false)
 {
 	Pool pool;
 	activateOptions(pool);
@@ -81,19 +86,53 @@ void PatternLayout::format(LogString& output,
 	const spi::LoggingEventPtr& event,
 	Pool& pool) const
 {
-	std::vector<FormattingInfoPtr>::const_iterator formatterIter =
-		patternFields.begin();
+	size_t reserve = expectedLength;
 
-	for (std::vector<LoggingEventPatternConverterPtr>::const_iterator
-		converterIter = patternConverters.begin();
-		converterIter != patternConverters.end();
-		converterIter++, formatterIter++)
+	if (formatsMessage)
 	{
-		int startField = output.length();
-		(*converterIter)->format(event, output, pool);
-		(*formatterIter)->format(startField, output);
+		reserve += event->getRenderedMessage().length();
 	}
 
+	output.reserve(output.length() + reserve);
+
+	for (std::vector<Step>::const_iterator step = plan.begin();
+		step != plan.end();
+		step++)
+	{
+		LogString::size_type startField = output.length();
+
+		switch (step->type)
+		{
+			case LITERAL_STEP:
+				output.append(step->literal);
+				break;
+
+			case MESSAGE_STEP:
+				output.append(event->getRenderedMessage());
+				break;
+
+			case LEVEL_STEP:
+				output.append(event->getLevel()->toString());
+				break;
+
+			case LOGGER_STEP:
+				output.append(event->getLoggerName());
+				break;
+
+			case THREAD_STEP:
+				output.append(event->getThreadName());
+				break;
+
+			default:
+				step->converter->format(event, output, pool);
+				break;
+		}
+
+		if (step->field != 0)
+		{
+			step->field->format(startField, output);
+		}
+	}
 }
 
 void PatternLayout::setOption(const LogString& option, const LogString& value)
@@ -106,7 +145,7 @@ void PatternLayout::setOption(const LogString& option, const LogString& value)
 	}
 }
 
-void PatternLayout::activateOptions(Pool&)
+void PatternLayout::activateOptions(Pool& p)
 {
 	LogString pat(conversionPattern);
 
@@ -115,28 +154,100 @@ void PatternLayout::activateOptions(Pool&)
 		pat = LOG4CXX_STR("%m%n");
 	}
 
-	patternConverters.erase(patternConverters.begin(), patternConverters.end());
-	patternFields.erase(patternFields.begin(), patternFields.end());
 	std::vector<PatternConverterPtr> converters;
+	FormattingInfoList fields;
 	PatternParser::parse(pat,
 		converters,
-		patternFields,
+		fields,
 		getFormatSpecifiers());
 
+	plan.clear();
+	expectedLength = 0;
+	formatsMessage = false;
+
 	//
 	//   strip out any pattern converters that don't handle LoggingEvents
+	//   and compile the rest into the plan
 	//
-	//
+	FormattingInfoList::const_iterator fieldIter = fields.begin();
+
 	for (std::vector<PatternConverterPtr>::const_iterator converterIter = converters.begin();
 		converterIter != converters.end();
-		converterIter++)
+		converterIter++, fieldIter++)
 	{
 		LoggingEventPatternConverterPtr eventConverter(*converterIter);
 
-		if (eventConverter != NULL)
+		if (eventConverter == NULL)
+		{
+			continue;
+		}
+
+		Step step;
+		step.type = CONVERTER_STEP;
+		step.converter = eventConverter;
+		const FormattingInfo& field = **fieldIter;
+
+		if (field.getMinLength() > 0 || field.getMaxLength() != INT_MAX)
+		{
+			step.field = *fieldIter;
+		}
+
+		const Class& cls = eventConverter->getClass();
+
+		if (&cls == &LiteralPatternConverter::getStaticClass()
+			|| &cls == &LineSeparatorPatternConverter::getStaticClass())
+		{
+			//
+			//   literals and line separators do not look at the event
+			//
+			step.type = LITERAL_STEP;
+			eventConverter->format(LoggingEventPtr(), step.literal, p);
+			step.converter = 0;
+
+			if (step.field != 0)
+			{
+				step.field->format(0, step.literal);
+				step.field = 0;
+			}
+
+			expectedLength += step.literal.length();
+
+			if (!plan.empty() && plan.back().type == LITERAL_STEP)
+			{
+				plan.back().literal.append(step.literal);
+				continue;
+			}
+		}
+		else if (&cls == &MessagePatternConverter::getStaticClass())
+		{
+			step.type = MESSAGE_STEP;
+			formatsMessage = true;
+		}
+		else if (&cls == &LevelPatternConverter::getStaticClass())
+		{
+			step.type = LEVEL_STEP;
+		}
+		else if (&cls == &LoggerPatternConverter::getStaticClass()
+			&& !ObjectPtrT<NamePatternConverter>(eventConverter)->isAbbreviating())
+		{
+			step.type = LOGGER_STEP;
+		}
+		else if (&cls == &ThreadPatternConverter::getStaticClass())
+		{
+			step.type = THREAD_STEP;
+		}
+
+		if (step.type != LITERAL_STEP)
 		{
-			patternConverters.push_back(eventConverter);
+			expectedLength += 16;
 		}
+
+		if (step.type != CONVERTER_STEP)
+		{
+			step.converter = 0;
+		}
+
+		plan.push_back(step);
 	}
 }
 
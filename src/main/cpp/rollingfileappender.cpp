@@ -36,6 +36,7 @@
 #include <log4cxx/helpers/loglog.h>
 #include <log4cxx/helpers/synchronized.h>
 #include <log4cxx/rolling/rolloverdescription.h>
+#include <log4cxx/rolling/actionexecutor.h>
 #include <log4cxx/helpers/fileoutputstream.h>
 #include <log4cxx/helpers/bytebuffer.h>
 #include <log4cxx/rolling/fixedwindowrollingpolicy.h>
@@ -115,13 +116,14 @@ void RollingFileAppenderSkeleton::activateOptions(Pool& p)
 				setAppend(rollover1->getAppend());
 
 				//
-				//  async action not yet implemented
+				//   compress on the shared rollover threads
 				//
 				ActionPtr asyncAction(rollover1->getAsynchronous());
 
 				if (asyncAction != NULL)
 				{
-					asyncAction->execute(p);
+					pendingAction = asyncAction;
+					ActionExecutor::execute(asyncAction);
 				}
 			}
 
@@ -283,6 +285,16 @@ bool RollingFileAppenderSkeleton::rollover(Pool& p)
 
 				try
 				{
+					//
+					//   the policy may rename files that the previous
+					//      rollover is still compressing
+					//
+					if (pendingAction != NULL)
+					{
+						ActionExecutor::await(pendingAction);
+						pendingAction = 0;
+					}
+
 					RolloverDescriptionPtr rollover1(rollingPolicy->rollover(this->getFile(), this->getAppend(), p));
 
 					if (rollover1 != NULL)
@@ -319,13 +331,14 @@ bool RollingFileAppenderSkeleton::rollover(Pool& p)
 								}
 
 								//
-								//  async action not yet implemented
+								//   compress on the shared rollover threads
 								//
 								ActionPtr asyncAction(rollover1->getAsynchronous());
 
 								if (asyncAction != NULL)
 								{
-									asyncAction->execute(p);
+									pendingAction = asyncAction;
+									ActionExecutor::execute(asyncAction);
 								}
 
 								setFile(
@@ -340,7 +353,12 @@ bool RollingFileAppenderSkeleton::rollover(Pool& p)
 						}
 						else
 						{
-							OutputStreamPtr os(new FileOutputStream(
+							//
+							//   measure before opening since a mapped
+							//      stream extends the file
+							//
+							size_t activeLength = File().setPath(rollover1->getActiveFileName()).length(p);
+							OutputStreamPtr os(createOutputStream(
 									rollover1->getActiveFileName(), rollover1->getAppend()));
 							WriterPtr newWriter(createWriter(os));
 							closeWriter();
@@ -367,7 +385,7 @@ bool RollingFileAppenderSkeleton::rollover(Pool& p)
 							{
 								if (rollover1->getAppend())
 								{
-									fileLength = File().setPath(rollover1->getActiveFileName()).length(p);
+									fileLength = activeLength;
 								}
 								else
 								{
@@ -375,13 +393,14 @@ bool RollingFileAppenderSkeleton::rollover(Pool& p)
 								}
 
 								//
-								//   async action not yet implemented
+								//   compress on the shared rollover threads
 								//
 								ActionPtr asyncAction(rollover1->getAsynchronous());
 
 								if (asyncAction != NULL)
 								{
-									asyncAction->execute(p);
+									pendingAction = asyncAction;
+									ActionExecutor::execute(asyncAction);
 								}
 							}
 
@@ -492,6 +511,11 @@ void RollingFileAppenderSkeleton::subAppend(const LoggingEventPtr& event, Pool&
 	FileAppender::subAppend(event, p);
 }
 
+void RollingFileAppenderSkeleton::appendAll(const LoggingEventList& events, Pool& p)
+{
+	AppenderSkeleton::appendAll(events, p);
+}
+
 /**
  * Get rolling policy.
  * @return rolling policy.
@@ -534,6 +558,18 @@ void RollingFileAppenderSkeleton::setTriggeringPolicy(const TriggeringPolicyPtr&
 void RollingFileAppenderSkeleton::close()
 {
 	FileAppender::close();
+
+	ActionPtr action;
+	{
+		LOCK_W sync(mutex);
+		action = pendingAction;
+		pendingAction = 0;
+	}
+
+	if (action != NULL)
+	{
+		ActionExecutor::await(action);
+	}
 }
 
 namespace log4cxx
@@ -603,6 +639,32 @@ class CountingOutputStream : public OutputStream
 			}
 		}
 
+		/**
+		 * {@inheritDoc}
+		 */
+		void writeAll(const ByteStringList& buffers, Pool& p)
+		{
+			os->writeAll(buffers, p);
+
+			if (rfa != 0)
+			{
+#ifndef LOG4CXX_MULTI_PROCESS
+				size_t length = 0;
+
+				for (ByteStringList::const_iterator iter = buffers.begin();
+					iter != buffers.end();
+					iter++)
+				{
+					length += iter->length();
+				}
+
+				rfa->incrementFileLength(length);
+#else
+				rfa->setFileLength(File().setPath(rfa->getFile()).length(p));
+#endif
+			}
+		}
+
 #ifdef LOG4CXX_MULTI_PROCESS
 		OutputStream& getFileOutPutStreamPtr()
 		{
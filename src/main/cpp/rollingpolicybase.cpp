@@ -28,6 +28,10 @@
 #include <log4cxx/pattern/patternparser.h>
 #include <log4cxx/pattern/integerpatternconverter.h>
 #include <log4cxx/pattern/datepatternconverter.h>
+#include <log4cxx/helpers/optionconverter.h>
+#include <log4cxx/rolling/gzcompressaction.h>
+#include <log4cxx/rolling/zstdcompressaction.h>
+#include <log4cxx/rolling/zipcompressaction.h>
 
 using namespace log4cxx;
 using namespace log4cxx::rolling;
@@ -36,7 +40,9 @@ using namespace log4cxx::pattern;
 
 IMPLEMENT_LOG4CXX_OBJECT(RollingPolicyBase)
 
-RollingPolicyBase::RollingPolicyBase()
+RollingPolicyBase::RollingPolicyBase() :
+	compressionLevel(-1),
+	compressionThreads(0)
 {
 }
 
@@ -79,6 +85,18 @@ void RollingPolicyBase::setOption(const LogString& option, const LogString& valu
 	{
 		fileNamePatternStr = value;
 	}
+	else if (StringHelper::equalsIgnoreCase(option,
+			LOG4CXX_STR("COMPRESSIONLEVEL"),
+			LOG4CXX_STR("compressionlevel")))
+	{
+		compressionLevel = OptionConverter::toInt(value, -1);
+	}
+	else if (StringHelper::equalsIgnoreCase(option,
+			LOG4CXX_STR("COMPRESSIONTHREADS"),
+			LOG4CXX_STR("compressionthreads")))
+	{
+		compressionThreads = OptionConverter::toInt(value, 0);
+	}
 }
 
 void RollingPolicyBase::setFileNamePattern(const LogString& fnp)
@@ -92,6 +110,71 @@ LogString RollingPolicyBase::getFileNamePattern() const
 	return fileNamePatternStr;
 }
 
+void RollingPolicyBase::setCompressionLevel(int level)
+{
+	compressionLevel = level;
+}
+
+int RollingPolicyBase::getCompressionLevel() const
+{
+	return compressionLevel;
+}
+
+void RollingPolicyBase::setCompressionThreads(int threads)
+{
+	compressionThreads = threads;
+}
+
+int RollingPolicyBase::getCompressionThreads() const
+{
+	return compressionThreads;
+}
+
+size_t RollingPolicyBase::getCompressionSuffixLength(const LogString& fileName)
+{
+	if (StringHelper::endsWith(fileName, LOG4CXX_STR(".gz")))
+	{
+		return 3;
+	}
+
+	if (StringHelper::endsWith(fileName, LOG4CXX_STR(".zst"))
+		|| StringHelper::endsWith(fileName, LOG4CXX_STR(".zip")))
+	{
+		return 4;
+	}
+
+	return 0;
+}
+
+ActionPtr RollingPolicyBase::createCompressAction(
+	const LogString& fileName, bool deleteSource) const
+{
+	ActionPtr compressAction;
+	File source;
+	source.setPath(fileName.substr(0,
+			fileName.length() - getCompressionSuffixLength(fileName)));
+	File destination;
+	destination.setPath(fileName);
+
+	if (StringHelper::endsWith(fileName, LOG4CXX_STR(".gz")))
+	{
+		compressAction = new GZCompressAction(source, destination,
+			deleteSource, compressionLevel);
+	}
+	else if (StringHelper::endsWith(fileName, LOG4CXX_STR(".zst")))
+	{
+		compressAction = new ZstdCompressAction(source, destination,
+			deleteSource, compressionLevel, compressionThreads);
+	}
+	else if (StringHelper::endsWith(fileName, LOG4CXX_STR(".zip")))
+	{
+		compressAction = new ZipCompressAction(source, destination,
+			deleteSource);
+	}
+
+	return compressAction;
+}
+
 /**
  *   Parse file name pattern.
  */
@@ -17,6 +17,8 @@
 #include <log4cxx/helpers/socket.h>
 #include <log4cxx/helpers/bytebuffer.h>
 #include <log4cxx/helpers/transcoder.h>
+#define APR_WANT_IOVEC
+#include "apr_want.h"
 #include "apr_network_io.h"
 #include "apr_signal.h"
 
@@ -132,6 +134,77 @@ size_t Socket::write(ByteBuffer& buf)
 	return totalWritten;
 }
 
+size_t Socket::write(const ByteStringList& buffers)
+{
+	if (socket == 0)
+	{
+		throw ClosedChannelException();
+	}
+
+	enum { MAX_IOVEC = 64 };
+	struct iovec vec[MAX_IOVEC];
+	size_t totalWritten = 0;
+	ByteStringList::const_iterator next = buffers.begin();
+	size_t offset = 0;
+
+	while (next != buffers.end())
+	{
+		//
+		//   gather what is left, starting part way through
+		//      the first buffer after a short send
+		//
+		apr_int32_t nvec = 0;
+		size_t skip = offset;
+
+		for (ByteStringList::const_iterator iter = next;
+			iter != buffers.end() && nvec < MAX_IOVEC;
+			iter++)
+		{
+			if (iter->length() > skip)
+			{
+				vec[nvec].iov_base = const_cast<char*>(iter->data()) + skip;
+				vec[nvec].iov_len = iter->length() - skip;
+				nvec++;
+			}
+
+			skip = 0;
+		}
+
+		if (nvec == 0)
+		{
+			break;
+		}
+
+		apr_size_t written = 0;
+#if APR_HAVE_SIGACTION
+		apr_sigfunc_t* old = apr_signal(SIGPIPE, SIG_IGN);
+		apr_status_t status = apr_socket_sendv(socket, vec, nvec, &written);
+		apr_signal(SIGPIPE, old);
+#else
+		apr_status_t status = apr_socket_sendv(socket, vec, nvec, &written);
+#endif
+
+		totalWritten += written;
+
+		if (status != APR_SUCCESS)
+		{
+			throw SocketException(status);
+		}
+
+		written += offset;
+
+		while (next != buffers.end() && written >= next->length())
+		{
+			written -= next->length();
+			next++;
+		}
+
+		offset = written;
+	}
+
+	return totalWritten;
+}
+
 
 void Socket::close()
 {
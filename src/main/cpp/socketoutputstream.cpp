@@ -64,4 +64,18 @@ void SocketOutputStream::write(ByteBuffer& buf, Pool& /* p */ )
 	}
 }
 
-
+void SocketOutputStream::writeAll(const ByteStringList& buffers, Pool& p)
+{
+	//
+	//   nothing is waiting for a flush, so the buffers
+	//      can go straight to the socket in one send
+	//
+	if (array.empty())
+	{
+		socket->write(buffers);
+	}
+	else
+	{
+		OutputStream::writeAll(buffers, p);
+	}
+}
@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if defined(_MSC_VER)
+	#pragma warning ( disable: 4231 4251 4275 4786 )
+#endif
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/helpers/threadname.h>
+#include <log4cxx/helpers/threadspecificdata.h>
+#include <log4cxx/helpers/transcoder.h>
+#if !defined(LOG4CXX)
+	#define LOG4CXX 1
+#endif
+#include <log4cxx/private/log4cxx_private.h>
+#include <apr_portable.h>
+#include <apr_strings.h>
+#if LOG4CXX_HAS_PTHREAD_GETNAME_NP
+	#include <pthread.h>
+#endif
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+
+IMPLEMENT_LOG4CXX_OBJECT(ThreadName)
+
+
+ThreadName::ThreadName() : name()
+{
+}
+
+ThreadName::ThreadName(const LogString& name1) : name(name1)
+{
+}
+
+ThreadName::~ThreadName()
+{
+}
+
+ThreadNamePtr ThreadName::getCurrentThreadName()
+{
+	return ThreadSpecificData::getThreadName();
+}
+
+void ThreadName::setCurrentThreadName(const LogString& name)
+{
+	ThreadSpecificData::setThreadName(name);
+}
+
+bool ThreadName::setCurrentThreadNameFromSystem()
+{
+#if LOG4CXX_HAS_PTHREAD_GETNAME_NP
+	char result[64];
+
+	if (pthread_getname_np(pthread_self(), result, sizeof(result)) == 0
+		&& result[0] != 0)
+	{
+		LOG4CXX_DECODE_CHAR(name, (const char*) result);
+		setCurrentThreadName(name);
+		return true;
+	}
+
+#endif
+	return false;
+}
+
+LogString ThreadName::getCurrentThreadId()
+{
+#if APR_HAS_THREADS
+#if defined(_WIN32)
+	char result[20];
+	DWORD threadId = GetCurrentThreadId();
+	apr_snprintf(result, sizeof(result), LOG4CXX_WIN32_THREAD_FMTSPEC, threadId);
+#else
+	// apr_os_thread_t encoded in HEX takes needs as many characters
+	// as two times the size of the type, plus an additional null byte.
+	char result[sizeof(apr_os_thread_t) * 3 + 10];
+	apr_os_thread_t threadId = apr_os_thread_current();
+	apr_snprintf(result, sizeof(result), LOG4CXX_APR_THREAD_FMTSPEC, (void*) &threadId);
+#endif
+	LOG4CXX_DECODE_CHAR(str, (const char*) result);
+	return str;
+#else
+	return LOG4CXX_STR("0x00000000");
+#endif
+}
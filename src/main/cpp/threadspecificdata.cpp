@@ -19,6 +19,8 @@
 #include <log4cxx/helpers/threadspecificdata.h>
 #include <log4cxx/helpers/exception.h>
 #include <apr_thread_proc.h>
+#include <apr_pools.h>
+#include <apr_atomic.h>
 #if !defined(LOG4CXX)
 	#define LOG4CXX 1
 #endif
@@ -27,14 +29,216 @@
 using namespace log4cxx;
 using namespace log4cxx::helpers;
 
+namespace log4cxx
+{
+namespace helpers
+{
+union EventBlock;
+
+/**
+ *  Freelist of blocks owned by one thread.  Blocks released by the
+ *  owning thread go on the local list; blocks released by any other
+ *  thread, such as an AsyncAppender dispatcher, are pushed on the
+ *  remote stack, which the owner takes over in a single exchange once
+ *  its local list runs dry.  The cache holds one reference for its
+ *  thread and one for every block handed out, so that it outlives its
+ *  thread until the last outstanding block has come back.
+ */
+class EventCache
+{
+	public:
+		EventCache(size_t blockSize);
+
+		void* allocate(size_t size);
+		static void release(void* ptr, EventCache* current);
+		void detach();
+
+	private:
+		void releaseRef();
+		static void destroy(EventBlock* list);
+
+		/**
+		 *  Most blocks kept on the local list, beyond which blocks
+		 *  released by the owning thread are freed.
+		 */
+		enum { MAX_LOCAL_BLOCKS = 256 };
+
+		const size_t blockSize;
+		EventBlock* local;
+		unsigned int localCount;
+		volatile void* remote;
+		volatile apr_uint32_t refs;
+
+		EventCache(const EventCache&);
+		EventCache& operator=(const EventCache&);
+};
+
+/**
+ *  Header preceding each block, padded so that the block
+ *  itself is suitably aligned.
+ */
+union EventBlock
+{
+	struct Link
+	{
+		EventCache* owner;
+		EventBlock* next;
+	} link;
+	apr_int64_t alignInt;
+	double alignDouble;
+};
+}
+}
+
+EventCache::EventCache(size_t blockSize1)
+	: blockSize(blockSize1), local(0), localCount(0), remote(0), refs(1)
+{
+}
+
+void* EventCache::allocate(size_t size)
+{
+	if (size > blockSize)
+	{
+		EventBlock* block = (EventBlock*) ::operator new(sizeof(EventBlock) + size);
+		block->link.owner = 0;
+		return block + 1;
+	}
+
+	if (local == 0)
+	{
+		local = (EventBlock*) apr_atomic_xchgptr(&remote, 0);
+
+		for (EventBlock* block = local; block != 0; block = block->link.next)
+		{
+			localCount++;
+		}
+	}
+
+	EventBlock* block = local;
+
+	if (block != 0)
+	{
+		local = block->link.next;
+		localCount--;
+	}
+	else
+	{
+		block = (EventBlock*) ::operator new(sizeof(EventBlock) + blockSize);
+		block->link.owner = this;
+	}
+
+	apr_atomic_inc32(&refs);
+	return block + 1;
+}
+
+void EventCache::release(void* ptr, EventCache* current)
+{
+	EventBlock* block = ((EventBlock*) ptr) - 1;
+	EventCache* owner = block->link.owner;
+
+	if (owner == 0)
+	{
+		::operator delete(block);
+	}
+	else if (owner == current)
+	{
+		if (owner->localCount < MAX_LOCAL_BLOCKS)
+		{
+			block->link.next = owner->local;
+			owner->local = block;
+			owner->localCount++;
+		}
+		else
+		{
+			::operator delete(block);
+		}
+
+		owner->releaseRef();
+	}
+	else
+	{
+		void* head;
+
+		do
+		{
+			head = (void*) owner->remote;
+			block->link.next = (EventBlock*) head;
+		}
+		while (apr_atomic_casptr(&owner->remote, block, head) != head);
+
+		owner->releaseRef();
+	}
+}
+
+void EventCache::detach()
+{
+	destroy(local);
+	local = 0;
+	localCount = 0;
+	destroy((EventBlock*) apr_atomic_xchgptr(&remote, 0));
+	releaseRef();
+}
+
+void EventCache::releaseRef()
+{
+	if (apr_atomic_dec32(&refs) == 0)
+	{
+		destroy((EventBlock*) apr_atomic_xchgptr(&remote, 0));
+		delete this;
+	}
+}
+
+void EventCache::destroy(EventBlock* list)
+{
+	while (list != 0)
+	{
+		EventBlock* next = list->link.next;
+		::operator delete(list);
+		list = next;
+	}
+}
+
+namespace
+{
+//
+//   Every reader epoch ever claimed.  Records are never freed: a
+//      thread that ends leaves its record to the next thread that
+//      needs one, so the list only grows to the largest number of
+//      threads alive at once and can be walked without a lock.
+//
+volatile void* readerEpochs = 0;
+
+//
+//   Epoch recorded by reads entered now, zero is reserved
+//      for a thread that is not reading.
+//
+unsigned int volatile currentReaderEpoch = 1;
+}
+
 
 ThreadSpecificData::ThreadSpecificData()
-	: ndcStack(), mdcMap()
+	: ndcStack(), mdcMap(), threadName(), scratchPool(0), scratchPoolInUse(false), eventCache(0),
+	  readerEpoch(0)
 {
 }
 
 ThreadSpecificData::~ThreadSpecificData()
 {
+	if (scratchPool != 0)
+	{
+		apr_pool_destroy(scratchPool);
+	}
+
+	if (eventCache != 0)
+	{
+		eventCache->detach();
+	}
+
+	if (readerEpoch != 0)
+	{
+		apr_atomic_set32(&readerEpoch->epoch, 0);
+		apr_atomic_xchg32(&readerEpoch->claimed, 0);
+	}
 }
 
 
@@ -69,7 +273,8 @@ void ThreadSpecificData::recycle()
 {
 #if APR_HAS_THREADS
 
-	if (ndcStack.empty() && mdcMap.empty())
+	if (ndcStack.empty() && mdcMap.empty() && threadName == 0
+		&& scratchPool == 0 && eventCache == 0 && readerEpoch == 0)
 	{
 		void* pData = NULL;
 		apr_status_t stat = apr_threadkey_private_get(&pData, APRInitializer::getTlsKey());
@@ -167,3 +372,232 @@ ThreadSpecificData* ThreadSpecificData::createCurrentData()
 	return 0;
 #endif
 }
+
+ThreadNamePtr ThreadSpecificData::getThreadName()
+{
+	ThreadSpecificData* data = getCurrentData();
+
+	if (data == 0)
+	{
+		data = createCurrentData();
+	}
+
+	if (data == 0)
+	{
+		return new ThreadName(ThreadName::getCurrentThreadId());
+	}
+
+	if (data->threadName == 0)
+	{
+		data->threadName = new ThreadName(ThreadName::getCurrentThreadId());
+	}
+
+	return data->threadName;
+}
+
+void ThreadSpecificData::setThreadName(const LogString& name)
+{
+	ThreadSpecificData* data = getCurrentData();
+
+	if (data == 0)
+	{
+		data = createCurrentData();
+	}
+
+	if (data != 0)
+	{
+		data->threadName = new ThreadName(name);
+	}
+}
+
+apr_pool_t* ThreadSpecificData::acquireScratchPool()
+{
+	ThreadSpecificData* data = getCurrentData();
+
+	if (data == 0)
+	{
+		data = createCurrentData();
+	}
+
+	if (data == 0 || data->scratchPoolInUse)
+	{
+		return 0;
+	}
+
+	if (data->scratchPool == 0
+		&& apr_pool_create(&data->scratchPool, APRInitializer::getRootPool()) != APR_SUCCESS)
+	{
+		data->scratchPool = 0;
+		return 0;
+	}
+
+	data->scratchPoolInUse = true;
+	return data->scratchPool;
+}
+
+void ThreadSpecificData::releaseScratchPool(apr_pool_t* pool)
+{
+	ThreadSpecificData* data = getCurrentData();
+
+	if (data != 0 && data->scratchPool == pool)
+	{
+		apr_pool_clear(pool);
+		data->scratchPoolInUse = false;
+	}
+	else
+	{
+		apr_pool_destroy(pool);
+	}
+}
+
+void* ThreadSpecificData::allocateEvent(size_t size)
+{
+	ThreadSpecificData* data = getCurrentData();
+
+	if (data == 0)
+	{
+		data = createCurrentData();
+	}
+
+	if (data == 0)
+	{
+		EventBlock* block = (EventBlock*) ::operator new(sizeof(EventBlock) + size);
+		block->link.owner = 0;
+		return block + 1;
+	}
+
+	if (data->eventCache == 0)
+	{
+		data->eventCache = new EventCache(size);
+	}
+
+	return data->eventCache->allocate(size);
+}
+
+void ThreadSpecificData::releaseEvent(void* ptr)
+{
+	if (ptr != 0)
+	{
+		ThreadSpecificData* data = getCurrentData();
+		EventCache::release(ptr, data == 0 ? 0 : data->eventCache);
+	}
+}
+
+ReaderEpoch* ThreadSpecificData::getReaderEpoch()
+{
+	ThreadSpecificData* data = getCurrentData();
+
+	if (data == 0)
+	{
+		data = createCurrentData();
+	}
+
+	if (data == 0)
+	{
+		return 0;
+	}
+
+	if (data->readerEpoch == 0)
+	{
+		ReaderEpoch* reader = (ReaderEpoch*) readerEpochs;
+
+		while (reader != 0 && (reader->claimed != 0
+				|| apr_atomic_cas32(&reader->claimed, 1, 0) != 0))
+		{
+			reader = reader->next;
+		}
+
+		if (reader == 0)
+		{
+			reader = new ReaderEpoch();
+			reader->epoch = 0;
+			reader->claimed = 1;
+			void* head;
+
+			do
+			{
+				head = (void*) readerEpochs;
+				reader->next = (ReaderEpoch*) head;
+			}
+			while (apr_atomic_casptr(&readerEpochs, reader, head) != head);
+		}
+
+		data->readerEpoch = reader;
+	}
+
+	return data->readerEpoch;
+}
+
+unsigned int ThreadSpecificData::getOldestReaderEpoch(const ReaderEpoch* except)
+{
+	unsigned int oldest = 0xFFFFFFFF;
+
+	for (ReaderEpoch* reader = (ReaderEpoch*) readerEpochs;
+		reader != 0;
+		reader = reader->next)
+	{
+		unsigned int epoch = apr_atomic_read32(&reader->epoch);
+
+		if (reader != except && epoch != 0 && epoch < oldest)
+		{
+			oldest = epoch;
+		}
+	}
+
+	return oldest;
+}
+
+unsigned int ThreadSpecificData::getCurrentReaderEpoch()
+{
+	return apr_atomic_read32(&currentReaderEpoch);
+}
+
+unsigned int ThreadSpecificData::advanceReaderEpoch()
+{
+	return apr_atomic_inc32(&currentReaderEpoch) + 1;
+}
+
+
+EpochRead::EpochRead() : reader(ThreadSpecificData::getReaderEpoch()), outermost(false)
+{
+	if (reader != 0 && reader->epoch == 0)
+	{
+		outermost = true;
+		apr_atomic_xchg32(&reader->epoch, ThreadSpecificData::getCurrentReaderEpoch());
+	}
+}
+
+EpochRead::~EpochRead()
+{
+	if (outermost)
+	{
+		apr_atomic_xchg32(&reader->epoch, 0);
+	}
+}
+
+
+ScratchPool::ScratchPool() : Pool(acquire(), false)
+{
+}
+
+ScratchPool::~ScratchPool()
+{
+	ThreadSpecificData::releaseScratchPool(pool);
+}
+
+apr_pool_t* ScratchPool::acquire()
+{
+	apr_pool_t* p = ThreadSpecificData::acquireScratchPool();
+
+	if (p == 0)
+	{
+		apr_status_t stat = apr_pool_create(&p, APRInitializer::getRootPool());
+
+		if (stat != APR_SUCCESS)
+		{
+			throw PoolException(stat);
+		}
+	}
+
+	return p;
+}
@@ -29,8 +29,6 @@
 #include <log4cxx/rolling/filerenameaction.h>
 #include <log4cxx/helpers/loglog.h>
 #include <log4cxx/helpers/exception.h>
-#include <log4cxx/rolling/gzcompressaction.h>
-#include <log4cxx/rolling/zipcompressaction.h>
 #include <log4cxx/rolling/rollingfileappenderskeleton.h>
 #include<iostream>
 
@@ -243,19 +241,7 @@ void TimeBasedRollingPolicy::activateOptions(log4cxx::helpers::Pool& pool)
 	initMMapFile(lastFileName, *_mmapPool);
 #endif
 
-	suffixLength = 0;
-
-	if (lastFileName.length() >= 3)
-	{
-		if (lastFileName.compare(lastFileName.length() - 3, 3, LOG4CXX_STR(".gz")) == 0)
-		{
-			suffixLength = 3;
-		}
-		else if (lastFileName.length() >= 4 && lastFileName.compare(lastFileName.length() - 4, 4, LOG4CXX_STR(".zip")) == 0)
-		{
-			suffixLength = 4;
-		}
-	}
+	suffixLength = (int) getCompressionSuffixLength(lastFileName);
 }
 
 
@@ -364,19 +350,7 @@ RolloverDescriptionPtr TimeBasedRollingPolicy::rollover(
 		nextActiveFile = currentActiveFile;
 	}
 
-	if (suffixLength == 3)
-	{
-		compressAction =
-			new GZCompressAction(
-			File().setPath(lastBaseName), File().setPath(lastFileName), true);
-	}
-
-	if (suffixLength == 4)
-	{
-		compressAction =
-			new ZipCompressAction(
-			File().setPath(lastBaseName), File().setPath(lastFileName), true);
-	}
+	compressAction = createCompressAction(lastFileName, true);
 
 #ifdef LOG4CXX_MULTI_PROCESS
 
@@ -34,10 +34,240 @@
 #if LOG4CXX_LOGCHAR_IS_UNICHAR || LOG4CXX_CFSTRING_API || LOG4CXX_UNICHAR_API
 	#include <CoreFoundation/CFString.h>
 #endif
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define LOG4CXX_TRANSCODER_SSE2 1
+	#include <emmintrin.h>
+#endif
 
 using namespace log4cxx;
 using namespace log4cxx::helpers;
 
+namespace
+{
+/**
+ *  Finds the first byte that is not ASCII.
+ *  @return index of the byte or length if all are ASCII.
+ */
+size_t findNonASCII(const char* src, size_t length)
+{
+	size_t i = 0;
+#if LOG4CXX_TRANSCODER_SSE2
+
+	for (; i + 16 <= length; i += 16)
+	{
+		if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i*) (src + i))) != 0)
+		{
+			break;
+		}
+	}
+
+#endif
+
+	while (i < length && ((unsigned char) src[i]) < 0x80)
+	{
+		i++;
+	}
+
+	return i;
+}
+
+#if !LOG4CXX_LOGCHAR_IS_UTF8
+/**
+ *  Finds the first logchar that is not ASCII.
+ *  @return index of the character or length if all are ASCII.
+ */
+size_t findNonASCII(const logchar* src, size_t length)
+{
+	size_t i = 0;
+#if LOG4CXX_TRANSCODER_SSE2
+	enum { COUNT = 16 / sizeof(logchar) };
+	const __m128i high = sizeof(logchar) == 4 ?
+		_mm_set1_epi32(~0x7F) : _mm_set1_epi16((short) ~0x7F);
+	const __m128i zero = _mm_setzero_si128();
+
+	for (; i + COUNT <= length; i += COUNT)
+	{
+		__m128i chunk = _mm_loadu_si128((const __m128i*) (src + i));
+
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(chunk, high), zero)) != 0xFFFF)
+		{
+			break;
+		}
+	}
+
+#endif
+
+	while (i < length && ((unsigned int) src[i]) < 0x80)
+	{
+		i++;
+	}
+
+	return i;
+}
+
+/**
+ *  Widens ASCII bytes to logchars.
+ */
+void widenASCII(const char* src, size_t length, logchar* dst)
+{
+	size_t i = 0;
+#if LOG4CXX_TRANSCODER_SSE2
+	const __m128i zero = _mm_setzero_si128();
+
+	for (; i + 16 <= length; i += 16)
+	{
+		__m128i bytes = _mm_loadu_si128((const __m128i*) (src + i));
+		__m128i low = _mm_unpacklo_epi8(bytes, zero);
+		__m128i high = _mm_unpackhi_epi8(bytes, zero);
+
+		if (sizeof(logchar) == 2)
+		{
+			_mm_storeu_si128((__m128i*) (dst + i), low);
+			_mm_storeu_si128((__m128i*) (dst + i + 8), high);
+		}
+		else
+		{
+			_mm_storeu_si128((__m128i*) (dst + i), _mm_unpacklo_epi16(low, zero));
+			_mm_storeu_si128((__m128i*) (dst + i + 4), _mm_unpackhi_epi16(low, zero));
+			_mm_storeu_si128((__m128i*) (dst + i + 8), _mm_unpacklo_epi16(high, zero));
+			_mm_storeu_si128((__m128i*) (dst + i + 12), _mm_unpackhi_epi16(high, zero));
+		}
+	}
+
+#endif
+
+	for (; i < length; i++)
+	{
+		dst[i] = (logchar) src[i];
+	}
+}
+
+/**
+ *  Narrows ASCII logchars to bytes.
+ */
+void narrowASCII(const logchar* src, size_t length, char* dst)
+{
+	size_t i = 0;
+#if LOG4CXX_TRANSCODER_SSE2
+
+	for (; i + 16 <= length; i += 16)
+	{
+		const __m128i* chunks = (const __m128i*) (src + i);
+		__m128i bytes;
+
+		if (sizeof(logchar) == 2)
+		{
+			bytes = _mm_packus_epi16(_mm_loadu_si128(chunks), _mm_loadu_si128(chunks + 1));
+		}
+		else
+		{
+			bytes = _mm_packus_epi16(
+					_mm_packs_epi32(_mm_loadu_si128(chunks), _mm_loadu_si128(chunks + 1)),
+					_mm_packs_epi32(_mm_loadu_si128(chunks + 2), _mm_loadu_si128(chunks + 3)));
+		}
+
+		_mm_storeu_si128((__m128i*) (dst + i), bytes);
+	}
+
+#endif
+
+	for (; i < length; i++)
+	{
+		dst[i] = (char) src[i];
+	}
+}
+#endif
+
+/**
+ *  Finds the run of ASCII characters starting at iter that fits in
+ *  a buffer with room for the given number of characters.
+ */
+size_t findASCIIRun(const LogString& src, LogString::const_iterator iter, size_t room)
+{
+	size_t offset = iter - src.begin();
+	size_t length = src.length() - offset;
+
+	if (length > room)
+	{
+		length = room;
+	}
+
+	return findNonASCII(src.data() + offset, length);
+}
+
+/**
+ *  Appends the run of ASCII characters starting at iter as bytes.
+ */
+void appendASCII(const LogString& src, LogString::const_iterator& iter, std::string& dst)
+{
+	size_t count = findASCIIRun(src, iter, src.length());
+
+	if (count > 0)
+	{
+		size_t offset = iter - src.begin();
+#if LOG4CXX_LOGCHAR_IS_UTF8
+		dst.append(src, offset, count);
+#else
+		size_t used = dst.length();
+		dst.resize(used + count);
+		narrowASCII(src.data() + offset, count, &dst[used]);
+#endif
+		iter += count;
+	}
+}
+}
+
+size_t Transcoder::decodeASCII(const char* src, size_t length, LogString& dst)
+{
+	size_t count = findNonASCII(src, length);
+
+	if (count > 0)
+	{
+#if LOG4CXX_LOGCHAR_IS_UTF8
+		dst.append(src, count);
+#else
+		size_t used = dst.length();
+		dst.resize(used + count);
+		widenASCII(src, count, &dst[used]);
+#endif
+	}
+
+	return count;
+}
+
+void Transcoder::encodeASCII(const LogString& src,
+	LogString::const_iterator& iter, ByteBuffer& dst)
+{
+	size_t count = findASCIIRun(src, iter, dst.remaining());
+#if LOG4CXX_LOGCHAR_IS_UTF8
+	memcpy(dst.current(), src.data() + (iter - src.begin()), count);
+#else
+	narrowASCII(src.data() + (iter - src.begin()), count, dst.current());
+#endif
+	dst.position(dst.position() + count);
+	iter += count;
+}
+
+void Transcoder::encodeASCIIUTF16(const LogString& src,
+	LogString::const_iterator& iter, ByteBuffer& dst, bool bigEndian)
+{
+	size_t count = findASCIIRun(src, iter, dst.remaining() / 2);
+	const logchar* in = src.data() + (iter - src.begin());
+	char* out = dst.current();
+	const size_t zeroByte = bigEndian ? 0 : 1;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		out[2 * i + zeroByte] = 0;
+		out[2 * i + 1 - zeroByte] = (char) in[i];
+	}
+
+	dst.position(dst.position() + 2 * count);
+	iter += count;
+}
+
 
 void Transcoder::decodeUTF8(const std::string& src, LogString& dst)
 {
@@ -45,6 +275,17 @@ void Transcoder::decodeUTF8(const std::string& src, LogString& dst)
 
 	while (iter != src.end())
 	{
+		//
+		//   copy runs of ASCII in bulk, validating code points between them
+		//
+		size_t offset = iter - src.begin();
+		iter += decodeASCII(src.data() + offset, src.length() - offset, dst);
+
+		if (iter == src.end())
+		{
+			break;
+		}
+
 		unsigned int sv = decode(src, iter);
 
 		if (sv != 0xFFFF)
@@ -68,6 +309,13 @@ void Transcoder::encodeUTF8(const LogString& src, std::string& dst)
 
 	while (iter != src.end())
 	{
+		appendASCII(src, iter, dst);
+
+		if (iter == src.end())
+		{
+			break;
+		}
+
 		unsigned int sv = decode(src, iter);
 
 		if (sv != 0xFFFF)
@@ -319,14 +567,7 @@ void Transcoder::decode(const std::string& src, LogString& dst)
 	dst.reserve(dst.size() + src.size());
 	std::string::const_iterator iter = src.begin();
 #if !LOG4CXX_CHARSET_EBCDIC
-
-	for (;
-		iter != src.end() && ((unsigned char) *iter) < 0x80;
-		iter++)
-	{
-		dst.append(1, *iter);
-	}
-
+	iter += decodeASCII(src.data(), src.length(), dst);
 #endif
 
 	if (iter != src.end())
@@ -373,14 +614,7 @@ void Transcoder::encode(const LogString& src, std::string& dst)
 	dst.reserve(dst.size() + src.size());
 	LogString::const_iterator iter = src.begin();
 #if !LOG4CXX_CHARSET_EBCDIC
-
-	for (;
-		iter != src.end() && ((unsigned int) *iter) < 0x80;
-		iter++)
-	{
-		dst.append(1, *iter);
-	}
-
+	appendASCII(src, iter, dst);
 #endif
 
 	if (iter != src.end())
@@ -18,27 +18,183 @@
 #include <log4cxx/logstring.h>
 #include <log4cxx/helpers/transform.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define LOG4CXX_TRANSFORM_SSE2 1
+	#include <emmintrin.h>
+#endif
+
 using namespace log4cxx;
 using namespace log4cxx::helpers;
 
+namespace
+{
+#if LOG4CXX_TRANSFORM_SSE2
+/**
+ *  SSE2 operations on 16 bytes of characters of a given width.
+ *  lessThan compares as unsigned by flipping the sign bits.
+ */
+template<size_t width> struct Lanes;
 
+template<> struct Lanes<1>
+{
+	enum { COUNT = 16 };
+	static __m128i set(int c)
+	{
+		return _mm_set1_epi8((char) c);
+	}
+	static __m128i equal(__m128i a, __m128i b)
+	{
+		return _mm_cmpeq_epi8(a, b);
+	}
+	static __m128i lessThan(__m128i a, int c)
+	{
+		const __m128i sign = _mm_set1_epi8((char) 0x80);
+		return _mm_cmplt_epi8(_mm_xor_si128(a, sign), _mm_xor_si128(set(c), sign));
+	}
+};
 
-void Transform::appendEscapingTags(
-	LogString& buf, const LogString& input)
+template<> struct Lanes<2>
+{
+	enum { COUNT = 8 };
+	static __m128i set(int c)
+	{
+		return _mm_set1_epi16((short) c);
+	}
+	static __m128i equal(__m128i a, __m128i b)
+	{
+		return _mm_cmpeq_epi16(a, b);
+	}
+	static __m128i lessThan(__m128i a, int c)
+	{
+		const __m128i sign = _mm_set1_epi16((short) 0x8000);
+		return _mm_cmplt_epi16(_mm_xor_si128(a, sign), _mm_xor_si128(set(c), sign));
+	}
+};
+
+template<> struct Lanes<4>
 {
-	//Check if the string is zero length -- if so, return
-	//what was sent in.
+	enum { COUNT = 4 };
+	static __m128i set(int c)
+	{
+		return _mm_set1_epi32(c);
+	}
+	static __m128i equal(__m128i a, __m128i b)
+	{
+		return _mm_cmpeq_epi32(a, b);
+	}
+	static __m128i lessThan(__m128i a, int c)
+	{
+		const __m128i sign = _mm_set1_epi32((int) 0x80000000);
+		return _mm_cmplt_epi32(_mm_xor_si128(a, sign), _mm_xor_si128(set(c), sign));
+	}
+};
+#endif
 
-	if (input.length() == 0 )
+/**
+ *  Characters replaced by appendEscapingTags.
+ */
+struct TagSpecials
+{
+	static bool matches(logchar c)
 	{
-		return;
+		return c == 0x22 /* " */ || c == 0x26 /* & */
+			|| c == 0x3C /* < */ || c == 0x3E /* > */;
 	}
 
-	logchar specials[] = { 0x22 /* " */, 0x26 /* & */, 0x3C /* < */, 0x3E /* > */, 0x00 };
+#if LOG4CXX_TRANSFORM_SSE2
+	template<class L> static __m128i matches(__m128i chunk)
+	{
+		return _mm_or_si128(
+				_mm_or_si128(L::equal(chunk, L::set(0x22)), L::equal(chunk, L::set(0x26))),
+				_mm_or_si128(L::equal(chunk, L::set(0x3C)), L::equal(chunk, L::set(0x3E))));
+	}
+#endif
+};
+
+/**
+ *  First character of the CDATA end, "]]>".
+ */
+struct CDATASpecials
+{
+	static bool matches(logchar c)
+	{
+		return c == 0x5D /* ] */;
+	}
+
+#if LOG4CXX_TRANSFORM_SSE2
+	template<class L> static __m128i matches(__m128i chunk)
+	{
+		return L::equal(chunk, L::set(0x5D));
+	}
+#endif
+};
+
+/**
+ *  Characters escaped by appendEscapingJSON.
+ */
+struct JSONSpecials
+{
+	static bool matches(logchar c)
+	{
+		return c == 0x22 /* " */ || c == 0x5C /* \ */
+			|| (c >= 0 && c < 0x20);
+	}
+
+#if LOG4CXX_TRANSFORM_SSE2
+	template<class L> static __m128i matches(__m128i chunk)
+	{
+		return _mm_or_si128(
+				_mm_or_si128(L::equal(chunk, L::set(0x22)), L::equal(chunk, L::set(0x5C))),
+				L::lessThan(chunk, 0x20));
+	}
+#endif
+};
+
+/**
+ *  Finds the next character that Specials matches, testing 16 bytes
+ *  at a time where SSE2 is available so that long runs of ordinary
+ *  text are skipped quickly.
+ *  @return position of character or length of input.
+ */
+template<class Specials>
+size_t findSpecial(const LogString& input, size_t start)
+{
+	const logchar* data = input.data();
+	const size_t length = input.length();
+	size_t i = start;
+#if LOG4CXX_TRANSFORM_SSE2
+	typedef Lanes<sizeof(logchar)> L;
+
+	for (; i + L::COUNT <= length; i += L::COUNT)
+	{
+		__m128i chunk = _mm_loadu_si128((const __m128i*) (data + i));
+
+		if (_mm_movemask_epi8(Specials::template matches<L>(chunk)) != 0)
+		{
+			break;
+		}
+	}
+#endif
+
+	for (; i < length; i++)
+	{
+		if (Specials::matches(data[i]))
+		{
+			return i;
+		}
+	}
+
+	return length;
+}
+}
+
+void Transform::appendEscapingTags(
+	LogString& buf, const LogString& input)
+{
 	size_t start = 0;
-	size_t special = input.find_first_of(specials, start);
+	size_t special = findSpecial<TagSpecials>(input, start);
 
-	while (special != LogString::npos)
+	while (special < input.length())
 	{
 		if (special > start)
 		{
@@ -59,73 +215,115 @@ void Transform::appendEscapingTags(
 				buf.append(LOG4CXX_STR("&lt;"));
 				break;
 
-			case 0x3E:
-				buf.append(LOG4CXX_STR("&gt;"));
-				break;
-
 			default:
-				buf.append(1, input[special]);
+				buf.append(LOG4CXX_STR("&gt;"));
 				break;
 		}
 
 		start = special + 1;
-
-		if (special < input.size())
-		{
-			special = input.find_first_of(specials, start);
-		}
-		else
-		{
-			special = LogString::npos;
-		}
+		special = findSpecial<TagSpecials>(input, start);
 	}
 
-	if (start < input.size())
+	if (start < input.length())
 	{
-		buf.append(input, start, input.size() - start);
+		buf.append(input, start, input.length() - start);
 	}
 }
 
 void Transform::appendEscapingCDATA(
 	LogString& buf, const LogString& input)
 {
-	static const LogString CDATA_END(LOG4CXX_STR("]]>"));
 	static const LogString CDATA_EMBEDED_END(LOG4CXX_STR("]]>]]&gt;<![CDATA["));
 
 	const LogString::size_type CDATA_END_LEN = 3;
+	const LogString::size_type length = input.length();
+	const logchar* data = input.data();
 
+	LogString::size_type start = 0;
+	LogString::size_type bracket = findSpecial<CDATASpecials>(input, start);
 
-	if (input.length() == 0 )
+	while (bracket + CDATA_END_LEN <= length)
 	{
-		return;
+		if (data[bracket + 1] == 0x5D /* ] */ && data[bracket + 2] == 0x3E /* > */)
+		{
+			buf.append(input, start, bracket - start);
+			buf.append(CDATA_EMBEDED_END);
+			start = bracket + CDATA_END_LEN;
+			bracket = findSpecial<CDATASpecials>(input, start);
+		}
+		else
+		{
+			bracket = findSpecial<CDATASpecials>(input, bracket + 1);
+		}
 	}
 
-	LogString::size_type end = input.find(CDATA_END);
-
-	if (end == LogString::npos)
+	if (start < length)
 	{
-		buf.append(input);
-		return;
+		buf.append(input, start, length - start);
 	}
+}
 
-	LogString::size_type start = 0;
+void Transform::appendEscapingJSON(
+	LogString& buf, const LogString& input)
+{
+	const logchar hexDigits[] = { 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+			0x38, 0x39, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66
+		};
+	size_t start = 0;
+	size_t special = findSpecial<JSONSpecials>(input, start);
 
-	while (end != LogString::npos)
+	while (special < input.length())
 	{
-		buf.append(input, start, end - start);
-		buf.append(CDATA_EMBEDED_END);
-		start = end + CDATA_END_LEN;
-
-		if (start < input.length())
+		if (special > start)
 		{
-			end = input.find(CDATA_END, start);
+			buf.append(input, start, special - start);
 		}
-		else
+
+		logchar c = input[special];
+
+		switch (c)
 		{
-			return;
+			case 0x22:
+				buf.append(LOG4CXX_STR("\\\""));
+				break;
+
+			case 0x5C:
+				buf.append(LOG4CXX_STR("\\\\"));
+				break;
+
+			case 0x08:
+				buf.append(LOG4CXX_STR("\\b"));
+				break;
+
+			case 0x09:
+				buf.append(LOG4CXX_STR("\\t"));
+				break;
+
+			case 0x0A:
+				buf.append(LOG4CXX_STR("\\n"));
+				break;
+
+			case 0x0C:
+				buf.append(LOG4CXX_STR("\\f"));
+				break;
+
+			case 0x0D:
+				buf.append(LOG4CXX_STR("\\r"));
+				break;
+
+			default:
+				buf.append(LOG4CXX_STR("\\u00"));
+				buf.append(1, hexDigits[(c >> 4) & 0x0F]);
+				buf.append(1, hexDigits[c & 0x0F]);
+				break;
 		}
+
+		start = special + 1;
+		special = findSpecial<JSONSpecials>(input, start);
 	}
 
-	buf.append(input, start, input.length() - start);
+	if (start < input.length())
+	{
+		buf.append(input, start, input.length() - start);
+	}
 }
-
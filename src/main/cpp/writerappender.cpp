@@ -19,6 +19,8 @@
 #include <log4cxx/helpers/loglog.h>
 #include <log4cxx/helpers/synchronized.h>
 #include <log4cxx/layout.h>
+#include <log4cxx/binarylayout.h>
+#include <log4cxx/helpers/bytebuffer.h>
 #include <log4cxx/helpers/stringhelper.h>
 
 using namespace log4cxx;
@@ -28,6 +30,7 @@ using namespace log4cxx::spi;
 IMPLEMENT_LOG4CXX_OBJECT(WriterAppender)
 
 WriterAppender::WriterAppender()
+	: batchingType(&typeid(WriterAppender))
 {
 	LOCK_W sync(mutex);
 	immediateFlush = true;
@@ -35,7 +38,8 @@ WriterAppender::WriterAppender()
 
 WriterAppender::WriterAppender(const LayoutPtr& layout1,
 	log4cxx::helpers::WriterPtr& writer1)
-	: AppenderSkeleton(layout1), writer(writer1)
+	: AppenderSkeleton(layout1), writer(writer1),
+	  batchingType(&typeid(WriterAppender))
 {
 	Pool p;
 	LOCK_W sync(mutex);
@@ -44,7 +48,8 @@ WriterAppender::WriterAppender(const LayoutPtr& layout1,
 }
 
 WriterAppender::WriterAppender(const LayoutPtr& layout1)
-	: AppenderSkeleton(layout1)
+	: AppenderSkeleton(layout1),
+	  batchingType(&typeid(WriterAppender))
 {
 	LOCK_W sync(mutex);
 	immediateFlush = true;
@@ -243,21 +248,85 @@ void WriterAppender::setEncoding(const LogString& enc)
 
 void WriterAppender::subAppend(const spi::LoggingEventPtr& event, Pool& p)
 {
+	LOCK_W sync(mutex);
+	OutputStreamWriterPtr out(writer);
+
+	if (out != NULL)
+	{
+		//
+		//   format straight to bytes in the writer's encoding
+		//     so that each event is a single write
+		//
+		std::string bytes;
+		layout->formatBytes(bytes, event, out->getEncoder(), p);
+		writeBytes(out, bytes, p);
+		return;
+	}
+
 	LogString msg;
 	layout->format(msg, event, p);
+
+	if (writer != NULL)
 	{
-		LOCK_W sync(mutex);
+		writer->write(msg, p);
 
-		if (writer != NULL)
+		if (immediateFlush)
 		{
-			writer->write(msg, p);
+			writer->flush(p);
+		}
+	}
+}
+
+void WriterAppender::appendAll(const spi::LoggingEventList& events, Pool& p)
+{
+	if (typeid(*this) != *batchingType)
+	{
+		AppenderSkeleton::appendAll(events, p);
+		return;
+	}
 
-			if (immediateFlush)
-			{
-				writer->flush(p);
-			}
+	if (!checkEntryConditions())
+	{
+		return;
+	}
+
+	LOCK_W sync(mutex);
+	OutputStreamWriterPtr out(writer);
+
+	if (out == NULL)
+	{
+		for (LoggingEventList::const_iterator iter = events.begin();
+			iter != events.end();
+			iter++)
+		{
+			subAppend(*iter, p);
 		}
+
+		return;
 	}
+
+	//
+	//   one buffer per event, gathered into a single write
+	//
+	ByteStringList buffers(events.size());
+	const CharsetEncoderPtr& encoder = out->getEncoder();
+
+	for (size_t i = 0; i < events.size(); i++)
+	{
+		layout->formatBytes(buffers[i], events[i], encoder, p);
+	}
+
+	out->writeAll(buffers, p);
+
+	if (immediateFlush)
+	{
+		out->flush(p);
+	}
+}
+
+void WriterAppender::setBatchingType(const std::type_info& type)
+{
+	batchingType = &type;
 }
 
 
@@ -274,7 +343,17 @@ void WriterAppender::writeFooter(Pool& p)
 
 void WriterAppender::writeHeader(Pool& p)
 {
-	if (layout != NULL)
+	BinaryLayoutPtr binary(layout);
+	OutputStreamWriterPtr out(writer);
+
+	if (binary != NULL && out != NULL)
+	{
+		std::string header;
+		binary->formatHeader(header);
+		LOCK_W sync(mutex);
+		writeBytes(out, header, p);
+	}
+	else if (layout != NULL)
 	{
 		LogString header;
 		layout->appendHeader(header, p);
@@ -284,6 +363,21 @@ void WriterAppender::writeHeader(Pool& p)
 }
 
 
+void WriterAppender::writeBytes(const OutputStreamWriterPtr& out,
+	const std::string& bytes, Pool& p)
+{
+	if (!bytes.empty())
+	{
+		ByteBuffer buf(const_cast<char*>(bytes.data()), bytes.length());
+		out->write(buf, p);
+	}
+
+	if (immediateFlush)
+	{
+		out->flush(p);
+	}
+}
+
 void WriterAppender::setWriter(const WriterPtr& newWriter)
 {
 	LOCK_W sync(mutex);
@@ -0,0 +1,265 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/rolling/zstdcompressaction.h>
+#include <apr_thread_proc.h>
+#include <apr_strings.h>
+#include <log4cxx/helpers/exception.h>
+#include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/private/log4cxx_private.h>
+
+#if LOG4CXX_HAVE_ZSTD
+	#include <zstd.h>
+	#include <vector>
+#endif
+
+using namespace log4cxx;
+using namespace log4cxx::rolling;
+using namespace log4cxx::helpers;
+
+IMPLEMENT_LOG4CXX_OBJECT(ZstdCompressAction)
+
+#define ZSTD_BUFFER_SIZE 131072
+
+ZstdCompressAction::ZstdCompressAction(const File& src,
+	const File& dest,
+	bool del,
+	int lvl,
+	int thr)
+	: source(src), destination(dest), deleteSource(del), level(lvl), threads(thr)
+{
+}
+
+bool ZstdCompressAction::execute(log4cxx::helpers::Pool& p) const
+{
+	if (source.exists(p))
+	{
+#if LOG4CXX_HAVE_ZSTD
+		//
+		//   compress in-process, spreading the work over
+		//      zstd's own threads when requested
+		//
+		apr_file_t* in;
+		apr_status_t stat = source.open(&in, APR_FOPEN_READ | APR_FOPEN_BINARY,
+				APR_OS_DEFAULT, p);
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(stat);
+		}
+
+		apr_file_t* out;
+		stat = destination.open(&out, APR_FOPEN_WRITE | APR_FOPEN_CREATE |
+				APR_FOPEN_TRUNCATE | APR_FOPEN_BINARY, APR_OS_DEFAULT, p);
+
+		if (stat != APR_SUCCESS)
+		{
+			apr_file_close(in);
+			throw IOException(stat);
+		}
+
+		ZSTD_CCtx* cctx = ZSTD_createCCtx();
+
+		if (cctx == NULL)
+		{
+			apr_file_close(in);
+			apr_file_close(out);
+			throw IOException(APR_ENOMEM);
+		}
+
+		if (level != -1)
+		{
+			ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+		}
+
+		if (threads > 0)
+		{
+			//
+			//   fails harmlessly on a single-threaded libzstd
+			//
+			ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, threads);
+		}
+
+		std::vector<char> inBuf(ZSTD_BUFFER_SIZE);
+		std::vector<char> outBuf(ZSTD_BUFFER_SIZE);
+		bool finished = false;
+
+		while (stat == APR_SUCCESS && !finished)
+		{
+			apr_size_t count = inBuf.size();
+			stat = apr_file_read(in, &inBuf[0], &count);
+
+			if (stat == APR_EOF)
+			{
+				stat = APR_SUCCESS;
+				count = 0;
+			}
+
+			ZSTD_EndDirective mode = (count == 0) ? ZSTD_e_end : ZSTD_e_continue;
+			ZSTD_inBuffer input = { &inBuf[0], count, 0 };
+
+			while (stat == APR_SUCCESS)
+			{
+				ZSTD_outBuffer output = { &outBuf[0], outBuf.size(), 0 };
+				size_t remaining = ZSTD_compressStream2(cctx, &output, &input, mode);
+
+				if (ZSTD_isError(remaining))
+				{
+					stat = APR_EGENERAL;
+					break;
+				}
+
+				stat = apr_file_write_full(out, &outBuf[0], output.pos, NULL);
+
+				if (mode == ZSTD_e_end ? remaining == 0 : input.pos == input.size)
+				{
+					finished = (mode == ZSTD_e_end);
+					break;
+				}
+			}
+		}
+
+		ZSTD_freeCCtx(cctx);
+		apr_file_close(in);
+		apr_status_t closeStat = apr_file_close(out);
+
+		if (stat == APR_SUCCESS)
+		{
+			stat = closeStat;
+		}
+
+		if (stat != APR_SUCCESS)
+		{
+			destination.deleteFile(p);
+			throw IOException(stat);
+		}
+
+#else
+		apr_pool_t* aprpool = p.getAPRPool();
+		apr_procattr_t* attr;
+		apr_status_t stat = apr_procattr_create(&attr, aprpool);
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(stat);
+		}
+
+		stat = apr_procattr_io_set(attr, APR_NO_PIPE, APR_FULL_BLOCK, APR_FULL_BLOCK);
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(stat);
+		}
+
+		stat = apr_procattr_cmdtype_set(attr, APR_PROGRAM_PATH);
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(stat);
+		}
+
+		//
+		//   set child process output to destination file
+		//
+		apr_file_t* child_out;
+		apr_int32_t flags = APR_FOPEN_READ | APR_FOPEN_WRITE |
+			APR_FOPEN_CREATE | APR_FOPEN_TRUNCATE;
+		stat = destination.open(&child_out, flags, APR_OS_DEFAULT, p);
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(stat);
+		}
+
+		stat =  apr_procattr_child_out_set(attr, child_out, NULL);
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(stat);
+		}
+
+		//
+		//   redirect the child's error stream to this processes' error stream
+		//
+		apr_file_t* child_err;
+		stat = apr_file_open_stderr(&child_err, aprpool);
+
+		if (stat == APR_SUCCESS)
+		{
+			stat =  apr_procattr_child_err_set(attr, child_err, NULL);
+
+			if (stat != APR_SUCCESS)
+			{
+				throw IOException(stat);
+			}
+		}
+
+		const char** args = (const char**)
+			apr_palloc(aprpool, 8 * sizeof(*args));
+		int i = 0;
+		args[i++] = "zstd";
+		args[i++] = "-q";
+		args[i++] = "-c";
+
+		if (level > 19)
+		{
+			args[i++] = "--ultra";
+		}
+
+		if (level > 0)
+		{
+			args[i++] = apr_psprintf(aprpool, "-%d", level);
+		}
+
+		if (threads > 0)
+		{
+			args[i++] = apr_psprintf(aprpool, "-T%d", threads);
+		}
+
+		args[i++] = Transcoder::encode(source.getPath(), p);
+		args[i++] = NULL;
+
+
+		apr_proc_t pid;
+		stat = apr_proc_create(&pid, "zstd", args, NULL, attr, aprpool);
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(stat);
+		}
+
+		apr_proc_wait(&pid, NULL, NULL, APR_WAIT);
+		stat = apr_file_close(child_out);
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(stat);
+		}
+
+#endif
+
+		if (deleteSource)
+		{
+			source.deleteFile(p);
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
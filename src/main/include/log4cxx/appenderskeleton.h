@@ -85,8 +85,20 @@ class LOG4CXX_EXPORT AppenderSkeleton :
 		*/
 		virtual void append(const spi::LoggingEventPtr& event, log4cxx::helpers::Pool& p) = 0;
 
+		/**
+		Subclasses that can write several events more cheaply than one
+		at a time should override this method. The default implementation
+		calls AppenderSkeleton::append for each event in turn.
+		*/
+		virtual void appendAll(const spi::LoggingEventList& events, log4cxx::helpers::Pool& p);
+
 		void doAppendImpl(const spi::LoggingEventPtr& event, log4cxx::helpers::Pool& pool);
 
+		/**
+		Check the threshold and the filter chain for an event.
+		*/
+		bool isAccepted(const spi::LoggingEventPtr& event) const;
+
 	public:
 		DECLARE_ABSTRACT_LOG4CXX_OBJECT(AppenderSkeleton)
 		BEGIN_LOG4CXX_CAST_MAP()
@@ -193,6 +205,13 @@ class LOG4CXX_EXPORT AppenderSkeleton :
 		* */
 		virtual void doAppend(const spi::LoggingEventPtr& event, log4cxx::helpers::Pool& pool);
 
+		/**
+		* Performs the same checks as #doAppend on each event and passes
+		* the accepted events to AppenderSkeleton#appendAll together,
+		* holding the appender lock once for the whole batch.
+		* */
+		virtual void doAppendAll(const spi::LoggingEventList& events, log4cxx::helpers::Pool& pool);
+
 		/**
 		Set the {@link spi::ErrorHandler ErrorHandler} for this Appender.
 		*/
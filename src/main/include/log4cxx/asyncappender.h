@@ -31,6 +31,7 @@
 #include <log4cxx/helpers/thread.h>
 #include <log4cxx/helpers/mutex.h>
 #include <log4cxx/helpers/condition.h>
+#include <log4cxx/helpers/eventringbuffer.h>
 
 #if defined(NON_BLOCKING)
 	#include <boost/lockfree/queue.hpp>
@@ -86,6 +87,12 @@ class LOG4CXX_EXPORT AsyncAppender :
 		*/
 		void addAppender(const AppenderPtr& newAppender);
 
+		/**
+		 * Creates the event ring buffer if the <b>RingBuffer</b>
+		 * option is set.
+		 */
+		void activateOptions(log4cxx::helpers::Pool& p);
+
 		virtual void doAppend(const spi::LoggingEventPtr& event,
 			log4cxx::helpers::Pool& pool1);
 
@@ -182,6 +189,23 @@ class LOG4CXX_EXPORT AsyncAppender :
 		bool getBlocking() const;
 
 
+		/**
+		 * Sets whether events are passed to the dispatcher through a
+		 * lock-free ring buffer instead of a buffer guarded by a mutex.
+		 * The ring holds <b>BufferSize</b> events rounded up to a power
+		 * of two and is created by activateOptions; later changes to
+		 * <b>BufferSize</b> do not resize it.
+		 *
+		 * @param value true to use a ring buffer.
+		 */
+		void setRingBuffer(bool value);
+
+		/**
+		 * Gets whether events are passed through a lock-free ring buffer.
+		 * @return the current value of the <b>RingBuffer</b> option.
+		 */
+		bool getRingBuffer() const;
+
 		/**
 		 * Set appender properties by name.
 		 * @param option property name.
@@ -295,6 +319,37 @@ class LOG4CXX_EXPORT AsyncAppender :
 		*/
 		bool blocking;
 
+		/**
+		 * Should events be passed through a ring buffer.
+		*/
+		bool ringBuffer;
+
+#if !defined(NON_BLOCKING)
+		/**
+		 * Ring buffer, null unless created by activateOptions.
+		*/
+		helpers::EventRingBuffer* volatile ring;
+
+		/**
+		 * Non-zero while the dispatcher waits for bufferNotEmpty.
+		*/
+		unsigned int volatile dispatcherWaiting;
+
+		/**
+		 * Number of callers waiting for bufferNotFull.
+		*/
+		unsigned int volatile producersWaiting;
+
+		/**
+		 * Set when the discard map may hold summaries.
+		*/
+		bool volatile discardPending;
+
+		void appendToRing(const spi::LoggingEventPtr& event);
+		void discard(const spi::LoggingEventPtr& event);
+		static void dispatchRing(AsyncAppender* pThis);
+#endif
+
 		/**
 		 *  Dispatch routine.
 		 */
@@ -0,0 +1,230 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_BINARY_LAYOUT_H
+#define _LOG4CXX_BINARY_LAYOUT_H
+
+#if defined(_MSC_VER)
+	#pragma warning ( push )
+	#pragma warning ( disable: 4231 4251 4275 4786 )
+#endif
+
+
+#include <log4cxx/layout.h>
+#include <map>
+#include <string>
+
+
+
+namespace log4cxx
+{
+/**
+This layout writes each event as a compact binary record instead of
+text, so that no rendering is done when the event is logged.  The
+<code>binaryrender</code> program, or helpers::BinaryLogReader, reads
+the records back and renders them with any other layout.
+
+<p>The layout only produces records when used with an appender derived
+from WriterAppender, such as FileAppender or RollingFileAppender, that
+writes to an unbuffered output stream.  Each layout keeps the dictionary
+of the file being written so must not be shared between appenders.
+
+<p>Version 1 of the format is a sequence of records, each starting with
+a type byte.  Integers are unsigned LEB128 varints, signed values are
+zigzag encoded first, and strings are a varint length followed by UTF-8.
+
+<table border="1">
+<tr><th>Type</th><th>Contents</th></tr>
+<tr><td>0x4C, header</td><td>"4CB" and the version byte.  Starts each file
+and clears the dictionary and the previous time stamp.</td></tr>
+<tr><td>0x01, definition</td><td>string.  Gives the string the next
+dictionary id, counting from zero.</td></tr>
+<tr><td>0x02, event</td><td>flags byte, signed time stamp change in
+microseconds, level name id, signed level value, logger name id, thread
+name id and message string, followed when flagged by the NDC string
+(0x01), the file name id, function name id and line of the location
+(0x02), and a count followed by key id and value string pairs for the
+MDC (0x04) and the event properties (0x08).</td></tr>
+</table>
+
+<p>As with XMLLayout, the <b>LocationInfo</b> and <b>Properties</b>
+options control whether the location and the MDC and properties are
+recorded.
+*/
+class LOG4CXX_EXPORT BinaryLayout : public Layout
+{
+	private:
+		// Record no location info by default
+		bool locationInfo; //= false
+		bool properties; // = false
+
+		/**
+		 *  Dictionary of the file being written, location strings
+		 *  are kept apart as they are not LogStrings.  Only changed
+		 *  while the appender's lock is held.
+		 */
+		mutable std::map<LogString, unsigned int> dictionary;
+		mutable std::map<std::string, unsigned int> locationDictionary;
+		mutable log4cxx_time_t previousTime;
+
+	public:
+		enum
+		{
+			VERSION = 1,
+			HEADER = 0x4C,
+			DEFINITION = 0x01,
+			EVENT = 0x02,
+			HAS_NDC = 0x01,
+			HAS_LOCATION = 0x02,
+			HAS_MDC = 0x04,
+			HAS_PROPERTIES = 0x08,
+			/**
+			 *  A new header is written when the dictionary grows
+			 *  past this size, bounding the reader's memory.
+			 */
+			MAX_DICTIONARY_SIZE = 65536
+		};
+
+		DECLARE_LOG4CXX_OBJECT(BinaryLayout)
+		BEGIN_LOG4CXX_CAST_MAP()
+		LOG4CXX_CAST_ENTRY(BinaryLayout)
+		LOG4CXX_CAST_ENTRY_CHAIN(Layout)
+		END_LOG4CXX_CAST_MAP()
+
+		BinaryLayout();
+
+		/**
+		The <b>LocationInfo</b> option takes a boolean value. If true,
+		the file name, function name and line number of the statement
+		at the origin of the log statement are recorded.
+		*/
+		inline void setLocationInfo(bool locationInfo1)
+		{
+			this->locationInfo = locationInfo1;
+		}
+
+		/**
+		Returns the current value of the <b>LocationInfo</b> option.
+		*/
+		inline bool getLocationInfo() const
+		{
+			return locationInfo;
+		}
+
+		/**
+		The <b>Properties</b> option takes a boolean value. If true,
+		the MDC and the event properties are recorded.
+		*/
+		inline void setProperties(bool flag)
+		{
+			properties = flag;
+		}
+
+		/**
+		Returns the current value of the <b>Properties</b> option.
+		*/
+		inline bool getProperties() const
+		{
+			return properties;
+		}
+
+		/**
+		Returns the content type output by this layout,
+		i.e "application/octet-stream".
+		*/
+		virtual LogString getContentType() const
+		{
+			return LOG4CXX_STR("application/octet-stream");
+		}
+
+		/**
+		No options to activate.
+		*/
+		void activateOptions(log4cxx::helpers::Pool& /* p */) {}
+
+		/**
+		Set options
+		*/
+		virtual void setOption(const LogString& option, const LogString& value);
+
+		/**
+		Produces no text, records are written by formatBytes.
+		*/
+		virtual void format(LogString& output,
+			const spi::LoggingEventPtr& event, log4cxx::helpers::Pool& pool) const;
+
+		/**
+		Appends the record for an event, ignoring the encoder.
+		*/
+		virtual void formatBytes(std::string& output,
+			const spi::LoggingEventPtr& event,
+			const log4cxx::helpers::CharsetEncoderPtr& encoder,
+			log4cxx::helpers::Pool& pool) const;
+
+		/**
+		The binary layout does not handle the throwable contained in
+		logging events. Hence, this method return <code>true</code>.
+		*/
+		virtual bool ignoresThrowable() const
+		{
+			return true;
+		}
+
+		/**
+		 *  Appends the header that starts a file and resets the dictionary.
+		 *  @param output destination for the encoded bytes.
+		 */
+		void formatHeader(std::string& output) const;
+
+		/**
+		 *  Appends the record for an event, preceded by definitions
+		 *  of any names not yet in the dictionary.
+		 *  @param output destination for the encoded bytes.
+		 *  @param event event to record.
+		 *  @param pool pool for temporary allocations.
+		 */
+		void formatRecord(std::string& output,
+			const spi::LoggingEventPtr& event, log4cxx::helpers::Pool& pool) const;
+
+		/**
+		 *  Appends a value as an unsigned LEB128 varint.
+		 */
+		static void appendVarint(std::string& output, log4cxx_int64_t value);
+
+		/**
+		 *  Appends a zigzag encoded varint.
+		 */
+		static void appendSigned(std::string& output, log4cxx_int64_t value);
+
+	private:
+		/**
+		 *  Finds the dictionary id of a string, appending its
+		 *  definition if new.
+		 */
+		unsigned int lookup(std::string& output, const LogString& value) const;
+		unsigned int lookup(std::string& output, const char* value) const;
+		unsigned int define(std::string& output, const LogString& value) const;
+		static void appendString(std::string& output, const LogString& value);
+};
+LOG4CXX_PTR_DEF(BinaryLayout);
+}  // namespace log4cxx
+
+#if defined(_MSC_VER)
+	#pragma warning ( pop )
+#endif
+
+#endif // _LOG4CXX_BINARY_LAYOUT_H
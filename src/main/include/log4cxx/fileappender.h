@@ -62,6 +62,33 @@ class LOG4CXX_EXPORT FileAppender : public WriterAppender
 		How big should the IO buffer be? Default is 8K. */
 		int bufferSize;
 
+		/**
+		Do we hand output to a background flusher? */
+		bool groupCommit;
+
+		/**
+		How long, in milliseconds, may output wait for the flusher?
+		Default is 5. */
+		int groupCommitLatency;
+
+		/**
+		How often, in milliseconds, should the flusher or a flush of
+		a mapped file sync written output to disk?  Default is 0, never. */
+		int syncInterval;
+
+		/**
+		Do we append by copying into a memory mapping of the file? */
+		bool memoryMapped;
+
+		/**
+		By how many bytes is a mapped file extended at a time?
+		Default is 4MB. */
+		int mappedChunkSize;
+
+		/**
+		Do we submit writes through io_uring where available? */
+		bool ioUring;
+
 	public:
 		DECLARE_LOG4CXX_OBJECT(FileAppender)
 		BEGIN_LOG4CXX_CAST_MAP()
@@ -219,6 +246,121 @@ class LOG4CXX_EXPORT FileAppender : public WriterAppender
 			this->bufferSize = bufferSize1;
 		}
 
+		/**
+		Get the value of the <b>GroupCommit</b> option.
+		*/
+		inline bool getGroupCommit() const
+		{
+			return groupCommit;
+		}
+
+		/**
+		The <b>GroupCommit</b> option takes a boolean value. It is set to
+		<code>false</code> by default. If true, then output is collected
+		in memory and written by a background thread once
+		<b>BufferSize</b> bytes are waiting or the oldest has waited
+		<b>GroupCommitLatency</b> milliseconds, so that appending threads
+		rarely wait on the file.  Flushes do not wait for the write.
+		<b>BufferedIO</b> is ignored when this option is set.
+		<p>Note: Takes effect when the file is next opened.
+		*/
+		void setGroupCommit(bool groupCommit1);
+
+		/**
+		Get the value of the <b>GroupCommitLatency</b> option.
+		*/
+		inline int getGroupCommitLatency() const
+		{
+			return groupCommitLatency;
+		}
+
+		/**
+		Set the longest time, in milliseconds, that output may wait
+		before the background thread writes it.
+		*/
+		void setGroupCommitLatency(int groupCommitLatency1)
+		{
+			this->groupCommitLatency = groupCommitLatency1;
+		}
+
+		/**
+		Get the value of the <b>SyncInterval</b> option.
+		*/
+		inline int getSyncInterval() const
+		{
+			return syncInterval;
+		}
+
+		/**
+		Set how often, in milliseconds, output written by the
+		<b>GroupCommit</b> thread, or copied into a <b>MemoryMapped</b>
+		file, is forced to the storage device.
+		Zero, the default, leaves that to the operating system.
+		*/
+		void setSyncInterval(int syncInterval1)
+		{
+			this->syncInterval = syncInterval1;
+		}
+
+		/**
+		Get the value of the <b>MemoryMapped</b> option.
+		*/
+		inline bool getMemoryMapped() const
+		{
+			return memoryMapped;
+		}
+
+		/**
+		The <b>MemoryMapped</b> option takes a boolean value. It is set to
+		<code>false</code> by default. If true, the file is extended
+		<b>MappedChunkSize</b> bytes at a time and output is copied into
+		a memory mapping of it rather than written with a system call.
+		The file is truncated to the length of the output when it is
+		closed or rolled over.  <b>BufferedIO</b> and <b>GroupCommit</b>
+		are ignored when this option is set.
+		<p>Note: Takes effect when the file is next opened.
+		*/
+		void setMemoryMapped(bool memoryMapped1);
+
+		/**
+		Get the value of the <b>MappedChunkSize</b> option.
+		*/
+		inline int getMappedChunkSize() const
+		{
+			return mappedChunkSize;
+		}
+
+		/**
+		Set the number of bytes by which a <b>MemoryMapped</b> file is
+		extended and mapped at a time.  With a SizeBasedTriggeringPolicy,
+		a size of at least <b>MaxFileSize</b> maps each file once.
+		*/
+		void setMappedChunkSize(int mappedChunkSize1)
+		{
+			this->mappedChunkSize = mappedChunkSize1;
+		}
+
+		/**
+		Get the value of the <b>IOUring</b> option.
+		*/
+		inline bool getIOUring() const
+		{
+			return ioUring;
+		}
+
+		/**
+		The <b>IOUring</b> option takes a boolean value. It is set to
+		<code>false</code> by default. If true and log4cxx was built with
+		liburing, output is copied into <b>BufferSize</b> byte segments
+		that are written through an io_uring, so that appending threads
+		do not wait for the disk.  Where the running kernel does not
+		support io_uring a warning is logged and the file is written
+		as usual.  <b>BufferedIO</b> and <b>GroupCommit</b> are ignored
+		when io_uring is used.
+		<p>Note: Takes effect when the file is next opened.
+		*/
+		void setIOUring(bool ioUring1);
+
 		/**
 		 *   Replaces double backslashes with single backslashes
 		 *   for compatibility with paths from earlier XML configurations files.
@@ -227,6 +369,17 @@ class LOG4CXX_EXPORT FileAppender : public WriterAppender
 		 */
 		static LogString stripDuplicateBackslashes(const LogString& name);
 
+	protected:
+		/**
+		 *   Opens the file and, if <b>GroupCommit</b> is set, wraps it
+		 *   in a stream that writes from a background thread.
+		 *   @param filename file name
+		 *   @param append true to append to an existing file
+		 *   @return new output stream
+		 *   @throws IOException if the file cannot be opened
+		 */
+		helpers::OutputStreamPtr createOutputStream(const LogString& filename, bool append);
+
 	private:
 		FileAppender(const FileAppender&);
 		FileAppender& operator=(const FileAppender&);
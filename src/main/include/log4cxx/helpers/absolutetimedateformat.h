@@ -18,7 +18,7 @@
 #ifndef _LOG4CXX_HELPERS_ABSOLUTE_TIME_DATE_FORMAT_H
 #define _LOG4CXX_HELPERS_ABSOLUTE_TIME_DATE_FORMAT_H
 
-#include <log4cxx/helpers/simpledateformat.h>
+#include <log4cxx/helpers/fixeddateformat.h>
 
 namespace log4cxx
 {
@@ -28,11 +28,11 @@ namespace helpers
 Formats a date in the format <b>HH:mm:ss,SSS</b> for example,
 "15:49:37,459".
 */
-class LOG4CXX_EXPORT AbsoluteTimeDateFormat : public SimpleDateFormat
+class LOG4CXX_EXPORT AbsoluteTimeDateFormat : public FixedDateFormat
 {
 	public:
 		AbsoluteTimeDateFormat()
-			: SimpleDateFormat(LOG4CXX_STR("HH:mm:ss,SSS")) {}
+			: FixedDateFormat(FixedDateFormat::ABSOLUTE) {}
 };
 }  // namespace helpers
 } // namespace log4cxx
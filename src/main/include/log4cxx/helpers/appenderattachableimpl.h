@@ -35,6 +35,7 @@ namespace spi
 {
 class LoggingEvent;
 typedef helpers::ObjectPtrT<LoggingEvent> LoggingEventPtr;
+typedef std::vector<LoggingEventPtr> LoggingEventList;
 }
 
 namespace helpers
@@ -76,6 +77,13 @@ class LOG4CXX_EXPORT AppenderAttachableImpl :
 		int appendLoopOnAppenders(const spi::LoggingEventPtr& event,
 			log4cxx::helpers::Pool& p);
 
+		/**
+		 Pass a batch of events to each attached appender, through
+		 AppenderSkeleton#doAppendAll where the appender supports it.
+		*/
+		int appendLoopOnAppenders(const spi::LoggingEventList& events,
+			log4cxx::helpers::Pool& p);
+
 		/**
 		 * Get all previously added appenders as an Enumeration.
 		 */
@@ -0,0 +1,95 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_HELPERS_BINARY_LOG_READER_H
+#define _LOG4CXX_HELPERS_BINARY_LOG_READER_H
+
+#if defined(_MSC_VER)
+	#pragma warning ( push )
+	#pragma warning ( disable: 4231 4251 4275 4786 )
+#endif
+
+#include <log4cxx/helpers/objectimpl.h>
+#include <log4cxx/helpers/inputstream.h>
+#include <log4cxx/spi/loggingevent.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace log4cxx
+{
+namespace helpers
+{
+/**
+ *  Reads back the events written by BinaryLayout.  The file and
+ *  function names in the location information of the events are
+ *  interned by InternedStrings, so like the string literals of
+ *  LOG4CXX_LOCATION they remain valid after the reader is destroyed.
+ */
+class LOG4CXX_EXPORT BinaryLogReader : public ObjectImpl
+{
+	public:
+		DECLARE_ABSTRACT_LOG4CXX_OBJECT(BinaryLogReader)
+		BEGIN_LOG4CXX_CAST_MAP()
+		LOG4CXX_CAST_ENTRY(BinaryLogReader)
+		END_LOG4CXX_CAST_MAP()
+
+		BinaryLogReader(const InputStreamPtr& in);
+		~BinaryLogReader();
+
+		/**
+		 *  Reads the next event.
+		 *  @return the event, or null at the end of the input.
+		 *  @throws IOException if the input is not in the format
+		 *  written by BinaryLayout or is truncated.
+		 */
+		spi::LoggingEventPtr read();
+
+	private:
+		InputStreamPtr in;
+		std::vector<char> buffer;
+		size_t position;
+		size_t limit;
+
+		std::vector<LogString> dictionary;
+		std::vector<const char*> locations;
+		std::map<LogString, ThreadNamePtr> threadNames;
+		log4cxx_time_t previousTime;
+
+		int readByte();
+		int requireByte();
+		log4cxx_int64_t readVarint();
+		log4cxx_int64_t readSigned();
+		void readString(LogString& value);
+		const LogString& lookup(log4cxx_int64_t id) const;
+		const char* lookupLocation(log4cxx_int64_t id);
+		LevelPtr toLevel(const LogString& name, int value) const;
+		void readMap(MDC::Map& map);
+
+		BinaryLogReader(const BinaryLogReader&);
+		BinaryLogReader& operator=(const BinaryLogReader&);
+};
+
+LOG4CXX_PTR_DEF(BinaryLogReader);
+} // namespace helpers
+}  //namespace log4cxx
+
+#if defined(_MSC_VER)
+	#pragma warning ( pop )
+#endif
+
+#endif //_LOG4CXX_HELPERS_BINARY_LOG_READER_H
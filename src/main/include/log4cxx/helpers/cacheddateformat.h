@@ -85,34 +85,28 @@ class LOG4CXX_EXPORT CachedDateFormat : public log4cxx::helpers::DateFormat
 		log4cxx::helpers::DateFormatPtr formatter;
 
 		/**
-		 *  Index of initial digit of millisecond pattern or
-		 *   UNRECOGNIZED_MILLISECONDS or NO_MILLISECONDS.
-		 */
-		mutable int millisecondStart;
-
-		/**
-		 *  Integral second preceding the previous convered Date.
+		 *  Maximum validity period for the cache.
+		 *  Typically 1, use cache for duplicate requests only, or
+		 *  1000000, use cache for requests within the same integral second.
 		 */
-		mutable log4cxx_time_t slotBegin;
-
+		const int expiration;
 
 		/**
-		 *  Cache of previous conversion.
+		 *  Number of cache slots, a power of two.
 		 */
-		mutable LogString cache;
-
+		enum { SLOT_COUNT = 16 };
 
 		/**
-		 *  Maximum validity period for the cache.
-		 *  Typically 1, use cache for duplicate requests only, or
-		 *  1000000, use cache for requests within the same integral second.
+		 *  A previous conversion and the state needed to reuse it.
 		 */
-		const int expiration;
+		struct Slot;
 
 		/**
-		 *  Date requested in previous conversion.
+		 *  Cache slots.  Each thread starts from the slot picked by
+		 *  its thread id and takes the first one that is not in use,
+		 *  so concurrent callers never wait for each other.
 		 */
-		mutable log4cxx_time_t previousTime;
+		Slot* const slots;
 
 	public:
 		/**
@@ -125,6 +119,8 @@ class LOG4CXX_EXPORT CachedDateFormat : public log4cxx::helpers::DateFormat
 		 */
 		CachedDateFormat(const log4cxx::helpers::DateFormatPtr& dateFormat, int expiration);
 
+		~CachedDateFormat();
+
 		/**
 		 * Finds start of millisecond field in formatted time.
 		 * @param time long time, must be integral number of seconds
@@ -152,6 +148,18 @@ class LOG4CXX_EXPORT CachedDateFormat : public log4cxx::helpers::DateFormat
 			log4cxx::helpers::Pool& p) const;
 
 	private:
+		/**
+		 * Formats a Date using and updating one cache slot.
+		 */
+		void format(Slot& slot, LogString& sbuf,
+			log4cxx_time_t date,
+			log4cxx::helpers::Pool& p) const;
+
+		/**
+		 * Gets the slot at which the calling thread starts looking.
+		 */
+		static unsigned int getSlotIndex();
+
 		/**
 		 *   Formats a count of milliseconds (0-999) into a numeric representation.
 		 *   @param millis Millisecond coun between 0 and 999.
@@ -97,6 +97,21 @@ class LOG4CXX_EXPORT CharsetEncoder : public ObjectImpl
 			LogString::const_iterator& iter,
 			ByteBuffer& out) = 0;
 
+		/**
+		 * Encodes all of a string in one pass, appending to the output
+		 *   and replacing unmappable characters as encode does.
+		 *  @param in input string
+		 *  @param out bytes are appended.
+		 */
+		virtual void encodeAll(const LogString& in, std::string& out);
+
+		/**
+		 *  Determines if the encoded bytes are the same as the
+		 *    LogString's own representation, so that text can be
+		 *    written without conversion.
+		 */
+		virtual bool isTrivial() const;
+
 		/**
 		 *   Resets any internal state.
 		 */
@@ -62,6 +62,17 @@ class LOG4CXX_EXPORT Condition
 		 */
 		void await(Mutex& lock);
 
+		/**
+		 *  Await signaling of condition for a limited time.
+		 *  @param lock lock associated with condition, calling thread must
+		 *  own lock.  Lock will be released while waiting and reacquired
+		 *  before returning from wait.
+		 *  @param timeout maximum time to wait in microseconds.
+		 *  @return false if the time elapsed without a signal.
+		 *  @throws InterruptedException if thread is interrupted.
+		 */
+		bool await(Mutex& lock, log4cxx_time_t timeout);
+
 	private:
 		apr_thread_cond_t* condition;
 		Condition(const Condition&);
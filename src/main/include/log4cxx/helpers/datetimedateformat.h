@@ -18,7 +18,7 @@
 #ifndef _LOG4CXX_HELPERS_DATE_TIME_DATE_FORMAT_H
 #define _LOG4CXX_HELPERS_DATE_TIME_DATE_FORMAT_H
 
-#include <log4cxx/helpers/simpledateformat.h>
+#include <log4cxx/helpers/fixeddateformat.h>
 
 namespace log4cxx
 {
@@ -28,13 +28,13 @@ namespace helpers
 Formats a date in the format <b>dd MMM yyyy HH:mm:ss,SSS</b> for example,
 "06 Nov 1994 15:49:37,459".
 */
-class LOG4CXX_EXPORT DateTimeDateFormat : public SimpleDateFormat
+class LOG4CXX_EXPORT DateTimeDateFormat : public FixedDateFormat
 {
 	public:
 		DateTimeDateFormat()
-			: SimpleDateFormat(LOG4CXX_STR("dd MMM yyyy HH:mm:ss,SSS")) {}
+			: FixedDateFormat(FixedDateFormat::DATE) {}
 		DateTimeDateFormat(const std::locale* locale)
-			: SimpleDateFormat(LOG4CXX_STR("dd MMM yyyy HH:mm:ss,SSS"), locale) {}
+			: FixedDateFormat(FixedDateFormat::DATE, locale) {}
 };
 }  // namespace helpers
 } // namespace log4cxx
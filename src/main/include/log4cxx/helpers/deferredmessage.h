@@ -0,0 +1,293 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_HELPERS_DEFERRED_MESSAGE_H
+#define _LOG4CXX_HELPERS_DEFERRED_MESSAGE_H
+
+#include <log4cxx/logstring.h>
+#include <string>
+#include <string.h>
+#if LOG4CXX_WCHAR_T_API
+	#include <wchar.h>
+#endif
+
+
+namespace log4cxx
+{
+namespace helpers
+{
+/**
+ *  A logging request's format string and arguments, captured so that
+ *  the message can be rendered later, typically by the layout on
+ *  AsyncAppender's dispatcher thread rather than on the caller's.
+ *
+ *  <p>The format string is kept by pointer and must outlive the
+ *  event, as a string literal does.  Each "{}" in it is replaced by
+ *  the next argument, and "{{" and "}}" stand for literal braces.
+ *  Arithmetic, character and pointer arguments are copied in binary
+ *  form; strings are copied.
+ *
+ *  <p>Instances are normally created by the LOG4CXX_INFO_FMT family
+ *  of macros.
+ */
+class LOG4CXX_EXPORT DeferredMessage
+{
+	public:
+		explicit DeferredMessage(const char* format);
+		DeferredMessage(const DeferredMessage& src);
+		~DeferredMessage();
+
+		inline const char* getFormat() const
+		{
+			return format;
+		}
+
+		/**
+		 *  Appends the message with each placeholder replaced
+		 *  by its argument.
+		 */
+		void render(LogString& dest) const;
+
+		/**
+		 *  Discards the arguments, freeing any storage
+		 *  they took beyond the inline buffer.
+		 */
+		void clear();
+
+		inline void add(bool value)
+		{
+			char v = value ? 1 : 0;
+			put(BOOLEAN, &v, sizeof(v));
+		}
+		inline void add(char value)
+		{
+			put(CHARACTER, &value, sizeof(value));
+		}
+		inline void add(int value)
+		{
+			addSigned(value);
+		}
+		inline void add(unsigned int value)
+		{
+			addUnsigned(value);
+		}
+		inline void add(long value)
+		{
+			addSigned(value);
+		}
+		inline void add(unsigned long value)
+		{
+			addUnsigned(value);
+		}
+		inline void add(long long value)
+		{
+			addSigned(value);
+		}
+		inline void add(unsigned long long value)
+		{
+			addUnsigned(value);
+		}
+		inline void add(double value)
+		{
+			put(FLOATING, &value, sizeof(value));
+		}
+		inline void add(long double value)
+		{
+			add((double) value);
+		}
+		inline void add(const void* value)
+		{
+			put(POINTER, &value, sizeof(value));
+		}
+		inline void add(const char* value)
+		{
+			putString(STRING, value, value == 0 ? 0 : strlen(value));
+		}
+		inline void add(const std::string& value)
+		{
+			putString(STRING, value.data(), value.length());
+		}
+#if LOG4CXX_WCHAR_T_API
+		inline void add(wchar_t value)
+		{
+			put(WIDE_CHARACTER, &value, sizeof(value));
+		}
+		inline void add(const wchar_t* value)
+		{
+			putString(WIDE_STRING, value,
+				value == 0 ? 0 : wcslen(value) * sizeof(wchar_t));
+		}
+		inline void add(const std::wstring& value)
+		{
+			putString(WIDE_STRING, value.data(), value.length() * sizeof(wchar_t));
+		}
+#endif
+
+		static DeferredMessage capture(const char* format)
+		{
+			return DeferredMessage(format);
+		}
+		template<typename A1>
+		static DeferredMessage capture(const char* format, const A1& a1)
+		{
+			DeferredMessage msg(format);
+			msg.add(a1);
+			return msg;
+		}
+		template<typename A1, typename A2>
+		static DeferredMessage capture(const char* format,
+			const A1& a1, const A2& a2)
+		{
+			DeferredMessage msg(format);
+			msg.add(a1);
+			msg.add(a2);
+			return msg;
+		}
+		template<typename A1, typename A2, typename A3>
+		static DeferredMessage capture(const char* format,
+			const A1& a1, const A2& a2, const A3& a3)
+		{
+			DeferredMessage msg(format);
+			msg.add(a1);
+			msg.add(a2);
+			msg.add(a3);
+			return msg;
+		}
+		template<typename A1, typename A2, typename A3, typename A4>
+		static DeferredMessage capture(const char* format,
+			const A1& a1, const A2& a2, const A3& a3, const A4& a4)
+		{
+			DeferredMessage msg(format);
+			msg.add(a1);
+			msg.add(a2);
+			msg.add(a3);
+			msg.add(a4);
+			return msg;
+		}
+		template<typename A1, typename A2, typename A3, typename A4,
+			typename A5>
+		static DeferredMessage capture(const char* format,
+			const A1& a1, const A2& a2, const A3& a3, const A4& a4,
+			const A5& a5)
+		{
+			DeferredMessage msg(format);
+			msg.add(a1);
+			msg.add(a2);
+			msg.add(a3);
+			msg.add(a4);
+			msg.add(a5);
+			return msg;
+		}
+		template<typename A1, typename A2, typename A3, typename A4,
+			typename A5, typename A6>
+		static DeferredMessage capture(const char* format,
+			const A1& a1, const A2& a2, const A3& a3, const A4& a4,
+			const A5& a5, const A6& a6)
+		{
+			DeferredMessage msg(format);
+			msg.add(a1);
+			msg.add(a2);
+			msg.add(a3);
+			msg.add(a4);
+			msg.add(a5);
+			msg.add(a6);
+			return msg;
+		}
+		template<typename A1, typename A2, typename A3, typename A4,
+			typename A5, typename A6, typename A7>
+		static DeferredMessage capture(const char* format,
+			const A1& a1, const A2& a2, const A3& a3, const A4& a4,
+			const A5& a5, const A6& a6, const A7& a7)
+		{
+			DeferredMessage msg(format);
+			msg.add(a1);
+			msg.add(a2);
+			msg.add(a3);
+			msg.add(a4);
+			msg.add(a5);
+			msg.add(a6);
+			msg.add(a7);
+			return msg;
+		}
+		template<typename A1, typename A2, typename A3, typename A4,
+			typename A5, typename A6, typename A7, typename A8>
+		static DeferredMessage capture(const char* format,
+			const A1& a1, const A2& a2, const A3& a3, const A4& a4,
+			const A5& a5, const A6& a6, const A7& a7, const A8& a8)
+		{
+			DeferredMessage msg(format);
+			msg.add(a1);
+			msg.add(a2);
+			msg.add(a3);
+			msg.add(a4);
+			msg.add(a5);
+			msg.add(a6);
+			msg.add(a7);
+			msg.add(a8);
+			return msg;
+		}
+
+	private:
+		enum Type
+		{
+			BOOLEAN, CHARACTER, SIGNED, UNSIGNED, FLOATING, POINTER,
+			STRING, WIDE_CHARACTER, WIDE_STRING
+		};
+
+		/**
+		 *  Arguments fitting in this many bytes are kept
+		 *  without a heap allocation.
+		 */
+		enum { INLINE_CAPACITY = 64 };
+
+		const char* const format;
+		char* buffer;
+		size_t length;
+		size_t capacity;
+		char inlineBuffer[INLINE_CAPACITY];
+
+		inline void addSigned(long long value)
+		{
+			put(SIGNED, &value, sizeof(value));
+		}
+		inline void addUnsigned(unsigned long long value)
+		{
+			put(UNSIGNED, &value, sizeof(value));
+		}
+		inline void put(Type type, const void* value, size_t size)
+		{
+			if (length + size + 1 > capacity)
+			{
+				reserve(size + 1);
+			}
+
+			buffer[length++] = (char) type;
+			memcpy(buffer + length, value, size);
+			length += size;
+		}
+		void putString(Type type, const void* value, size_t size);
+		void reserve(size_t size);
+		void renderArgument(size_t& offset, LogString& dest) const;
+
+		DeferredMessage& operator=(const DeferredMessage&);
+};
+
+}
+}
+
+
+#endif
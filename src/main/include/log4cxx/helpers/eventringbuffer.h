@@ -0,0 +1,100 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _LOG4CXX_HELPERS_EVENT_RING_BUFFER_H
+#define _LOG4CXX_HELPERS_EVENT_RING_BUFFER_H
+
+#include <log4cxx/spi/loggingevent.h>
+
+namespace log4cxx
+{
+namespace helpers
+{
+/**
+EventRingBuffer is a bounded queue of
+{@link log4cxx::spi::LoggingEvent LoggingEvent} instances which any
+number of threads may add to without locking, while a single thread
+takes events off.
+
+<p>Each slot carries a sequence number that tells producers whether
+it is free and the consumer whether it has been filled, so that
+producers only contend on the enqueue position and never on the
+consumer.  The two positions are kept on separate cache lines.
+*/
+class LOG4CXX_EXPORT EventRingBuffer
+{
+	public:
+		/**
+		Instantiate a new EventRingBuffer holding at least
+		<code>capacity</code> events.  The capacity is rounded up
+		to a power of two.
+		@param capacity The minimum number of events in the buffer.
+		@throws IllegalArgumentException if <code>capacity</code>
+		is not positive.
+		*/
+		EventRingBuffer(int capacity);
+		~EventRingBuffer();
+
+		/**
+		Add an <code>event</code> as the last event in the buffer.
+		May be called by any thread.
+		@return false if the buffer is full.
+		*/
+		bool offer(const spi::LoggingEventPtr& event);
+
+		/**
+		Remove up to <code>maxCount</code> of the oldest events and
+		append them to <code>dest</code>.  Must only be called by
+		the consuming thread.
+		@return number of events removed.
+		*/
+		size_t drain(spi::LoggingEventList& dest, size_t maxCount);
+
+		/**
+		Determine whether there is an event to be taken.  Must only
+		be called by the consuming thread.
+		*/
+		bool isEmpty() const;
+
+		int getCapacity() const
+		{
+			return (int) (mask + 1);
+		}
+
+	private:
+		struct Slot
+		{
+			unsigned int volatile sequence;
+			spi::LoggingEvent* volatile event;
+		};
+
+		enum { CACHE_LINE_SIZE = 64 };
+
+		Slot* slots;
+		unsigned int mask;
+		char pad0[CACHE_LINE_SIZE];
+		unsigned int volatile enqueuePosition;
+		char pad1[CACHE_LINE_SIZE];
+		unsigned int dequeuePosition;
+		char pad2[CACHE_LINE_SIZE];
+
+		EventRingBuffer(const EventRingBuffer&);
+		EventRingBuffer& operator=(const EventRingBuffer&);
+}; // class EventRingBuffer
+}  //namespace helpers
+} //namespace log4cxx
+
+#endif //_LOG4CXX_HELPERS_EVENT_RING_BUFFER_H
@@ -53,6 +53,18 @@ class LOG4CXX_EXPORT FileOutputStream : public OutputStream
 		virtual void flush(Pool& p);
 		virtual void write(ByteBuffer& buf, Pool& p);
 
+		/**
+		 *  Writes the buffers with as few calls to apr_file_writev
+		 *  as the system's limit on gathered buffers allows.
+		 */
+		virtual void writeAll(const ByteStringList& buffers, Pool& p);
+
+		/**
+		 *  Forces data written so far to the storage device.
+		 *  @param p memory pool for operation.
+		 */
+		void sync(Pool& p);
+
 #ifdef LOG4CXX_MULTI_PROCESS
 		apr_file_t* getFilePtr()
 		{
@@ -0,0 +1,112 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_HELPERS_FIXED_DATE_FORMAT_H
+#define _LOG4CXX_HELPERS_FIXED_DATE_FORMAT_H
+
+#include <log4cxx/helpers/simpledateformat.h>
+#include <vector>
+
+#if defined(_MSC_VER)
+	#pragma warning ( push )
+	#pragma warning ( disable: 4251 )
+#endif
+
+namespace log4cxx
+{
+namespace helpers
+{
+
+/**
+ * Formats one of the built-in date layouts with integer arithmetic.
+ *
+ * <p>The calendar fields are computed from the day count directly
+ * and the digits are written from a table, so a conversion does not
+ * explode the time or walk a token list.  The offset from UTC is looked
+ * up once per quarter hour.  Dates the arithmetic does not cover, such as
+ * those before 1970, are formatted by the SimpleDateFormat base class.</p>
+ */
+class LOG4CXX_EXPORT FixedDateFormat : public SimpleDateFormat
+{
+	public:
+		enum Style
+		{
+			/**
+			 * yyyy-MM-dd HH:mm:ss,SSS
+			 */
+			ISO8601,
+			/**
+			 * yyyy-MM-dd HH:mm:ss,SSSSSS, with microseconds.
+			 */
+			ISO8601_MICROS,
+			/**
+			 * HH:mm:ss,SSS
+			 */
+			ABSOLUTE,
+			/**
+			 * dd MMM yyyy HH:mm:ss,SSS
+			 */
+			DATE
+		};
+
+		FixedDateFormat(Style style);
+		FixedDateFormat(Style style, const std::locale* locale);
+
+		virtual void format(LogString& s,
+			log4cxx_time_t tm,
+			log4cxx::helpers::Pool& p) const;
+
+		/**
+		 * Set time zone.
+		 * @param zone new time zone.
+		 */
+		void setTimeZone(const TimeZonePtr& zone);
+
+	private:
+		const Style style;
+
+		/**
+		 * Time zone, as given to the base class.
+		 */
+		TimeZonePtr timeZone;
+
+		/**
+		 * Abbreviated month names, for DATE.
+		 */
+		std::vector<LogString> monthNames;
+
+		/**
+		 * Quarter hour since 1970 in the upper 24 bits and the
+		 * offset from UTC in quarter hours, plus 128, in the lower 8 bits.
+		 * 0 if nothing is cached.
+		 */
+		mutable volatile unsigned int offsetCache;
+
+		static LogString getPattern(Style style);
+		void setMonthNames(SimpleDateFormat& monthFormat);
+		bool getOffset(log4cxx_time_t tm, int& offset) const;
+};
+LOG4CXX_PTR_DEF(FixedDateFormat);
+
+}  // namespace helpers
+} // namespace log4cxx
+
+#if defined(_MSC_VER)
+	#pragma warning ( pop )
+#endif
+
+#endif // _LOG4CXX_HELPERS_FIXED_DATE_FORMAT_H
@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_HELPERS_GROUPCOMMITOUTPUTSTREAM_H
+#define _LOG4CXX_HELPERS_GROUPCOMMITOUTPUTSTREAM_H
+
+#include <log4cxx/helpers/outputstream.h>
+#include <log4cxx/helpers/pool.h>
+#include <log4cxx/helpers/mutex.h>
+#include <log4cxx/helpers/condition.h>
+#include <log4cxx/helpers/thread.h>
+
+namespace log4cxx
+{
+
+namespace helpers
+{
+
+/**
+*   OutputStream that collects writes in memory and hands them to
+*   another stream from a background thread.
+*
+*   <p>Writers append to an active buffer.  A flusher thread swaps it
+*   with a second buffer and writes that out once the active buffer
+*   holds <code>threshold</code> bytes or its oldest byte has waited
+*   <code>maxLatency</code> milliseconds, so many small writes become
+*   one write to the file.  When <code>syncInterval</code> is positive,
+*   data written to a FileOutputStream is also forced to the storage
+*   device at most that many milliseconds after it was written.
+*
+*   <p>flush does not wait for the flusher: output becomes visible
+*   within the latency bound.  close writes everything still buffered
+*   before closing the wrapped stream.
+*/
+class LOG4CXX_EXPORT GroupCommitOutputStream : public OutputStream
+{
+	public:
+		DECLARE_ABSTRACT_LOG4CXX_OBJECT(GroupCommitOutputStream)
+		BEGIN_LOG4CXX_CAST_MAP()
+		LOG4CXX_CAST_ENTRY(GroupCommitOutputStream)
+		LOG4CXX_CAST_ENTRY_CHAIN(OutputStream)
+		END_LOG4CXX_CAST_MAP()
+
+		/**
+		*   Creates a new instance and starts its flusher thread.
+		*   @param out stream that receives the buffered output.
+		*   @param threshold buffered bytes that trigger a write.
+		*   @param maxLatency milliseconds a byte may stay buffered.
+		*   @param syncInterval milliseconds between syncs of the
+		*   written data, zero to never sync.
+		*/
+		GroupCommitOutputStream(const OutputStreamPtr& out,
+			size_t threshold, int maxLatency, int syncInterval);
+		virtual ~GroupCommitOutputStream();
+
+		virtual void close(Pool& p);
+		virtual void flush(Pool& p);
+		virtual void write(ByteBuffer& buf, Pool& p);
+		virtual void writeAll(const ByteStringList& buffers, Pool& p);
+
+	private:
+		Pool pool;
+		Mutex mutex;
+		Condition pendingData;
+		Condition bufferSpace;
+		OutputStreamPtr out;
+		const size_t threshold;
+		const log4cxx_time_t maxLatency;
+		const log4cxx_time_t syncInterval;
+		std::string active;
+		std::string writing;
+		log4cxx_time_t oldest;
+		log4cxx_time_t unsynced;
+		bool idle;
+		bool closed;
+		Thread flusher;
+
+		void append(const char* data, size_t length);
+		void stop(Pool& p);
+		bool commitNext(Pool& p);
+		void writeOut(std::string& data, Pool& p);
+		void sync(Pool& p);
+		static void* LOG4CXX_THREAD_FUNC commit(apr_thread_t* thread, void* data);
+
+		GroupCommitOutputStream(const GroupCommitOutputStream&);
+		GroupCommitOutputStream& operator=(const GroupCommitOutputStream&);
+};
+
+LOG4CXX_PTR_DEF(GroupCommitOutputStream);
+} // namespace helpers
+
+}  //namespace log4cxx
+
+#endif //_LOG4CXX_HELPERS_GROUPCOMMITOUTPUTSTREAM_H
@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_HELPERS_INTERNED_STRINGS_H
+#define _LOG4CXX_HELPERS_INTERNED_STRINGS_H
+
+#include <log4cxx/logstring.h>
+
+namespace log4cxx
+{
+namespace helpers
+{
+/**
+ *  Process-wide sets of strings that are never freed, so that an
+ *  interned string can be identified by its address alone.  Equal
+ *  strings are interned at the same address.  May be called by any
+ *  thread; interning takes no lock.
+ */
+class LOG4CXX_EXPORT InternedStrings
+{
+	public:
+		/**
+		Returns the interned copy of <code>value</code>.
+		*/
+		static const LogString* intern(const LogString& value);
+
+		/**
+		Returns the interned, null terminated copy of the
+		<code>length</code> characters at <code>value</code>.
+		*/
+		static const char* intern(const char* value, size_t length);
+
+	private:
+		InternedStrings();
+		InternedStrings(const InternedStrings&);
+		InternedStrings& operator=(const InternedStrings&);
+};
+}
+}
+
+#endif //_LOG4CXX_HELPERS_INTERNED_STRINGS_H
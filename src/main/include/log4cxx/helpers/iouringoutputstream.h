@@ -0,0 +1,135 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_HELPERS_IOURINGOUTPUTSTREAM_H
+#define _LOG4CXX_HELPERS_IOURINGOUTPUTSTREAM_H
+
+#include <log4cxx/helpers/outputstream.h>
+#include <log4cxx/helpers/pool.h>
+#include <log4cxx/helpers/mutex.h>
+#include <log4cxx/helpers/condition.h>
+#include <log4cxx/helpers/thread.h>
+
+extern "C" {
+	struct apr_file_t;
+	struct io_uring;
+}
+
+namespace log4cxx
+{
+
+namespace helpers
+{
+
+/**
+*   OutputStream that writes a file through a Linux io_uring, so that
+*   writers copy into memory and never wait in write(2).
+*
+*   <p>Output is copied into one of a fixed set of segments, registered
+*   with the kernel where the memory limits allow.  A full segment is
+*   submitted at once; after a flush the partly filled segment is
+*   submitted as soon as no other write is in flight, so writes that
+*   arrive while the disk is busy go out together.  A background thread
+*   reaps completions and resubmits short writes.  Writers wait only
+*   when every segment is in flight.  Each write carries its own file
+*   offset, so the file must not be shared with other writers.
+*
+*   <p>A write error is reported by the next write, flush or close.
+*   close waits for all submitted writes.  Available only when log4cxx
+*   is built with liburing; use #isAvailable before constructing.
+*/
+class LOG4CXX_EXPORT IOUringOutputStream : public OutputStream
+{
+	public:
+		DECLARE_ABSTRACT_LOG4CXX_OBJECT(IOUringOutputStream)
+		BEGIN_LOG4CXX_CAST_MAP()
+		LOG4CXX_CAST_ENTRY(IOUringOutputStream)
+		LOG4CXX_CAST_ENTRY_CHAIN(OutputStream)
+		END_LOG4CXX_CAST_MAP()
+
+		/**
+		*   Opens the file and starts the completion thread.
+		*   @param filename file name.
+		*   @param append if false, the file is truncated.
+		*   @param segmentSize bytes in each segment.
+		*   @param segmentCount number of segments.
+		*   @throws IOException if the file cannot be opened or
+		*   io_uring cannot be set up.
+		*/
+		IOUringOutputStream(const LogString& filename, bool append,
+			size_t segmentSize, int segmentCount);
+		virtual ~IOUringOutputStream();
+
+		virtual void close(Pool& p);
+		virtual void flush(Pool& p);
+		virtual void write(ByteBuffer& buf, Pool& p);
+		virtual void writeAll(const ByteStringList& buffers, Pool& p);
+
+		/**
+		*   Determines whether this build and the running kernel
+		*   support io_uring.
+		*/
+		static bool isAvailable();
+
+	private:
+		struct Segment
+		{
+			size_t length;
+			size_t written;
+			log4cxx_int64_t offset;
+		};
+
+		Pool pool;
+		Mutex mutex;
+		Condition segmentFree;
+		Condition drained;
+		apr_file_t* fileptr;
+		int fd;
+		struct io_uring* ring;
+		bool registered;
+		const size_t segmentSize;
+		std::vector<char> memory;
+		std::vector<Segment> segments;
+		std::vector<int> freeSegments;
+		int current;
+		int inFlight;
+		log4cxx_int64_t nextOffset;
+		bool flushPending;
+		bool unsubmitted;
+		int error;
+		bool closed;
+		Thread reaper;
+
+		void append(const char* data, size_t length);
+		void checkError();
+		void submit(int index);
+		void queue(int index);
+		void push();
+		void complete(int index, int result);
+		void stop();
+		static void* LOG4CXX_THREAD_FUNC reap(apr_thread_t* thread, void* data);
+
+		IOUringOutputStream(const IOUringOutputStream&);
+		IOUringOutputStream& operator=(const IOUringOutputStream&);
+};
+
+LOG4CXX_PTR_DEF(IOUringOutputStream);
+} // namespace helpers
+
+}  //namespace log4cxx
+
+#endif //_LOG4CXX_HELPERS_IOURINGOUTPUTSTREAM_H
@@ -18,7 +18,7 @@
 #ifndef _LOG4CXX_HELPERS_ISO_8601_DATE_FORMAT_H
 #define _LOG4CXX_HELPERS_ISO_8601_DATE_FORMAT_H
 
-#include <log4cxx/helpers/simpledateformat.h>
+#include <log4cxx/helpers/fixeddateformat.h>
 
 namespace log4cxx
 {
@@ -33,11 +33,11 @@ Formats a date in the format <b>yyyy-MM-dd HH:mm:ss,SSS</b> for example
 International Standard Date and Time Notation</a> for more
 information on this format.
 */
-class LOG4CXX_EXPORT ISO8601DateFormat : public SimpleDateFormat
+class LOG4CXX_EXPORT ISO8601DateFormat : public FixedDateFormat
 {
 	public:
 		ISO8601DateFormat()
-			: SimpleDateFormat(LOG4CXX_STR("yyyy-MM-dd HH:mm:ss,SSS")) {}
+			: FixedDateFormat(FixedDateFormat::ISO8601) {}
 };
 }  // namespace helpers
 } // namespace log4cxx
@@ -0,0 +1,118 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_HELPERS_MAPPEDFILEOUTPUTSTREAM_H
+#define _LOG4CXX_HELPERS_MAPPEDFILEOUTPUTSTREAM_H
+
+#include <log4cxx/helpers/outputstream.h>
+#include <log4cxx/helpers/pool.h>
+
+extern "C" {
+	struct apr_file_t;
+	struct apr_mmap_t;
+}
+
+namespace log4cxx
+{
+
+namespace helpers
+{
+
+/**
+*   OutputStream that appends by copying into a memory mapping of
+*   the file.  The file is extended a chunk at a time, preallocated
+*   where the system allows, and only the chunk being filled is mapped.
+*   On close the file is truncated to the length actually written.
+*
+*   <p>Output reaches the file's page cache without a system call
+*   per write, so other processes see it at once; it reaches the
+*   storage device when the system writes the pages back or, if a
+*   sync interval is given, when a flush finds that interval has
+*   passed.  A process that dies without closing the stream leaves
+*   zeros between the last output and the end of the chunk.
+*
+*   <p>Like the other output streams, this class relies on its
+*   caller to serialize writes.
+*/
+class LOG4CXX_EXPORT MappedFileOutputStream : public OutputStream
+{
+	private:
+		Pool pool;
+		apr_file_t* fileptr;
+		apr_mmap_t* mapping;
+		/**
+		 *  Offset in the file of the start of the mapping.
+		 */
+		log4cxx_int64_t mapOffset;
+		/**
+		 *  Bytes written into the mapping.
+		 */
+		size_t position;
+		/**
+		 *  Size of the file as allocated so far.
+		 */
+		log4cxx_int64_t allocated;
+		size_t chunkSize;
+		int syncInterval;
+		log4cxx_time_t lastSync;
+
+	public:
+		DECLARE_ABSTRACT_LOG4CXX_OBJECT(MappedFileOutputStream)
+		BEGIN_LOG4CXX_CAST_MAP()
+		LOG4CXX_CAST_ENTRY(MappedFileOutputStream)
+		LOG4CXX_CAST_ENTRY_CHAIN(OutputStream)
+		END_LOG4CXX_CAST_MAP()
+
+		/**
+		 *  Opens the file.
+		 *  @param filename file name.
+		 *  @param append if false, the file is truncated.
+		 *  @param chunkSize bytes by which the file is extended and
+		 *  mapped, rounded up to a multiple of 64 KiB.
+		 *  @param syncInterval shortest time, in milliseconds, between
+		 *  syncs made by flush, or zero to leave writeback to the system.
+		 */
+		MappedFileOutputStream(const LogString& filename, bool append,
+			size_t chunkSize, int syncInterval);
+		virtual ~MappedFileOutputStream();
+
+		virtual void close(Pool& p);
+		virtual void flush(Pool& p);
+		virtual void write(ByteBuffer& buf, Pool& p);
+		virtual void writeAll(const ByteStringList& buffers, Pool& p);
+
+		/**
+		 *  Forces data written so far to the storage device.
+		 *  @param p memory pool for operation.
+		 */
+		void sync(Pool& p);
+
+	private:
+		MappedFileOutputStream(const MappedFileOutputStream&);
+		MappedFileOutputStream& operator=(const MappedFileOutputStream&);
+		void append(const char* data, size_t length);
+		void map(log4cxx_int64_t offset);
+		void unmap(bool wait);
+		void preallocate(log4cxx_int64_t length);
+};
+
+LOG4CXX_PTR_DEF(MappedFileOutputStream);
+} // namespace helpers
+
+}  //namespace log4cxx
+
+#endif //_LOG4CXX_HELPERS_MAPPEDFILEOUTPUTSTREAM_H
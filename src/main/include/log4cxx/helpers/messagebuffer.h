@@ -164,6 +164,24 @@ class LOG4CXX_EXPORT CharMessageBuffer
 		 */
 		const std::basic_string<char>& str(CharMessageBuffer& buf);
 
+		/**
+		 *   Get content of buffer as a string that the caller
+		 *   may swap with its own to take the content without
+		 *   copying it.
+		 *   @param os used only to signal that
+		 *       the embedded stream was used.
+		 */
+		std::basic_string<char>& extract(std::basic_ostream<char>& os);
+
+		/**
+		 *   Get content of buffer as a string that the caller
+		 *   may swap with its own to take the content without
+		 *   copying it.
+		 *   @param buf used only to signal that
+		 *       the embedded stream was not used.
+		 */
+		std::basic_string<char>& extract(CharMessageBuffer& buf);
+
 		/**
 		 *  Returns true if buffer has an encapsulated STL stream.
 		 *  @return true if STL stream was created.
@@ -341,6 +359,24 @@ class LOG4CXX_EXPORT UniCharMessageBuffer
 		 */
 		const std::basic_string<UniChar>& str(UniCharMessageBuffer& buf);
 
+		/**
+		 *   Get content of buffer as a string that the caller
+		 *   may swap with its own to take the content without
+		 *   copying it.
+		 *   @param os used only to signal that
+		 *       the embedded stream was used.
+		 */
+		std::basic_string<UniChar>& extract(uostream& os);
+
+		/**
+		 *   Get content of buffer as a string that the caller
+		 *   may swap with its own to take the content without
+		 *   copying it.
+		 *   @param buf used only to signal that
+		 *       the embedded stream was not used.
+		 */
+		std::basic_string<UniChar>& extract(UniCharMessageBuffer& buf);
+
 		/**
 		 *  Returns true if buffer has an encapsulated STL stream.
 		 *  @return true if STL stream was created.
@@ -507,6 +543,24 @@ class LOG4CXX_EXPORT WideMessageBuffer
 		 */
 		const std::basic_string<wchar_t>& str(WideMessageBuffer& buf);
 
+		/**
+		 *   Get content of buffer as a string that the caller
+		 *   may swap with its own to take the content without
+		 *   copying it.
+		 *   @param os used only to signal that
+		 *       the embedded stream was used.
+		 */
+		std::basic_string<wchar_t>& extract(std::basic_ostream<wchar_t>& os);
+
+		/**
+		 *   Get content of buffer as a string that the caller
+		 *   may swap with its own to take the content without
+		 *   copying it.
+		 *   @param buf used only to signal that
+		 *       the embedded stream was not used.
+		 */
+		std::basic_string<wchar_t>& extract(WideMessageBuffer& buf);
+
 		/**
 		 *  Returns true if buffer has an encapsulated STL stream.
 		 *  @return true if STL stream was created.
@@ -607,6 +661,24 @@ class LOG4CXX_EXPORT MessageBuffer
 		 */
 		const std::string& str(std::ostream& os);
 
+		/**
+		 *   Get content of buffer as a string that the caller
+		 *   may swap with its own to take the content without
+		 *   copying it.
+		 *   @param os used only to signal that
+		 *       the embedded stream was used.
+		 */
+		std::string& extract(std::ostream& os);
+
+		/**
+		 *   Get content of buffer as a string that the caller
+		 *   may swap with its own to take the content without
+		 *   copying it.
+		 *   @param buf used only to signal that
+		 *       the embedded stream was not used.
+		 */
+		std::string& extract(CharMessageBuffer& buf);
+
 		/**
 		   *   Appends a string into the buffer and
 		   *   fixes the buffer to use char characters.
@@ -761,6 +833,24 @@ class LOG4CXX_EXPORT MessageBuffer
 		 */
 		const std::wstring& str(std::basic_ostream<wchar_t>& os);
 
+		/**
+		 *   Get content of buffer as a string that the caller
+		 *   may swap with its own to take the content without
+		 *   copying it.
+		 *   @param os used only to signal that
+		 *       the embedded stream was used.
+		 */
+		std::wstring& extract(std::basic_ostream<wchar_t>& os);
+
+		/**
+		 *   Get content of buffer as a string that the caller
+		 *   may swap with its own to take the content without
+		 *   copying it.
+		 *   @param buf used only to signal that
+		 *       the embedded stream was not used.
+		 */
+		std::wstring& extract(WideMessageBuffer& buf);
+
 #if LOG4CXX_UNICHAR_API || LOG4CXX_CFSTRING_API
 		/**
 		 *   Get content of buffer.
@@ -777,6 +867,24 @@ class LOG4CXX_EXPORT MessageBuffer
 		 *       the embedded stream was used.
 		 */
 		const std::basic_string<UniChar>& str(UniCharMessageBuffer::uostream& os);
+
+		/**
+		 *   Get content of buffer as a string that the caller
+		 *   may swap with its own to take the content without
+		 *   copying it.
+		 *   @param os used only to signal that
+		 *       the embedded stream was used.
+		 */
+		std::basic_string<UniChar>& extract(UniCharMessageBuffer::uostream& os);
+
+		/**
+		 *   Get content of buffer as a string that the caller
+		 *   may swap with its own to take the content without
+		 *   copying it.
+		 *   @param buf used only to signal that
+		 *       the embedded stream was not used.
+		 */
+		std::basic_string<UniChar>& extract(UniCharMessageBuffer& buf);
 #endif
 
 		/**
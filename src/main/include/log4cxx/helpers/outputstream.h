@@ -19,6 +19,8 @@
 #define _LOG4CXX_HELPERS_OUTPUTSTREAM_H
 
 #include <log4cxx/helpers/objectimpl.h>
+#include <string>
+#include <vector>
 #ifdef LOG4CXX_MULTI_PROCESS
 	#include <apr_file_io.h>
 #endif
@@ -29,6 +31,7 @@ namespace log4cxx
 namespace helpers
 {
 class ByteBuffer;
+LOG4CXX_LIST_DEF(ByteStringList, std::string);
 
 /**
 *   Abstract class for writing to character streams.
@@ -49,6 +52,15 @@ class LOG4CXX_EXPORT OutputStream : public ObjectImpl
 		virtual void close(Pool& p) = 0;
 		virtual void flush(Pool& p) = 0;
 		virtual void write(ByteBuffer& buf, Pool& p) = 0;
+
+		/**
+		 *  Writes each of the buffers in turn.  Streams that can hand
+		 *  several buffers to the operating system in one call override
+		 *  this, the default writes them one at a time.
+		 *  @param buffers buffers to write, empty buffers are skipped.
+		 *  @param p memory pool for operation.
+		 */
+		virtual void writeAll(const ByteStringList& buffers, Pool& p);
 #ifdef LOG4CXX_MULTI_PROCESS
 		virtual apr_file_t* getFilePtr();
 		virtual OutputStream& getFileOutPutStreamPtr();
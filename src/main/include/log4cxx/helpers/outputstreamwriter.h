@@ -51,8 +51,31 @@ class LOG4CXX_EXPORT OutputStreamWriter : public Writer
 		virtual void close(Pool& p);
 		virtual void flush(Pool& p);
 		virtual void write(const LogString& str, Pool& p);
+
+		/**
+		 *  Writes bytes that are already encoded, bypassing the encoder.
+		 *  @param buf bytes between position and limit are written.
+		 *  @param p pool for temporary allocations.
+		 */
+		void write(ByteBuffer& buf, Pool& p);
+
+		/**
+		 *  Writes several runs of encoded bytes, letting the stream
+		 *  gather them into one write where it can.
+		 *  @param buffers bytes to write, in order.
+		 *  @param p pool for temporary allocations.
+		 */
+		void writeAll(const ByteStringList& buffers, Pool& p);
 		LogString getEncoding() const;
 
+		/**
+		 *  Gets the encoder used for text.
+		 */
+		inline const CharsetEncoderPtr& getEncoder() const
+		{
+			return enc;
+		}
+
 #ifdef LOG4CXX_MULTI_PROCESS
 		OutputStreamPtr getOutPutStreamPtr()
 		{
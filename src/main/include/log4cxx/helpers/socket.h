@@ -25,6 +25,7 @@ extern "C" {
 
 #include <log4cxx/helpers/inetaddress.h>
 #include <log4cxx/helpers/pool.h>
+#include <log4cxx/helpers/outputstream.h>
 
 
 namespace log4cxx
@@ -57,6 +58,10 @@ class LOG4CXX_EXPORT Socket : public helpers::ObjectImpl
 
 		size_t write(ByteBuffer&);
 
+		/** Sends the buffers in order, gathering them into as few
+		calls to apr_socket_sendv as possible. */
+		size_t write(const ByteStringList& buffers);
+
 		/** Closes this socket. */
 		void close();
 
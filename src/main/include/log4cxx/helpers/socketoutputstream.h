@@ -49,6 +49,7 @@ class LOG4CXX_EXPORT SocketOutputStream : public OutputStream
 		virtual void close(Pool& p);
 		virtual void flush(Pool& p);
 		virtual void write(ByteBuffer& buf, Pool& p);
+		virtual void writeAll(const ByteStringList& buffers, Pool& p);
 
 	private:
 		ByteList array;
@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _LOG4CXX_HELPERS_THREAD_NAME_H
+#define _LOG4CXX_HELPERS_THREAD_NAME_H
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/helpers/objectimpl.h>
+#include <log4cxx/helpers/objectptr.h>
+
+
+namespace log4cxx
+{
+namespace helpers
+{
+/**
+ *  The name of a thread as reported by LoggingEvent::getThreadName.
+ *  Each thread's name is rendered once and shared by every event
+ *  the thread creates.
+ */
+class LOG4CXX_EXPORT ThreadName : public ObjectImpl
+{
+		const LogString name;
+	public:
+		DECLARE_LOG4CXX_OBJECT(ThreadName)
+		BEGIN_LOG4CXX_CAST_MAP()
+		LOG4CXX_CAST_ENTRY(ThreadName)
+		END_LOG4CXX_CAST_MAP()
+
+		ThreadName();
+		ThreadName(const LogString& name);
+		virtual ~ThreadName();
+
+		inline const LogString& getName() const
+		{
+			return name;
+		}
+
+		/**
+		 *  Gets the name of the current thread.  Unless set by
+		 *  setCurrentThreadName, this is the thread identifier
+		 *  in hexadecimal.
+		 */
+		static ObjectPtrT<ThreadName> getCurrentThreadName();
+
+		/**
+		 *  Sets the name reported for events created by the
+		 *  current thread from now on.
+		 *  @param name human readable name, for example "main".
+		 */
+		static void setCurrentThreadName(const LogString& name);
+
+		/**
+		 *  Sets the name reported for events created by the current
+		 *  thread to the name the operating system has for it,
+		 *  as returned by pthread_getname_np.
+		 *  @return true if the name was available.
+		 */
+		static bool setCurrentThreadNameFromSystem();
+
+		/**
+		 *  Renders the identifier of the current thread.
+		 */
+		static LogString getCurrentThreadId();
+
+	private:
+		ThreadName(const ThreadName&);
+		ThreadName& operator=(const ThreadName&);
+};
+
+LOG4CXX_PTR_DEF(ThreadName);
+
+}
+}
+
+
+#endif
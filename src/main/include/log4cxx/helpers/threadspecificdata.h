@@ -20,12 +20,29 @@
 
 #include <log4cxx/ndc.h>
 #include <log4cxx/mdc.h>
+#include <log4cxx/helpers/pool.h>
+#include <log4cxx/helpers/threadname.h>
 
 
 namespace log4cxx
 {
 namespace helpers
 {
+class EventCache;
+
+/**
+ *  Epoch in which a thread entered its current read of data that
+ *  writers retire rather than delete, zero while it reads none.
+ *  Only the owning thread writes <code>epoch</code>, so entering and
+ *  leaving a read touches no cache line shared with other readers.
+ */
+struct ReaderEpoch
+{
+	unsigned int volatile epoch;
+	unsigned int volatile claimed;
+	ReaderEpoch* next;
+};
+
 /**
   *   This class contains all the thread-specific
   *   data in use by log4cxx.
@@ -53,12 +70,122 @@ class LOG4CXX_EXPORT ThreadSpecificData
 		log4cxx::NDC::Stack& getStack();
 		log4cxx::MDC::Map& getMap();
 
+		/**
+		 *  Gets the name of the current thread, rendering
+		 *  it on first use.
+		 */
+		static ThreadNamePtr getThreadName();
+		/**
+		 *  Sets the name of the current thread.
+		 */
+		static void setThreadName(const LogString& name);
+
+		/**
+		 *  Gets the current thread's scratch pool and marks it in use.
+		 *  @return scratch pool, or null if it is already in use.
+		 */
+		static apr_pool_t* acquireScratchPool();
+		/**
+		 *  Clears a pool obtained from acquireScratchPool so that it
+		 *  can be reused, or destroys any other pool.
+		 */
+		static void releaseScratchPool(apr_pool_t* pool);
+		/**
+		 *  Allocates a block from the current thread's event cache,
+		 *  reusing a previously released block where possible.
+		 *  @param size size of block, in bytes.
+		 *  @return block, never null.
+		 */
+		static void* allocateEvent(size_t size);
+		/**
+		 *  Returns a block obtained from allocateEvent to the cache of
+		 *  the thread that allocated it, which may be another thread.
+		 */
+		static void releaseEvent(void* ptr);
+		/**
+		 *  Gets the current thread's reader epoch, claiming one on
+		 *  first use.
+		 *  @return reader epoch, or null if no thread specific data
+		 *  could be created.
+		 */
+		static ReaderEpoch* getReaderEpoch();
+		/**
+		 *  Gets the earliest epoch in which a thread is reading.
+		 *  @param except reader to ignore, may be null.
+		 *  @return earliest epoch, or the largest unsigned int if
+		 *  no other thread is reading.
+		 */
+		static unsigned int getOldestReaderEpoch(const ReaderEpoch* except);
+		/**
+		 *  Gets the epoch a read entered now is recorded in.
+		 */
+		static unsigned int getCurrentReaderEpoch();
+		/**
+		 *  Advances the epoch, to be called once data has been
+		 *  unpublished.
+		 *  @return new epoch; the data may be deleted once
+		 *  getOldestReaderEpoch returns no less.
+		 */
+		static unsigned int advanceReaderEpoch();
 
 	private:
 		static ThreadSpecificData& getDataNoThreads();
 		static ThreadSpecificData* createCurrentData();
 		log4cxx::NDC::Stack ndcStack;
 		log4cxx::MDC::Map mdcMap;
+		ThreadNamePtr threadName;
+		apr_pool_t* scratchPool;
+		bool scratchPoolInUse;
+		EventCache* eventCache;
+		ReaderEpoch* readerEpoch;
+};
+
+/**
+ *  Records the current thread as reading for the lifetime of the
+ *  object, in the epoch current at construction unless an enclosing
+ *  read already recorded an earlier one.
+ */
+class LOG4CXX_EXPORT EpochRead
+{
+	public:
+		EpochRead();
+		~EpochRead();
+
+		/**
+		 *  Tells whether the read is recorded; it is not when the
+		 *  thread has no thread specific data, in which case the
+		 *  caller has to lock instead.
+		 */
+		inline bool isRecorded() const
+		{
+			return reader != 0;
+		}
+
+	private:
+		ReaderEpoch* const reader;
+		bool outermost;
+
+		EpochRead(const EpochRead&);
+		EpochRead& operator=(const EpochRead&);
+};
+
+/**
+ *  Pool for the transient allocations made while an event is
+ *  dispatched.  Borrows the current thread's scratch pool, which is
+ *  cleared rather than destroyed afterwards, or creates a private
+ *  pool if the scratch pool is already in use further up the stack,
+ *  for example by an appender that logs from within append.
+ */
+class LOG4CXX_EXPORT ScratchPool : public Pool
+{
+	public:
+		ScratchPool();
+		~ScratchPool();
+
+	private:
+		static apr_pool_t* acquire();
+		ScratchPool(const ScratchPool&);
+		ScratchPool& operator=(const ScratchPool&);
 };
 
 }  // namespace helpers
@@ -68,6 +68,30 @@ class LOG4CXX_EXPORT Transcoder
 		 */
 		static void encodeUTF16BE(unsigned int sv, ByteBuffer& dst);
 
+		/**
+		 *    Appends the run of ASCII characters at the start of src
+		 *      to a LogString, converting many characters at a time.
+		 *    @param src bytes to decode.
+		 *    @param length number of bytes.
+		 *    @param dst destination.
+		 *    @return number of bytes decoded.
+		 */
+		static size_t decodeASCII(const char* src, size_t length, LogString& dst);
+		/**
+		 *    Copies the run of ASCII characters starting at iter to a
+		 *      byte buffer, stopping at any other character or when
+		 *      the buffer is full.
+		 */
+		static void encodeASCII(const LogString& src,
+			LogString::const_iterator& iter, ByteBuffer& dst);
+		/**
+		 *    Copies the run of ASCII characters starting at iter to a
+		 *      byte buffer as UTF-16, stopping at any other character
+		 *      or when the buffer is full.
+		 */
+		static void encodeASCIIUTF16(const LogString& src,
+			LogString::const_iterator& iter, ByteBuffer& dst, bool bigEndian);
+
 
 		/**
 		 *   Decodes next character from a UTF-8 string.
@@ -55,6 +55,17 @@ class LOG4CXX_EXPORT Transform
 		*/
 		static void appendEscapingCDATA(
 			LogString& buf, const LogString& input);
+
+		/**
+		* Appends the contents of a JSON string, escaping quotation marks,
+		* reverse solidi and control characters.  The enclosing quotation
+		* marks are the responsibility of the calling method.
+		*
+		* @param buf output stream holding the JSON data to this point.
+		* @param input The String that is inserted into a JSON string.
+		*/
+		static void appendEscapingJSON(
+			LogString& buf, const LogString& input);
 }; // class Transform
 }  // namespace helpers
 } //namespace log4cxx
@@ -67,6 +67,18 @@ class LOG4CXX_EXPORT Hierarchy :
 		typedef std::map<LogString, LoggerPtr> LoggerMap;
 		LoggerMap* loggers;
 
+		/**
+		Hash index of loggers that getLogger and exists search
+		without locking.  It only changes under mutex, by
+		publishing a new table.  A replaced table is retired, since
+		a lookup on another thread may still be reading it, and is
+		deleted along with its references to the loggers once no
+		thread reads in an earlier epoch.
+		*/
+		struct LookupTable;
+		LookupTable* volatile lookupTable;
+		LookupTable* retiredTables;
+
 		typedef std::map<LogString, ProvisionNode> ProvisionNodeMap;
 		ProvisionNodeMap* provisionNodes;
 
@@ -253,6 +265,20 @@ class LOG4CXX_EXPORT Hierarchy :
 		*/
 		void updateParents(LoggerPtr logger);
 
+		/**
+		Adds a new logger to the lookup table, replacing the table
+		with a larger one once it is full.  Called with mutex held
+		after the logger has been added to loggers.
+		*/
+		void addToLookupTable(const LoggerPtr& logger, unsigned int hash);
+
+		/**
+		Retires a table that is no longer published and deletes the
+		retired tables no lookup can still be reading.  Called with
+		mutex held.
+		*/
+		void retireLookupTable(LookupTable* table);
+
 		/**
 		We update the links for all the children that placed themselves
 		in the provision node 'pn'. The second argument 'cat' is a
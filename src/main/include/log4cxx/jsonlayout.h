@@ -0,0 +1,146 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_JSON_LAYOUT_H
+#define _LOG4CXX_JSON_LAYOUT_H
+
+#if defined(_MSC_VER)
+	#pragma warning ( push )
+	#pragma warning ( disable: 4231 4251 4275 4786 )
+#endif
+
+
+#include <log4cxx/layout.h>
+#include <log4cxx/helpers/iso8601dateformat.h>
+
+
+
+namespace log4cxx
+{
+/**
+This layout outputs each event as a JSON object on a line of its own,
+for example
+
+<code>
+{"timestamp":"2004-07-02 00:00:00,000","level":"INFO","logger":"org.example",
+"thread":"0x7f0a","message":"hello"}
+</code>
+
+(shown here on two lines).  The timestamp is in ISO8601 format, in GMT.
+The NDC is output as <code>"ndc"</code> when it is not empty.  As with
+XMLLayout, the <b>LocationInfo</b> option adds a <code>"locationInfo"</code>
+object and the <b>Properties</b> option adds a <code>"properties"</code>
+object holding the MDC and the event properties.
+*/
+class LOG4CXX_EXPORT JSONLayout : public Layout
+{
+	private:
+		// Print no location info by default
+		bool locationInfo; //= false
+		bool properties; // = false
+
+		helpers::ISO8601DateFormat dateFormat;
+
+	public:
+		DECLARE_LOG4CXX_OBJECT(JSONLayout)
+		BEGIN_LOG4CXX_CAST_MAP()
+		LOG4CXX_CAST_ENTRY(JSONLayout)
+		LOG4CXX_CAST_ENTRY_CHAIN(Layout)
+		END_LOG4CXX_CAST_MAP()
+
+		JSONLayout();
+
+		/**
+		The <b>LocationInfo</b> option takes a boolean value. By
+		default, it is set to false which means there will be no location
+		information output by this layout. If the the option is set to
+		true, then the class, method, file name and line number of the
+		statement at the origin of the log statement will be output.
+		*/
+		inline void setLocationInfo(bool locationInfo1)
+		{
+			this->locationInfo = locationInfo1;
+		}
+
+		/**
+		Returns the current value of the <b>LocationInfo</b> option.
+		*/
+		inline bool getLocationInfo() const
+		{
+			return locationInfo;
+		}
+
+		/**
+		The <b>Properties</b> option takes a boolean value. If true,
+		the MDC and the event properties are output.
+		*/
+		inline void setProperties(bool flag)
+		{
+			properties = flag;
+		}
+
+		/**
+		Returns the current value of the <b>Properties</b> option.
+		*/
+		inline bool getProperties() const
+		{
+			return properties;
+		}
+
+		/**
+		Returns the content type output by this layout, i.e "application/json".
+		*/
+		virtual LogString getContentType() const
+		{
+			return LOG4CXX_STR("application/json");
+		}
+
+		/**
+		No options to activate.
+		*/
+		void activateOptions(log4cxx::helpers::Pool& /* p */) {}
+
+		/**
+		Set options
+		*/
+		virtual void setOption(const LogString& option, const LogString& value);
+
+		virtual void format(LogString& output,
+			const spi::LoggingEventPtr& event, log4cxx::helpers::Pool& pool) const;
+
+		/**
+		The JSON layout does not handle the throwable contained in
+		logging events. Hence, this method return <code>true</code>.
+		*/
+		virtual bool ignoresThrowable() const
+		{
+			return true;
+		}
+
+	private:
+		static void appendQuoted(LogString& output, const LogString& value);
+		static void appendMember(LogString& output, const logchar* name,
+			const LogString& value);
+};
+LOG4CXX_PTR_DEF(JSONLayout);
+}  // namespace log4cxx
+
+#if defined(_MSC_VER)
+	#pragma warning ( pop )
+#endif
+
+#endif // _LOG4CXX_JSON_LAYOUT_H
@@ -28,6 +28,7 @@
 #include <log4cxx/helpers/objectptr.h>
 #include <log4cxx/spi/optionhandler.h>
 #include <log4cxx/spi/loggingevent.h>
+#include <log4cxx/helpers/charsetencoder.h>
 
 
 namespace log4cxx
@@ -57,6 +58,18 @@ class LOG4CXX_EXPORT Layout :
 		virtual void format(LogString& output,
 			const spi::LoggingEventPtr& event, log4cxx::helpers::Pool& pool) const = 0;
 
+		/**
+		Formats the event as bytes in the encoding of the encoder,
+		appending to output.  The base class formats with format and
+		encodes the text in one pass, or when the encoder needs no
+		conversion formats straight into the output.  Layouts that
+		produce bytes rather than text override this method.
+		*/
+		virtual void formatBytes(std::string& output,
+			const spi::LoggingEventPtr& event,
+			const log4cxx::helpers::CharsetEncoderPtr& encoder,
+			log4cxx::helpers::Pool& pool) const;
+
 		/**
 		Returns the content type output by this layout. The base class
 		returns "text/plain".
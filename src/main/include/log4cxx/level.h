@@ -220,14 +220,19 @@ class LOG4CXX_EXPORT Level : public helpers::ObjectImpl
 		};
 
 
-		static LevelPtr getAll();
-		static LevelPtr getFatal();
-		static LevelPtr getError();
-		static LevelPtr getWarn();
-		static LevelPtr getInfo();
-		static LevelPtr getDebug();
-		static LevelPtr getTrace();
-		static LevelPtr getOff();
+		/**
+		The built-in levels.  Each getter returns a reference to a
+		single shared instance, so built-in levels may be compared
+		by identity as well as by <code>toInt()</code>.
+		*/
+		static const LevelPtr& getAll();
+		static const LevelPtr& getFatal();
+		static const LevelPtr& getError();
+		static const LevelPtr& getWarn();
+		static const LevelPtr& getInfo();
+		static const LevelPtr& getDebug();
+		static const LevelPtr& getTrace();
+		static const LevelPtr& getOff();
 
 
 		/**
@@ -294,7 +299,7 @@ namespace helpers
 /** @class log4cxx::helpers::ObjectPtr */
 template<> inline bool LevelPtr::operator==(const LevelPtr& rhs) const
 {
-	return (*this)->equals(rhs);
+	return (p == rhs.p) || (*this)->equals(rhs);
 }
 template<> inline bool LevelPtr::operator!=(const LevelPtr& rhs) const
 {
@@ -30,6 +30,7 @@
 #include <log4cxx/spi/location/locationinfo.h>
 #include <log4cxx/helpers/resourcebundle.h>
 #include <log4cxx/helpers/messagebuffer.h>
+#include <log4cxx/helpers/deferredmessage.h>
 
 
 namespace log4cxx
@@ -583,6 +584,94 @@ class LOG4CXX_EXPORT Logger :
 #endif
 		/**
 		This method creates a new logging event and logs the event
+		without further checks.  The event takes the content of
+		message rather than copying it when message is already in
+		the internal encoding, leaving message empty.
+		@param level the level to log.
+		@param message the message string to log.
+		@param location location of the logging statement.
+		*/
+		void forcedLogSwap(const LevelPtr& level, std::string& message,
+			const log4cxx::spi::LocationInfo& location) const;
+#if LOG4CXX_WCHAR_T_API
+		/**
+		This method creates a new logging event and logs the event
+		without further checks.  The event takes the content of
+		message rather than copying it when message is already in
+		the internal encoding, leaving message empty.
+		@param level the level to log.
+		@param message the message string to log.
+		@param location location of the logging statement.
+		*/
+		void forcedLogSwap(const LevelPtr& level, std::wstring& message,
+			const log4cxx::spi::LocationInfo& location) const;
+#endif
+#if LOG4CXX_UNICHAR_API || LOG4CXX_CFSTRING_API
+		/**
+		This method creates a new logging event and logs the event
+		without further checks.  The event takes the content of
+		message rather than copying it when message is already in
+		the internal encoding, leaving message empty.
+		@param level the level to log.
+		@param message the message string to log.
+		@param location location of the logging statement.
+		*/
+		void forcedLogSwap(const LevelPtr& level, std::basic_string<UniChar>& message,
+			const log4cxx::spi::LocationInfo& location) const;
+#endif
+		/**
+		This method creates a new logging event and logs the event
+		without further checks.
+		@param level the level to log.
+		@param message the first character of the message.
+		@param length the number of characters in the message.
+		@param location location of the logging statement.
+		*/
+		void forcedLog(const LevelPtr& level, const char* message, size_t length,
+			const log4cxx::spi::LocationInfo& location) const;
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+		/**
+		This method creates a new logging event that takes the
+		content of a temporary message, and logs the event
+		without further checks.
+		@param level the level to log.
+		@param message the message string to log.
+		@param location location of the logging statement.
+		*/
+		void forcedLog(const LevelPtr& level, std::string&& message,
+			const log4cxx::spi::LocationInfo& location) const
+		{
+			forcedLogSwap(level, message, location);
+		}
+#if LOG4CXX_WCHAR_T_API
+		/**
+		This method creates a new logging event that takes the
+		content of a temporary message, and logs the event
+		without further checks.
+		@param level the level to log.
+		@param message the message string to log.
+		@param location location of the logging statement.
+		*/
+		void forcedLog(const LevelPtr& level, std::wstring&& message,
+			const log4cxx::spi::LocationInfo& location) const
+		{
+			forcedLogSwap(level, message, location);
+		}
+#endif
+#endif
+		/**
+		This method creates a new logging event and logs the event
+		without further checks.  The message is rendered from the
+		captured format and arguments only when an appender or layout
+		asks for it.
+		@param level the level to log.
+		@param message the format and arguments of the message.
+		@param location location of the logging statement.
+		*/
+		void forcedLog(const LevelPtr& level, const helpers::DeferredMessage& message,
+			const log4cxx::spi::LocationInfo& location) const;
+		/**
+		This method creates a new logging event and logs the event
 		without further checks.
 		@param level the level to log.
 		@param message the message string to log.
@@ -1466,8 +1555,21 @@ class LOG4CXX_EXPORT Logger :
 		/**
 		Only the Hierarchy class can set the hierarchy of a logger.*/
 		void setHierarchy(spi::LoggerRepository* repository);
+		/**
+		Invalidates the appenders cached by every logger.  Called
+		whenever appenders are added or removed, an additivity flag
+		changes or a logger is inserted in the hierarchy.
+		*/
+		static void invalidateAppenders();
 
 	public:
+		/**
+		Invalidates the effective threshold cached by every logger.
+		Called whenever a logger level, a repository threshold or the
+		configuration state of a repository changes.
+		*/
+		static void invalidateEffectiveLevels();
+
 		/**
 		Set the level of this Logger.
 
@@ -1726,6 +1828,48 @@ class LOG4CXX_EXPORT Logger :
 		Logger& operator=(const Logger&);
 		mutable SHARED_MUTEX mutex;
 		friend class log4cxx::helpers::synchronized;
+
+		bool isEnabledForLevel(int level) const;
+		bool updateEffectiveThreshold(int level) const;
+
+		/**
+		The greater of the repository threshold and the effective
+		level, valid while <code>thresholdGeneration</code> matches
+		the current level generation.
+		*/
+		mutable int volatile effectiveThreshold;
+		mutable unsigned int volatile thresholdGeneration;
+
+		struct AppenderSnapshot;
+		const AppenderSnapshot* updateAppenderSnapshot() const;
+		void callAppendersLocked(const spi::LoggingEventPtr& event,
+			log4cxx::helpers::Pool& p) const;
+		unsigned int retireAppenderSnapshot(AppenderSnapshot* snapshot) const;
+		void reclaimAppenderSnapshots() const;
+		void releaseAppenders(const AppenderList& removed) const;
+
+		/**
+		The appenders of this logger and of the ancestors reached
+		through additivity, valid while its generation matches the
+		current appender generation.
+		*/
+		mutable AppenderSnapshot* volatile appenderSnapshot;
+
+		/**
+		Replaced snapshots are retired rather than deleted, since a
+		logging request on another thread may still be iterating over
+		one.  Each is tagged with the reader epoch it was retired in
+		and deleted once no thread is reading in an earlier epoch.
+		Only changed while the mutex is held.
+		*/
+		mutable AppenderSnapshot* retiredSnapshots;
+
+		/**
+		The name of this logger interned by helpers::InternedStrings,
+		passed to its events so that layouts can identify the logger
+		by address.
+		*/
+		const LogString* const internedName;
 };
 LOG4CXX_LIST_DEF(LoggerList, LoggerPtr);
 
@@ -1766,7 +1910,7 @@ Logs a message to a specified logger with a specified level.
 #define LOG4CXX_LOG(logger, level, message) do { \
 		if (logger->isEnabledFor(level)) {\
 			::log4cxx::helpers::MessageBuffer oss_; \
-			logger->forcedLog(level, oss_.str(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+			logger->forcedLogSwap(level, oss_.extract(oss_ << message), LOG4CXX_LOCATION); }} while (0)
 
 /**
 Logs a message to a specified logger with a specified level.
@@ -1778,7 +1922,21 @@ Logs a message to a specified logger with a specified level.
 #define LOG4CXX_LOGLS(logger, level, message) do { \
 		if (logger->isEnabledFor(level)) {\
 			::log4cxx::helpers::LogCharMessageBuffer oss_; \
-			logger->forcedLog(level, oss_.str(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+			logger->forcedLogSwap(level, oss_.extract(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+
+/**
+Logs a message to a specified logger with a specified level,
+deferring the formatting of the message until it is needed,
+for example LOG4CXX_LOG_FMT(logger, level, "x={} y={}", x, y).
+
+@param logger the logger to be used.
+@param level the level to log.
+@param ... a format string literal in which each "{}" is replaced
+by the next of up to eight arguments that follow it.
+*/
+#define LOG4CXX_LOG_FMT(logger, level, ...) do { \
+		if (logger->isEnabledFor(level)) {\
+			logger->forcedLog(level, ::log4cxx::helpers::DeferredMessage::capture(__VA_ARGS__), LOG4CXX_LOCATION); }} while (0)
 
 #if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 10000
 /**
@@ -1790,9 +1948,21 @@ Logs a message to a specified logger with the DEBUG level.
 #define LOG4CXX_DEBUG(logger, message) do { \
 		if (LOG4CXX_UNLIKELY(logger->isDebugEnabled())) {\
 			::log4cxx::helpers::MessageBuffer oss_; \
-			logger->forcedLog(::log4cxx::Level::getDebug(), oss_.str(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+			logger->forcedLogSwap(::log4cxx::Level::getDebug(), oss_.extract(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+
+/**
+Logs a message to a specified logger with the DEBUG level,
+deferring the formatting of the message until it is needed.
+
+@param logger the logger to be used.
+@param ... a format string literal and its arguments, see LOG4CXX_LOG_FMT.
+*/
+#define LOG4CXX_DEBUG_FMT(logger, ...) do { \
+		if (LOG4CXX_UNLIKELY(logger->isDebugEnabled())) {\
+			logger->forcedLog(::log4cxx::Level::getDebug(), ::log4cxx::helpers::DeferredMessage::capture(__VA_ARGS__), LOG4CXX_LOCATION); }} while (0)
 #else
 #define LOG4CXX_DEBUG(logger, message)
+#define LOG4CXX_DEBUG_FMT(logger, ...)
 #endif
 
 #if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 5000
@@ -1805,9 +1975,21 @@ Logs a message to a specified logger with the TRACE level.
 #define LOG4CXX_TRACE(logger, message) do { \
 		if (LOG4CXX_UNLIKELY(logger->isTraceEnabled())) {\
 			::log4cxx::helpers::MessageBuffer oss_; \
-			logger->forcedLog(::log4cxx::Level::getTrace(), oss_.str(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+			logger->forcedLogSwap(::log4cxx::Level::getTrace(), oss_.extract(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+
+/**
+Logs a message to a specified logger with the TRACE level,
+deferring the formatting of the message until it is needed.
+
+@param logger the logger to be used.
+@param ... a format string literal and its arguments, see LOG4CXX_LOG_FMT.
+*/
+#define LOG4CXX_TRACE_FMT(logger, ...) do { \
+		if (LOG4CXX_UNLIKELY(logger->isTraceEnabled())) {\
+			logger->forcedLog(::log4cxx::Level::getTrace(), ::log4cxx::helpers::DeferredMessage::capture(__VA_ARGS__), LOG4CXX_LOCATION); }} while (0)
 #else
 #define LOG4CXX_TRACE(logger, message)
+#define LOG4CXX_TRACE_FMT(logger, ...)
 #endif
 
 #if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 20000
@@ -1820,9 +2002,21 @@ Logs a message to a specified logger with the INFO level.
 #define LOG4CXX_INFO(logger, message) do { \
 		if (logger->isInfoEnabled()) {\
 			::log4cxx::helpers::MessageBuffer oss_; \
-			logger->forcedLog(::log4cxx::Level::getInfo(), oss_.str(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+			logger->forcedLogSwap(::log4cxx::Level::getInfo(), oss_.extract(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+
+/**
+Logs a message to a specified logger with the INFO level,
+deferring the formatting of the message until it is needed.
+
+@param logger the logger to be used.
+@param ... a format string literal and its arguments, see LOG4CXX_LOG_FMT.
+*/
+#define LOG4CXX_INFO_FMT(logger, ...) do { \
+		if (logger->isInfoEnabled()) {\
+			logger->forcedLog(::log4cxx::Level::getInfo(), ::log4cxx::helpers::DeferredMessage::capture(__VA_ARGS__), LOG4CXX_LOCATION); }} while (0)
 #else
 #define LOG4CXX_INFO(logger, message)
+#define LOG4CXX_INFO_FMT(logger, ...)
 #endif
 
 #if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 30000
@@ -1835,9 +2029,21 @@ Logs a message to a specified logger with the WARN level.
 #define LOG4CXX_WARN(logger, message) do { \
 		if (logger->isWarnEnabled()) {\
 			::log4cxx::helpers::MessageBuffer oss_; \
-			logger->forcedLog(::log4cxx::Level::getWarn(), oss_.str(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+			logger->forcedLogSwap(::log4cxx::Level::getWarn(), oss_.extract(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+
+/**
+Logs a message to a specified logger with the WARN level,
+deferring the formatting of the message until it is needed.
+
+@param logger the logger to be used.
+@param ... a format string literal and its arguments, see LOG4CXX_LOG_FMT.
+*/
+#define LOG4CXX_WARN_FMT(logger, ...) do { \
+		if (logger->isWarnEnabled()) {\
+			logger->forcedLog(::log4cxx::Level::getWarn(), ::log4cxx::helpers::DeferredMessage::capture(__VA_ARGS__), LOG4CXX_LOCATION); }} while (0)
 #else
 #define LOG4CXX_WARN(logger, message)
+#define LOG4CXX_WARN_FMT(logger, ...)
 #endif
 
 #if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 40000
@@ -1850,7 +2056,7 @@ Logs a message to a specified logger with the ERROR level.
 #define LOG4CXX_ERROR(logger, message) do { \
 		if (logger->isErrorEnabled()) {\
 			::log4cxx::helpers::MessageBuffer oss_; \
-			logger->forcedLog(::log4cxx::Level::getError(), oss_.str(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+			logger->forcedLogSwap(::log4cxx::Level::getError(), oss_.extract(oss_ << message), LOG4CXX_LOCATION); }} while (0)
 
 /**
 Logs a error if the condition is not true.
@@ -1862,10 +2068,22 @@ Logs a error if the condition is not true.
 #define LOG4CXX_ASSERT(logger, condition, message) do { \
 		if (!(condition) && logger->isErrorEnabled()) {\
 			::log4cxx::helpers::MessageBuffer oss_; \
-			logger->forcedLog(::log4cxx::Level::getError(), oss_.str(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+			logger->forcedLogSwap(::log4cxx::Level::getError(), oss_.extract(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+
+/**
+Logs a message to a specified logger with the ERROR level,
+deferring the formatting of the message until it is needed.
+
+@param logger the logger to be used.
+@param ... a format string literal and its arguments, see LOG4CXX_LOG_FMT.
+*/
+#define LOG4CXX_ERROR_FMT(logger, ...) do { \
+		if (logger->isErrorEnabled()) {\
+			logger->forcedLog(::log4cxx::Level::getError(), ::log4cxx::helpers::DeferredMessage::capture(__VA_ARGS__), LOG4CXX_LOCATION); }} while (0)
 
 #else
 #define LOG4CXX_ERROR(logger, message)
+#define LOG4CXX_ERROR_FMT(logger, ...)
 #define LOG4CXX_ASSERT(logger, condition, message)
 #endif
 
@@ -1879,9 +2097,21 @@ Logs a message to a specified logger with the FATAL level.
 #define LOG4CXX_FATAL(logger, message) do { \
 		if (logger->isFatalEnabled()) {\
 			::log4cxx::helpers::MessageBuffer oss_; \
-			logger->forcedLog(::log4cxx::Level::getFatal(), oss_.str(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+			logger->forcedLogSwap(::log4cxx::Level::getFatal(), oss_.extract(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+
+/**
+Logs a message to a specified logger with the FATAL level,
+deferring the formatting of the message until it is needed.
+
+@param logger the logger to be used.
+@param ... a format string literal and its arguments, see LOG4CXX_LOG_FMT.
+*/
+#define LOG4CXX_FATAL_FMT(logger, ...) do { \
+		if (logger->isFatalEnabled()) {\
+			logger->forcedLog(::log4cxx::Level::getFatal(), ::log4cxx::helpers::DeferredMessage::capture(__VA_ARGS__), LOG4CXX_LOCATION); }} while (0)
 #else
 #define LOG4CXX_FATAL(logger, message)
+#define LOG4CXX_FATAL_FMT(logger, ...)
 #endif
 
 /**
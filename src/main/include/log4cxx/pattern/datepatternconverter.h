@@ -50,11 +50,19 @@ class LOG4CXX_EXPORT DatePatternConverter : public LoggingEventPatternConverter
 		DatePatternConverter(const OptionsList& options);
 
 		/**
-		 * Obtains an instance of pattern converter.
+		 * Obtains the date format shared by all converters with the same options,
+		 * so that each distinct format caches its formatted second once.
 		 * @param options options, may be null.
-		 * @return instance of pattern converter.
+		 * @return date format.
 		 */
 		static log4cxx::helpers::DateFormatPtr getDateFormat(const OptionsList& options);
+
+		/**
+		 * Creates a new date format.
+		 * @param options options, may be null.
+		 * @return date format.
+		 */
+		static log4cxx::helpers::DateFormatPtr createDateFormat(const OptionsList& options);
 	public:
 		DECLARE_LOG4CXX_PATTERN(DatePatternConverter)
 		BEGIN_LOG4CXX_CAST_MAP()
@@ -40,6 +40,13 @@ class LOG4CXX_EXPORT NamePatternConverter : public LoggingEventPatternConverter
 		 */
 		const NameAbbreviatorPtr abbreviator;
 
+		/**
+		 * Names already abbreviated, shared by concurrent formatters,
+		 * or null if names are not abbreviated.
+		 */
+		struct Cache;
+		Cache* const cache;
+
 	public:
 		DECLARE_LOG4CXX_PATTERN(NamePatternConverter)
 		BEGIN_LOG4CXX_CAST_MAP()
@@ -47,6 +54,13 @@ class LOG4CXX_EXPORT NamePatternConverter : public LoggingEventPatternConverter
 		LOG4CXX_CAST_ENTRY_CHAIN(LoggingEventPatternConverter)
 		END_LOG4CXX_CAST_MAP()
 
+		/**
+		 * Returns true if names are abbreviated rather than
+		 * output in full.
+		 */
+		bool isAbbreviating() const;
+
+		~NamePatternConverter();
 
 	protected:
 		/**
@@ -67,8 +81,29 @@ class LOG4CXX_EXPORT NamePatternConverter : public LoggingEventPatternConverter
 		 */
 		void abbreviate(int nameStart, LogString& buf) const;
 
+		/**
+		 * Appends a previously cached abbreviation.
+		 * @param key address identifying the name, which must remain
+		 * valid for the life of the process.
+		 * @param buf string buffer to which the abbreviation is appended.
+		 * @return false if nothing is cached for key.
+		 */
+		bool appendCached(const void* key, LogString& buf) const;
+
+		/**
+		 * Caches an abbreviation.  The number of cached names is bounded,
+		 * once the cache is full further names are not added.  Nothing
+		 * is cached unless names are abbreviated.
+		 * @param key address identifying the name, which must remain
+		 * valid for the life of the process.
+		 * @param abbreviated abbreviated name.
+		 */
+		void addCached(const void* key, const LogString& abbreviated) const;
+
 	private:
 		NameAbbreviatorPtr getAbbreviator(const std::vector<LogString>& options);
+		NamePatternConverter(const NamePatternConverter&);
+		NamePatternConverter& operator=(const NamePatternConverter&);
 };
 
 }
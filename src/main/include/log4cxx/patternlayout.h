@@ -27,6 +27,7 @@
 #include <log4cxx/pattern/loggingeventpatternconverter.h>
 #include <log4cxx/pattern/formattinginfo.h>
 #include <log4cxx/pattern/patternparser.h>
+#include <vector>
 
 namespace log4cxx
 {
@@ -127,8 +128,8 @@ LOG4CXX_LIST_DEF(FormattingInfoList, log4cxx::pattern::FormattingInfoPtr);
  *      <td>
  *          Used to output the date of the logging event. The date conversion specifier may
  *          be followed by a set of braces containing a date and time pattern string
- *          compatible with java.text.SimpleDateFormat, <em>ABSOLUTE</em>, <em>DATE</em> or
- *          <em>ISO8601</em>. For example, <strong>%d{HH:mm:ss,SSS}</strong>,
+ *          compatible with java.text.SimpleDateFormat, <em>ABSOLUTE</em>, <em>DATE</em>,
+ *          <em>ISO8601</em> or <em>ISO8601_MICROS</em>, which adds microseconds. For example, <strong>%d{HH:mm:ss,SSS}</strong>,
  *          <strong>%d{dd&nbsp;MMM&nbsp;yyyy&nbsp;HH:mm:ss,SSS}</strong> or <strong>%d{DATE}</strong>. If no
  *          date format specifier is given then ISO8601 format is assumed.
  *      </td>
@@ -339,14 +340,57 @@ class LOG4CXX_EXPORT PatternLayout : public Layout
 		LogString conversionPattern;
 
 		/**
-		 * Pattern converters.
+		 * How a step of the compiled pattern is carried out.
 		 */
-		LoggingEventPatternConverterList patternConverters;
+		enum StepType
+		{
+			LITERAL_STEP,
+			MESSAGE_STEP,
+			LEVEL_STEP,
+			LOGGER_STEP,
+			THREAD_STEP,
+			CONVERTER_STEP
+		};
+
+		/**
+		 * A step of the compiled pattern.
+		 */
+		struct Step
+		{
+			StepType type;
+			/**
+			 * Text appended by a LITERAL_STEP.
+			 */
+			LogString literal;
+			/**
+			 * Converter called by a CONVERTER_STEP.
+			 */
+			log4cxx::pattern::LoggingEventPatternConverterPtr converter;
+			/**
+			 * Field width and alignment, null if the field is
+			 * neither padded nor truncated.
+			 */
+			log4cxx::pattern::FormattingInfoPtr field;
+		};
+
+		/**
+		 * The conversion pattern compiled by activateOptions:
+		 * adjacent literals and line separators are fused,
+		 * default field formatting is dropped and the common
+		 * converters are replaced by built-in steps.
+		 */
+		std::vector<Step> plan;
+
+		/**
+		 * Length reserved in the output before formatting,
+		 * not counting the message.
+		 */
+		size_t expectedLength;
 
 		/**
-		 * Field widths and alignment corresponding to pattern converters.
+		 * True if the plan contains a MESSAGE_STEP.
 		 */
-		FormattingInfoList patternFields;
+		bool formatsMessage;
 
 	public:
 		DECLARE_LOG4CXX_OBJECT(PatternLayout)
@@ -0,0 +1,98 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if !defined(_LOG4CXX_ROLLING_ACTION_EXECUTOR_H)
+#define _LOG4CXX_ROLLING_ACTION_EXECUTOR_H
+
+#if defined(_MSC_VER)
+	#pragma warning ( push )
+	#pragma warning ( disable: 4231 4251 4275 4786 )
+#endif
+
+#include <log4cxx/rolling/action.h>
+#include <log4cxx/helpers/mutex.h>
+#include <log4cxx/helpers/condition.h>
+#include <log4cxx/helpers/thread.h>
+#include <deque>
+#include <vector>
+
+namespace log4cxx
+{
+namespace rolling
+{
+
+/**
+ *  Runs the asynchronous part of rollovers, typically compression,
+ *  on a small pool of background threads shared by all appenders.
+ *
+ *  <p>The workers are started on first use and drain the queue
+ *  before the process exits.  An action is run at most once, so
+ *  #await can run a queued action on the caller's thread instead of
+ *  waiting for a worker to reach it.
+ */
+class LOG4CXX_EXPORT ActionExecutor
+{
+	public:
+		/**
+		 *  Queue an action to be run on a worker thread.
+		 *  Runs it at once when threads are unavailable.
+		 *  @param action action.
+		 */
+		static void execute(const ActionPtr& action);
+
+		/**
+		 *  Wait until an action is complete, running it on
+		 *  the calling thread if no worker has started it.
+		 *  @param action action previously passed to #execute.
+		 */
+		static void await(const ActionPtr& action);
+
+		/**
+		 *  Set the number of worker threads, 2 by default.
+		 *  Takes effect for workers not yet started.
+		 *  @param count number of threads.
+		 */
+		static void setThreadCount(int count);
+
+	private:
+		ActionExecutor();
+		~ActionExecutor();
+		ActionExecutor(const ActionExecutor&);
+		ActionExecutor& operator=(const ActionExecutor&);
+
+		static ActionExecutor& getInstance();
+		void enqueue(const ActionPtr& action);
+
+		static void* LOG4CXX_THREAD_FUNC work(apr_thread_t* thread, void* data);
+
+		log4cxx::helpers::Pool pool;
+		log4cxx::helpers::Mutex mutex;
+		log4cxx::helpers::Condition pending;
+		std::deque<ActionPtr> queue;
+		std::vector<log4cxx::helpers::Thread*> workers;
+		size_t threadCount;
+		bool closed;
+};
+
+}
+}
+
+#if defined(_MSC_VER)
+	#pragma warning ( pop )
+#endif
+
+#endif
@@ -37,6 +37,7 @@ class GZCompressAction : public Action
 		const File source;
 		const File destination;
 		bool deleteSource;
+		int level;
 	public:
 		DECLARE_ABSTRACT_LOG4CXX_OBJECT(GZCompressAction)
 		BEGIN_LOG4CXX_CAST_MAP()
@@ -51,6 +52,15 @@ class GZCompressAction : public Action
 			const File& destination,
 			bool deleteSource);
 
+		/**
+		 * Constructor.
+		 * @param level deflate level from 1 to 9, -1 for the zlib default.
+		 */
+		GZCompressAction(const File& source,
+			const File& destination,
+			bool deleteSource,
+			int level);
+
 		/**
 		 * Perform action.
 		 *
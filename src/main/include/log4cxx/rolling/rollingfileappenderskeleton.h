@@ -64,6 +64,12 @@ class LOG4CXX_EXPORT RollingFileAppenderSkeleton : public FileAppender
 		 *  save the loggingevent
 		 */
 		spi::LoggingEventPtr* _event;
+
+		/**
+		 *  Asynchronous action of the last rollover, awaited before the
+		 *  next rollover so that renames never race compression.
+		 */
+		ActionPtr pendingAction;
 	public:
 		/**
 		 * The default constructor simply calls its {@link
@@ -97,6 +103,12 @@ class LOG4CXX_EXPORT RollingFileAppenderSkeleton : public FileAppender
 		*/
 		virtual void subAppend(const spi::LoggingEventPtr& event, log4cxx::helpers::Pool& p);
 
+		/**
+		 Appends the events one at a time so that the triggering policy
+		 sees each of them.
+		*/
+		virtual void appendAll(const spi::LoggingEventList& events, log4cxx::helpers::Pool& p);
+
 	protected:
 
 		RollingPolicyPtr getRollingPolicy() const;
@@ -28,6 +28,7 @@
 #include <log4cxx/logger.h>
 #include <log4cxx/logmanager.h>
 #include <log4cxx/rolling/rollingpolicy.h>
+#include <log4cxx/rolling/action.h>
 #include <log4cxx/pattern/patternconverter.h>
 #include <log4cxx/pattern/formattinginfo.h>
 #include <log4cxx/pattern/patternparser.h>
@@ -74,6 +75,16 @@ class LOG4CXX_EXPORT RollingPolicyBase :
 		 */
 		LogString fileNamePatternStr;
 
+		/**
+		 * Compression level of rolled files, -1 for the library default.
+		 */
+		int compressionLevel;
+
+		/**
+		 * Worker threads used by zstd to compress one rolled file.
+		 */
+		int compressionThreads;
+
 
 	public:
 		RollingPolicyBase();
@@ -98,6 +109,26 @@ class LOG4CXX_EXPORT RollingPolicyBase :
 		 */
 		LogString getFileNamePattern() const;
 
+		/**
+		 * Set the level used to compress rolled files, from 1 to 9
+		 * for gzip and 1 to 22 for zstd. The default of -1 selects
+		 * the library default.
+		 * @param level compression level.
+		 */
+		void setCompressionLevel(int level);
+
+		int getCompressionLevel() const;
+
+		/**
+		 * Set the number of threads zstd uses to compress a single
+		 * rolled file. The default of 0 compresses on the background
+		 * worker alone.
+		 * @param threads number of threads.
+		 */
+		void setCompressionThreads(int threads);
+
+		int getCompressionThreads() const;
+
 
 #ifdef LOG4CXX_MULTI_PROCESS
 		PatternConverterList getPatternConverterList()
@@ -121,6 +152,26 @@ class LOG4CXX_EXPORT RollingPolicyBase :
 		void formatFileName(log4cxx::helpers::ObjectPtr& obj,
 			LogString& buf, log4cxx::helpers::Pool& p) const;
 
+		/**
+		 * Get the length of the compression suffix,
+		 * ".gz", ".zst" or ".zip", that ends a file name.
+		 * @param fileName file name.
+		 * @return suffix length or 0 if uncompressed.
+		 */
+		static size_t getCompressionSuffixLength(const LogString& fileName);
+
+		/**
+		 * Create the action that compresses a rolled file into
+		 * fileName, chosen by its suffix.
+		 *
+		 * @param fileName compressed file name, the source being
+		 * the same name without the suffix.
+		 * @param deleteSource delete the source once compressed.
+		 * @return compress action or null if fileName has no suffix.
+		 */
+		ActionPtr createCompressAction(const LogString& fileName,
+			bool deleteSource) const;
+
 		log4cxx::pattern::PatternConverterPtr getIntegerPatternConverter() const;
 		log4cxx::pattern::PatternConverterPtr getDatePatternConverter() const;
 
@@ -79,7 +79,11 @@ namespace rolling
  * <h2>Automatic file compression</h2>
  * <code>TimeBasedRollingPolicy</code> supports automatic file compression.
  * This feature is enabled if the value of the <b>FileNamePattern</b> option
- * ends with <code>.gz</code> or <code>.zip</code>.
+ * ends with <code>.gz</code>, <code>.zst</code> or <code>.zip</code>.
+ * Files are compressed on a shared background thread, in-process
+ * when log4cxx is built with zlib or libzstd, at the level given by
+ * the <b>CompressionLevel</b> option; <b>CompressionThreads</b> lets
+ * zstd spread one file over several threads.
  * <p>
  * <table cellspacing="5px" border="1">
  *   <tr>
@@ -205,7 +209,7 @@ class LOG4CXX_EXPORT TimeBasedRollingPolicy : public RollingPolicyBase,
 		LogString _fileNamePattern;
 
 		/**
-		 * Length of any file type suffix (.gz, .zip).
+		 * Length of any file type suffix (.gz, .zst, .zip).
 		 */
 		int suffixLength;
 
@@ -50,7 +50,10 @@ class LOG4CXX_EXPORT LocationInfo
 		/**
 		 *   Constructor.
 		 *   @remarks Used by LOG4CXX_LOCATION to generate
-		 *       location info for current code site
+		 *       location info for current code site.  The names are
+		 *       kept by pointer and must remain valid for the life of
+		 *       the process, as string literals do, since layouts
+		 *       identify a call site by the address of its function name.
 		 */
 		LocationInfo( const char* const fileName,
 			const char* const functionName,
@@ -88,6 +91,13 @@ class LOG4CXX_EXPORT LocationInfo
 		 */
 		const char* getFileName() const;
 
+		/**
+		 *   Returns the function name as given to the constructor,
+		 *   from which the class and method names are derived.
+		 *   @returns function name.
+		 */
+		const char* getFunctionName() const;
+
 		/**
 		  *   Returns the line number of the caller.
 		  * @returns line number, -1 if not available.
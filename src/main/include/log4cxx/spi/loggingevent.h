@@ -31,6 +31,8 @@
 #include <log4cxx/logger.h>
 #include <log4cxx/mdc.h>
 #include <log4cxx/spi/location/locationinfo.h>
+#include <log4cxx/helpers/threadname.h>
+#include <log4cxx/helpers/deferredmessage.h>
 #include <vector>
 
 
@@ -78,13 +80,83 @@ class LOG4CXX_EXPORT LoggingEvent :
 		@param level The level of this event.
 		@param message  The message of this event.
 		@param location location of logging request.
+		@param internedLogger the logger name interned by
+		helpers::InternedStrings, or null if it is not interned.
 		*/
 		LoggingEvent(const LogString& logger,
 			const LevelPtr& level,   const LogString& message,
+			const log4cxx::spi::LocationInfo& location,
+			const LogString* internedLogger = 0);
+
+		/**
+		Instantiate a LoggingEvent that takes the content of the
+		supplied message instead of copying it.
+
+		@param logger The logger of this event.
+		@param level The level of this event.
+		@param message  The message of this event, which is swapped
+		with the event's initially empty message.
+		@param location location of logging request.
+		@param internedLogger the logger name interned by
+		helpers::InternedStrings, or null if it is not interned.
+		*/
+		LoggingEvent(const LogString& logger,
+			const LevelPtr& level, LogString* message,
+			const log4cxx::spi::LocationInfo& location,
+			const LogString* internedLogger = 0);
+
+		/**
+		Instantiate a LoggingEvent whose message is rendered from
+		the supplied format and arguments when first requested.
+
+		@param logger The logger of this event.
+		@param level The level of this event.
+		@param message  The captured format and arguments.
+		@param location location of logging request.
+		@param internedLogger the logger name interned by
+		helpers::InternedStrings, or null if it is not interned.
+		*/
+		LoggingEvent(const LogString& logger,
+			const LevelPtr& level, const helpers::DeferredMessage& message,
+			const log4cxx::spi::LocationInfo& location,
+			const LogString* internedLogger = 0);
+
+		/**
+		Instantiate a LoggingEvent that was recorded earlier, for
+		example one read back by helpers::BinaryLogReader.  The
+		thread name, NDC and MDC are taken from the parameters
+		instead of the current thread.
+
+		@param timeStamp time the event was originally created.
+		@param logger The logger of this event.
+		@param level The level of this event.
+		@param message  The message of this event.
+		@param threadName name of the thread that created the event.
+		@param ndc nested diagnostic context, or null if there was none.
+		@param mdc mapped diagnostic context.
+		@param location location of logging request.
+		*/
+		LoggingEvent(log4cxx_time_t timeStamp, const LogString& logger,
+			const LevelPtr& level, const LogString& message,
+			const helpers::ThreadNamePtr& threadName,
+			const LogString* ndc, const MDC::Map& mdc,
 			const log4cxx::spi::LocationInfo& location);
 
 		~LoggingEvent();
 
+		/**
+		 *  Allocates an event from the current thread's cache of
+		 *  recycled events, so that steady logging does not
+		 *  allocate from the heap.
+		 */
+		static void* operator new(size_t size);
+		/**
+		 *  Returns an event to the cache of the thread that allocated
+		 *  it once its last reference is released, on whatever thread
+		 *  that happens.
+		 */
+		static void operator delete(void* ptr, size_t size);
+
 		/** Return the level of this event. */
 		inline const LevelPtr& getLevel() const
 		{
@@ -97,16 +169,30 @@ class LOG4CXX_EXPORT LoggingEvent :
 			return logger;
 		}
 
+		/**
+		Return the interned name of the logger, which identifies it
+		by address, or null if the event's creator did not intern it.
+		*/
+		inline const LogString* getInternedLoggerName() const
+		{
+			return internedLogger;
+		}
+
 		/** Return the message for this logging event. */
 		inline const LogString& getMessage() const
 		{
+			if (messageState != MESSAGE_RENDERED)
+			{
+				renderMessage();
+			}
+
 			return message;
 		}
 
 		/** Return the message for this logging event. */
 		inline const LogString& getRenderedMessage() const
 		{
-			return message;
+			return getMessage();
 		}
 
 		/**Returns the time when the application started,
@@ -117,7 +203,7 @@ class LOG4CXX_EXPORT LoggingEvent :
 		/** Return the threadName of this event. */
 		inline const LogString& getThreadName() const
 		{
-			return threadName;
+			return threadName->getName();
 		}
 
 		/** The number of microseconds elapsed from 01.01.1970 until logging event
@@ -209,6 +295,9 @@ class LOG4CXX_EXPORT LoggingEvent :
 		**/
 		LogString logger;
 
+		/** The logger name interned by helpers::InternedStrings, or null. */
+		const LogString* internedLogger;
+
 		/** level of logging event. */
 		LevelPtr level;
 
@@ -238,7 +327,25 @@ class LOG4CXX_EXPORT LoggingEvent :
 		mutable bool mdcCopyLookupRequired;
 
 		/** The application supplied message of logging event. */
-		LogString message;
+		mutable LogString message;
+
+		/**
+		The format and arguments the message is rendered from, kept
+		inline so that a deferred request allocates nothing beyond the
+		event.  Only meaningful while the message is deferred.
+		*/
+		mutable helpers::DeferredMessage deferredMessage;
+
+		enum { MESSAGE_RENDERED, MESSAGE_DEFERRED, MESSAGE_RENDERING };
+
+		/** Whether message has been rendered yet. */
+		mutable unsigned int volatile messageState;
+
+		/**
+		Renders the deferred message, or waits for the
+		thread that is already rendering it.
+		*/
+		void renderMessage() const;
 
 
 		/** The number of microseconds elapsed from 01.01.1970 until logging event
@@ -252,14 +359,13 @@ class LOG4CXX_EXPORT LoggingEvent :
 		/** The identifier of thread in which this logging event
 		was generated.
 		*/
-		const LogString threadName;
+		const helpers::ThreadNamePtr threadName;
 
 		//
 		//   prevent copy and assignment
 		//
 		LoggingEvent(const LoggingEvent&);
 		LoggingEvent& operator=(const LoggingEvent&);
-		static const LogString getCurrentThreadName();
 
 		static void writeProlog(log4cxx::helpers::ObjectOutputStream& os, log4cxx::helpers::Pool& p);
 
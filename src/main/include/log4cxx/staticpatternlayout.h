@@ -0,0 +1,767 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_STATIC_PATTERN_LAYOUT_H
+#define _LOG4CXX_STATIC_PATTERN_LAYOUT_H
+
+#if defined(_MSC_VER)
+	#pragma warning ( push )
+	#pragma warning ( disable: 4231 4251 4275 4786 )
+#endif
+
+#include <log4cxx/layout.h>
+#include <log4cxx/level.h>
+#include <log4cxx/pattern/loggingeventpatternconverter.h>
+#include <log4cxx/pattern/datepatternconverter.h>
+#include <log4cxx/pattern/relativetimepatternconverter.h>
+#include <log4cxx/pattern/ndcpatternconverter.h>
+#include <log4cxx/pattern/filelocationpatternconverter.h>
+#include <log4cxx/pattern/linelocationpatternconverter.h>
+#include <log4cxx/pattern/methodlocationpatternconverter.h>
+#include <log4cxx/pattern/fulllocationpatternconverter.h>
+#include <log4cxx/pattern/loggerpatternconverter.h>
+#include <log4cxx/pattern/classnamepatternconverter.h>
+#include <log4cxx/pattern/propertiespatternconverter.h>
+#include <limits.h>
+#include <vector>
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1910)
+	#include <type_traits>
+#endif
+
+namespace log4cxx
+{
+namespace pattern
+{
+
+/**
+ * Placeholder for the unused trailing fields of a StaticPatternLayout.
+ */
+struct NoField
+{
+	void format(const spi::LoggingEventPtr&, LogString&,
+		helpers::Pool&) const {}
+};
+
+/**
+ * The rendered message, as <code>%m</code>.
+ */
+struct MessageField
+{
+	void format(const spi::LoggingEventPtr& event, LogString& output,
+		helpers::Pool&) const
+	{
+		output.append(event->getRenderedMessage());
+	}
+};
+
+/**
+ * The level name, as <code>%p</code>.
+ */
+struct LevelField
+{
+	void format(const spi::LoggingEventPtr& event, LogString& output,
+		helpers::Pool&) const
+	{
+		output.append(event->getLevel()->toString());
+	}
+};
+
+/**
+ * The full logger name, as <code>%c</code>.
+ */
+struct LoggerField
+{
+	void format(const spi::LoggingEventPtr& event, LogString& output,
+		helpers::Pool&) const
+	{
+		output.append(event->getLoggerName());
+	}
+};
+
+/**
+ * The thread name, as <code>%t</code>.
+ */
+struct ThreadField
+{
+	void format(const spi::LoggingEventPtr& event, LogString& output,
+		helpers::Pool&) const
+	{
+		output.append(event->getThreadName());
+	}
+};
+
+/**
+ * The platform line separator, as <code>%n</code>.
+ */
+struct LineSeparatorField
+{
+	void format(const spi::LoggingEventPtr&, LogString& output,
+		helpers::Pool&) const
+	{
+		output.append(LOG4CXX_EOL);
+	}
+};
+
+/**
+ * Up to eight literal characters.  Longer literals are written as
+ * several consecutive Text fields.
+ */
+template<logchar c1, logchar c2 = 0, logchar c3 = 0, logchar c4 = 0,
+	logchar c5 = 0, logchar c6 = 0, logchar c7 = 0, logchar c8 = 0>
+struct Text
+{
+	void format(const spi::LoggingEventPtr&, LogString& output,
+		helpers::Pool&) const
+	{
+		const logchar text[] = { c1, c2, c3, c4, c5, c6, c7, c8, 0 };
+		output.append(text);
+	}
+};
+
+/**
+ * Applies a format modifier to another field, as
+ * <code>%-5p</code> or <code>%.16c</code> do.  Padding and truncation
+ * follow FormattingInfo.
+ */
+template<class Field, bool leftAlign, int minLength, int maxLength = INT_MAX>
+struct Formatted
+{
+	Field field;
+
+	void format(const spi::LoggingEventPtr& event, LogString& output,
+		helpers::Pool& pool) const
+	{
+		LogString::size_type fieldStart = output.length();
+		field.format(event, output, pool);
+		int rawLength = (int) (output.length() - fieldStart);
+
+		if (rawLength > maxLength)
+		{
+			output.erase(output.begin() + fieldStart,
+				output.begin() + fieldStart + (rawLength - maxLength));
+		}
+		else if (rawLength < minLength)
+		{
+			if (leftAlign)
+			{
+				output.append(minLength - rawLength, (logchar) 0x20 /* ' ' */);
+			}
+			else
+			{
+				output.insert(fieldStart, minLength - rawLength, 0x20 /* ' ' */);
+			}
+		}
+	}
+};
+
+/**
+ * No option for a ConverterField.
+ */
+struct NoOption
+{
+	static const logchar* value()
+	{
+		return 0;
+	}
+};
+
+/**
+ * Any other conversion, delegated to the pattern converter that
+ * PatternLayout would use.  Option, when given, supplies the text between
+ * the braces through a static <code>value()</code> member, for example
+ * the date format of <code>%d{ABSOLUTE}</code>.
+ */
+template<class Converter, class Option = NoOption>
+struct ConverterField
+{
+	LoggingEventPatternConverterPtr converter;
+
+	ConverterField() : converter(create())
+	{
+	}
+
+	void format(const spi::LoggingEventPtr& event, LogString& output,
+		helpers::Pool& pool) const
+	{
+		converter->format(event, output, pool);
+	}
+
+	private:
+		static PatternConverterPtr create()
+		{
+			std::vector<LogString> options;
+
+			if (Option::value() != 0)
+			{
+				options.push_back(Option::value());
+			}
+
+			return Converter::newInstance(options);
+		}
+};
+
+typedef ConverterField<DatePatternConverter> DateField;
+typedef ConverterField<RelativeTimePatternConverter> RelativeTimeField;
+typedef ConverterField<NDCPatternConverter> NDCField;
+typedef ConverterField<FileLocationPatternConverter> FileLocationField;
+typedef ConverterField<LineLocationPatternConverter> LineLocationField;
+typedef ConverterField<MethodLocationPatternConverter> MethodLocationField;
+typedef ConverterField<FullLocationPatternConverter> FullLocationField;
+typedef ConverterField<FullLocationPatternConverter> FullLocationField;
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1910)
+/**
+ * Several fields written one after another.
+ */
+template<class... Fields>
+struct FieldSequence
+{
+	void format(const spi::LoggingEventPtr&, LogString&,
+		helpers::Pool&) const {}
+};
+
+template<class Field, class... Rest>
+struct FieldSequence<Field, Rest...>
+{
+	Field first;
+	FieldSequence<Rest...> rest;
+
+	void format(const spi::LoggingEventPtr& event, LogString& output,
+		helpers::Pool& pool) const
+	{
+		first.format(event, output, pool);
+		rest.format(event, output, pool);
+	}
+};
+
+/**
+ * The characters from begin up to end of a pattern, written as they are.
+ */
+template<class Pattern, int begin, int end>
+struct PatternLiteral
+{
+	void format(const spi::LoggingEventPtr&, LogString& output,
+		helpers::Pool&) const
+	{
+		output.append(Pattern::value() + begin, end - begin);
+	}
+};
+
+/**
+ * A conversion delegated to its pattern converter, with the options
+ * taken from the braces between begin and end of a pattern.
+ */
+template<class Converter, class Pattern, int begin, int end>
+struct PatternConverterField
+{
+	LoggingEventPatternConverterPtr converter;
+
+	PatternConverterField() : converter(create())
+	{
+	}
+
+	void format(const spi::LoggingEventPtr& event, LogString& output,
+		helpers::Pool& pool) const
+	{
+		converter->format(event, output, pool);
+	}
+
+	private:
+		static PatternConverterPtr create()
+		{
+			const logchar* pattern = Pattern::value();
+			std::vector<LogString> options;
+			int i = begin;
+
+			while (i < end)
+			{
+				int close = i + 1;
+
+				while (pattern[close] != 0x7D /* '}' */)
+				{
+					close++;
+				}
+
+				options.push_back(LogString(pattern + i + 1, pattern + close));
+				i = close + 1;
+			}
+
+			return Converter::newInstance(options);
+		}
+};
+
+/**
+ * Compile time counterpart of the scanning done by PatternParser.
+ */
+struct PatternSyntax
+{
+	enum
+	{
+		NO_CONVERTER,
+		LOGGER,
+		CLASS_NAME,
+		DATE,
+		FILE_LOCATION,
+		FULL_LOCATION,
+		LINE_LOCATION,
+		MESSAGE,
+		LINE_SEPARATOR,
+		METHOD_LOCATION,
+		LEVEL,
+		RELATIVE_TIME,
+		THREAD,
+		NDC,
+		PROPERTIES
+	};
+
+	enum
+	{
+		END,
+		LITERAL,
+		PERCENT,
+		CONVERSION
+	};
+
+	static constexpr int kind(const logchar* s, int i)
+	{
+		return s[i] == 0 ? END :
+			s[i] != 0x25 /* '%' */ ? LITERAL :
+			s[i + 1] == 0 ? LITERAL :
+			s[i + 1] == 0x25 /* '%' */ ? PERCENT : CONVERSION;
+	}
+
+	static constexpr int literalEnd(const logchar* s, int i)
+	{
+		return s[i] == 0 || s[i] == 0x25 /* '%' */ ? i : literalEnd(s, i + 1);
+	}
+
+	static constexpr bool isDigit(logchar c)
+	{
+		return c >= 0x30 /* '0' */ && c <= 0x39 /* '9' */;
+	}
+
+	static constexpr bool isIdentifierStart(logchar c)
+	{
+		return (c >= 0x41 /* 'A' */ && c <= 0x5A /* 'Z' */)
+			|| (c >= 0x61 /* 'a' */ && c <= 0x7A /* 'z' */)
+			|| isDigit(c);
+	}
+
+	static constexpr int digitsEnd(const logchar* s, int i)
+	{
+		return isDigit(s[i]) ? digitsEnd(s, i + 1) : i;
+	}
+
+	static constexpr int number(const logchar* s, int i, int end, int value)
+	{
+		return i == end ? value : number(s, i + 1, end, value * 10 + (s[i] - 0x30));
+	}
+
+	static constexpr int wordEnd(const logchar* s, int i)
+	{
+		return isIdentifierStart(s[i]) || s[i] == 0x5F /* '_' */ ?
+			wordEnd(s, i + 1) : i;
+	}
+
+	static constexpr int optionsEnd(const logchar* s, int i)
+	{
+		return s[i] == 0x7B /* '{' */ && s[closeEnd(s, i)] != 0 ?
+			optionsEnd(s, closeEnd(s, i) + 1) : i;
+	}
+
+	static constexpr int closeEnd(const logchar* s, int i)
+	{
+		return s[i] == 0 || s[i] == 0x7D /* '}' */ ? i : closeEnd(s, i + 1);
+	}
+
+	static constexpr bool matches(const logchar* s, int i, int length,
+		const char* name)
+	{
+		return length == 0 ? *name == 0 :
+			*name != 0 && s[i] == (logchar) *name
+			&& matches(s, i + 1, length - 1, name + 1);
+	}
+
+	/**
+	 * The converter named by the length characters at i, as in the
+	 * rules of PatternLayout.
+	 */
+	static constexpr int converter(const logchar* s, int i, int length)
+	{
+		return matches(s, i, length, "c") || matches(s, i, length, "logger") ? LOGGER :
+			matches(s, i, length, "C") || matches(s, i, length, "class") ? CLASS_NAME :
+			matches(s, i, length, "d") || matches(s, i, length, "date") ? DATE :
+			matches(s, i, length, "F") || matches(s, i, length, "file") ? FILE_LOCATION :
+			matches(s, i, length, "l") ? FULL_LOCATION :
+			matches(s, i, length, "L") || matches(s, i, length, "line") ? LINE_LOCATION :
+			matches(s, i, length, "m") || matches(s, i, length, "message") ? MESSAGE :
+			matches(s, i, length, "n") ? LINE_SEPARATOR :
+			matches(s, i, length, "M") || matches(s, i, length, "method") ? METHOD_LOCATION :
+			matches(s, i, length, "p") || matches(s, i, length, "level") ? LEVEL :
+			matches(s, i, length, "r") || matches(s, i, length, "relative") ? RELATIVE_TIME :
+			matches(s, i, length, "t") || matches(s, i, length, "thread") ? THREAD :
+			matches(s, i, length, "x") || matches(s, i, length, "ndc") ? NDC :
+			matches(s, i, length, "X") || matches(s, i, length, "properties") ? PROPERTIES :
+			NO_CONVERTER;
+	}
+
+	/**
+	 * Length of the longest leading part of a conversion word that
+	 * names a converter, the rest of the word is literal text.
+	 */
+	static constexpr int converterLength(const logchar* s, int i, int length)
+	{
+		return length == 0 || converter(s, i, length) != NO_CONVERTER ?
+			length : converterLength(s, i, length - 1);
+	}
+};
+
+/**
+ * The field for one converter, given its options.
+ */
+template<int converter, class Pattern, int begin, int end>
+struct ConversionField;
+
+/**
+ * A dedicated field when there are no options, the pattern converter
+ * otherwise.
+ */
+template<class Plain, class Converter, class Pattern, int begin, int end,
+	bool hasOptions = (begin != end)>
+struct OptionalConverterField
+{
+	typedef PatternConverterField<Converter, Pattern, begin, end> type;
+};
+
+template<class Plain, class Converter, class Pattern, int begin, int end>
+struct OptionalConverterField<Plain, Converter, Pattern, begin, end, false>
+{
+	typedef Plain type;
+};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::LOGGER, Pattern, begin, end>
+	: OptionalConverterField<LoggerField, LoggerPatternConverter,
+	  Pattern, begin, end> {};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::CLASS_NAME, Pattern, begin, end>
+{
+	typedef PatternConverterField<ClassNamePatternConverter,
+		Pattern, begin, end> type;
+};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::DATE, Pattern, begin, end>
+	: OptionalConverterField<DateField, DatePatternConverter,
+	  Pattern, begin, end> {};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::FILE_LOCATION, Pattern, begin, end>
+{
+	typedef FileLocationField type;
+};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::FULL_LOCATION, Pattern, begin, end>
+{
+	typedef FullLocationField type;
+};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::LINE_LOCATION, Pattern, begin, end>
+{
+	typedef LineLocationField type;
+};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::MESSAGE, Pattern, begin, end>
+{
+	typedef MessageField type;
+};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::LINE_SEPARATOR, Pattern, begin, end>
+{
+	typedef LineSeparatorField type;
+};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::METHOD_LOCATION, Pattern, begin, end>
+{
+	typedef MethodLocationField type;
+};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::LEVEL, Pattern, begin, end>
+{
+	typedef LevelField type;
+};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::RELATIVE_TIME, Pattern, begin, end>
+{
+	typedef RelativeTimeField type;
+};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::THREAD, Pattern, begin, end>
+{
+	typedef ThreadField type;
+};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::NDC, Pattern, begin, end>
+{
+	typedef NDCField type;
+};
+
+template<class Pattern, int begin, int end>
+struct ConversionField<PatternSyntax::PROPERTIES, Pattern, begin, end>
+{
+	typedef PatternConverterField<PropertiesPatternConverter,
+		Pattern, begin, end> type;
+};
+
+/**
+ * Wraps a field in Formatted unless the modifier changes nothing.
+ */
+template<class Field, bool leftAlign, int minLength, int maxLength>
+struct ModifiedField
+{
+	typedef Formatted<Field, leftAlign, minLength, maxLength> type;
+};
+
+template<class Field>
+struct ModifiedField<Field, false, 0, INT_MAX>
+{
+	typedef Field type;
+};
+
+template<class Sequence, class Field>
+struct AppendField;
+
+template<class... Fields, class Field>
+struct AppendField<FieldSequence<Fields...>, Field>
+{
+	typedef FieldSequence<Fields..., Field> type;
+};
+
+/**
+ * The positions of one conversion, such as <code>%-5.16logger{2}</code>,
+ * that starts at index start of a pattern.
+ */
+template<class Pattern, int start>
+struct Conversion
+{
+	static constexpr bool leftAlign = Pattern::value()[start + 1] == 0x2D /* '-' */;
+	static constexpr int minStart = start + 1 + (leftAlign ? 1 : 0);
+	static constexpr int minEnd = PatternSyntax::digitsEnd(Pattern::value(), minStart);
+	static constexpr int minLength = PatternSyntax::number(Pattern::value(), minStart, minEnd, 0);
+	static constexpr bool truncates = Pattern::value()[minEnd] == 0x2E /* '.' */;
+	static constexpr int wordStart = truncates ?
+		PatternSyntax::digitsEnd(Pattern::value(), minEnd + 1) : minEnd;
+	static constexpr int maxLength = truncates ?
+		PatternSyntax::number(Pattern::value(), minEnd + 1, wordStart, 0) : INT_MAX;
+	static constexpr int wordEnd = PatternSyntax::wordEnd(Pattern::value(), wordStart);
+	static constexpr int converterEnd = wordStart
+		+ PatternSyntax::converterLength(Pattern::value(), wordStart, wordEnd - wordStart);
+	static constexpr int converter = PatternSyntax::converter(Pattern::value(),
+			wordStart, converterEnd - wordStart);
+	static constexpr int next = PatternSyntax::optionsEnd(Pattern::value(), wordEnd);
+
+	static_assert(converter != PatternSyntax::NO_CONVERTER,
+		"unrecognized conversion specifier in static pattern");
+
+	typedef typename ModifiedField<
+		typename ConversionField<converter, Pattern, wordEnd, next>::type,
+		leftAlign, minLength, maxLength>::type field;
+};
+
+/**
+ * Adds the fields for the pattern from index start onwards to Sequence.
+ */
+template<class Pattern, int start, class Sequence,
+	int kind = PatternSyntax::kind(Pattern::value(), start)>
+struct PatternFields
+{
+	typedef Sequence type;
+};
+
+template<class Pattern, int start, class Sequence>
+struct PatternFields<Pattern, start, Sequence, PatternSyntax::LITERAL>
+{
+	static constexpr int end = PatternSyntax::literalEnd(Pattern::value(), start + 1);
+	typedef typename PatternFields<Pattern, end,
+		typename AppendField<Sequence,
+		PatternLiteral<Pattern, start, end> >::type>::type type;
+};
+
+template<class Pattern, int start, class Sequence>
+struct PatternFields<Pattern, start, Sequence, PatternSyntax::PERCENT>
+{
+	typedef typename PatternFields<Pattern, start + 2,
+		typename AppendField<Sequence,
+		PatternLiteral<Pattern, start + 1, start + 2> >::type>::type type;
+};
+
+template<class Pattern, int start, class Sequence>
+struct PatternFields<Pattern, start, Sequence, PatternSyntax::CONVERSION>
+{
+	typedef Conversion<Pattern, start> conversion;
+	typedef typename AppendField<Sequence,
+		typename conversion::field>::type withConverter;
+
+	//
+	//   the rest of a word such as %mx is literal text,
+	//      the options still belong to the converter
+	//
+	typedef typename std::conditional<
+		conversion::converterEnd != conversion::wordEnd,
+		typename AppendField<withConverter, PatternLiteral<Pattern,
+		conversion::converterEnd, conversion::wordEnd> >::type,
+		withConverter>::type withLiteral;
+
+	typedef typename PatternFields<Pattern, conversion::next,
+		withLiteral>::type type;
+};
+
+/**
+ * The fields of a conversion pattern, parsed while compiling.  Pattern
+ * supplies the pattern through a <code>static constexpr</code>
+ * <code>value()</code> member, for example
+ *
+ * <pre>
+ * struct MyPattern
+ * {
+ *     static constexpr const logchar* value()
+ *     {
+ *         return LOG4CXX_STR("%-5p [%t] %c - %m%n");
+ *     }
+ * };
+ * typedef StaticPatternLayout&lt;pattern::Parsed&lt;MyPattern&gt; &gt; MyLayout;
+ * </pre>
+ *
+ * <p>The conversions are those of PatternLayout except
+ * <code>%throwable</code>, an unrecognized one fails to compile.</p>
+ */
+template<class Pattern>
+struct Parsed : PatternFields<Pattern, 0, FieldSequence<> >::type
+{
+};
+#endif
+}
+
+/**
+ * A layout whose conversion pattern is fixed at compile time.
+ *
+ * <p>The pattern is spelled as a sequence of field types from
+ * log4cxx::pattern rather than as a string, so there is nothing to parse
+ * when the layout is created and each event is formatted by inlined calls
+ * in place of a loop over converters.  The output is identical to that of
+ * a PatternLayout with the equivalent pattern.  For example,
+ * <code>%-5p [%t] %c - %m%n</code> is written as</p>
+ *
+ * <pre>
+ * using namespace log4cxx::pattern;
+ * typedef StaticPatternLayout&lt;Formatted&lt;LevelField, true, 5&gt;,
+ *     Text&lt;' ', '['&gt;, ThreadField, Text&lt;']', ' '&gt;, LoggerField,
+ *     Text&lt;' ', '-', ' '&gt;, MessageField, LineSeparatorField&gt; MyLayout;
+ * LayoutPtr layout(new MyLayout());
+ * </pre>
+ *
+ * <p>With a C++11 compiler the fields can instead be parsed from the
+ * pattern string while compiling, see pattern::Parsed.  The type list
+ * above is what C++98 builds have to use.</p>
+ *
+ * <p>The layout has no options and can not be named in a configuration
+ * file.</p>
+ */
+template<class F1, class F2 = pattern::NoField, class F3 = pattern::NoField,
+	class F4 = pattern::NoField, class F5 = pattern::NoField,
+	class F6 = pattern::NoField, class F7 = pattern::NoField,
+	class F8 = pattern::NoField, class F9 = pattern::NoField,
+	class F10 = pattern::NoField, class F11 = pattern::NoField,
+	class F12 = pattern::NoField, class F13 = pattern::NoField,
+	class F14 = pattern::NoField, class F15 = pattern::NoField,
+	class F16 = pattern::NoField>
+class StaticPatternLayout : public Layout
+{
+		F1 f1;
+		F2 f2;
+		F3 f3;
+		F4 f4;
+		F5 f5;
+		F6 f6;
+		F7 f7;
+		F8 f8;
+		F9 f9;
+		F10 f10;
+		F11 f11;
+		F12 f12;
+		F13 f13;
+		F14 f14;
+		F15 f15;
+		F16 f16;
+
+	public:
+		StaticPatternLayout()
+		{
+		}
+
+		void format(LogString& output,
+			const spi::LoggingEventPtr& event,
+			log4cxx::helpers::Pool& pool) const
+		{
+			f1.format(event, output, pool);
+			f2.format(event, output, pool);
+			f3.format(event, output, pool);
+			f4.format(event, output, pool);
+			f5.format(event, output, pool);
+			f6.format(event, output, pool);
+			f7.format(event, output, pool);
+			f8.format(event, output, pool);
+			f9.format(event, output, pool);
+			f10.format(event, output, pool);
+			f11.format(event, output, pool);
+			f12.format(event, output, pool);
+			f13.format(event, output, pool);
+			f14.format(event, output, pool);
+			f15.format(event, output, pool);
+			f16.format(event, output, pool);
+		}
+
+		bool ignoresThrowable() const
+		{
+			return true;
+		}
+
+		void activateOptions(log4cxx::helpers::Pool&)
+		{
+		}
+
+		void setOption(const LogString&, const LogString&)
+		{
+		}
+};
+}
+
+#if defined(_MSC_VER)
+	#pragma warning ( pop )
+#endif
+
+#endif //_LOG4CXX_STATIC_PATTERN_LAYOUT_H
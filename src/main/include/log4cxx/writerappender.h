@@ -25,6 +25,7 @@
 
 #include <log4cxx/appenderskeleton.h>
 #include <log4cxx/helpers/outputstreamwriter.h>
+#include <typeinfo>
 
 namespace log4cxx
 {
@@ -67,6 +68,14 @@ class LOG4CXX_EXPORT WriterAppender : public AppenderSkeleton
 		*/
 		log4cxx::helpers::WriterPtr writer;
 
+		/**
+		The type whose instances #appendAll may format and write in
+		one batch.  Only classes that do not override #subAppend opt
+		in, so that an appender of any subclass, which may override
+		it, has each event go through #append instead.
+		*/
+		const std::type_info* batchingType;
+
 
 	public:
 		DECLARE_ABSTRACT_LOG4CXX_OBJECT(WriterAppender)
@@ -198,6 +207,22 @@ class LOG4CXX_EXPORT WriterAppender : public AppenderSkeleton
 		*/
 		virtual void subAppend(const spi::LoggingEventPtr& event, log4cxx::helpers::Pool& p);
 
+		/**
+		 When the writer is an OutputStreamWriter the events are formatted
+		 to bytes and handed to the output stream in a single
+		 OutputStream#writeAll call, otherwise each event goes
+		 through #subAppend.  Appenders of a class that has not
+		 opted in with #setBatchingType have each event go through
+		 #append.
+		*/
+		virtual void appendAll(const spi::LoggingEventList& events, log4cxx::helpers::Pool& p);
+
+		/**
+		 Lets #appendAll batch the events of an appender of exactly
+		 the given type, which must not override #subAppend.
+		*/
+		void setBatchingType(const std::type_info& type);
+
 
 		/**
 		Write a footer as produced by the embedded layout's
@@ -210,6 +235,12 @@ class LOG4CXX_EXPORT WriterAppender : public AppenderSkeleton
 		virtual void writeHeader(log4cxx::helpers::Pool& p);
 
 	private:
+		/**
+		 *  Writes encoded bytes straight to the output stream.
+		 */
+		void writeBytes(const log4cxx::helpers::OutputStreamWriterPtr& out,
+			const std::string& bytes, log4cxx::helpers::Pool& p);
+
 		//
 		//  prevent copy and assignment
 		WriterAppender(const WriterAppender&);
@@ -117,6 +117,8 @@ class AsyncAppenderTestCase : public AppenderSkeletonTestCase
                 //LOGUNIT_TEST(testBadAppender);
                 LOGUNIT_TEST(testLocationInfoTrue);
                 LOGUNIT_TEST(testConfiguration);
+                LOGUNIT_TEST(testRingBuffer);
+                LOGUNIT_TEST(testRingBufferDiscard);
         LOGUNIT_TEST_SUITE_END();
 
 
@@ -281,7 +283,69 @@ public:
 //              LOGUNIT_ASSERT_EQUAL(true, vectorAppender->isClosed());
         }
 
-        
+        /**
+         * Tests that a blocking ring buffer smaller than the number
+         * of events delivers every event in order.
+         */
+        void testRingBuffer()
+        {
+                size_t LEN = 200;
+                LoggerPtr root = Logger::getRootLogger();
+                VectorAppenderPtr vectorAppender = new VectorAppender();
+                AsyncAppenderPtr asyncAppender = new AsyncAppender();
+                asyncAppender->setName(LOG4CXX_STR("async-ring"));
+                asyncAppender->addAppender(vectorAppender);
+                asyncAppender->setBufferSize(8);
+                asyncAppender->setRingBuffer(true);
+                Pool p;
+                asyncAppender->activateOptions(p);
+                root->addAppender(asyncAppender);
+
+                for (size_t i = 0; i < LEN; i++) {
+                        LOG4CXX_DEBUG(root, "message" << i);
+                }
+
+                asyncAppender->close();
+
+                const std::vector<spi::LoggingEventPtr>& v = vectorAppender->getVector();
+                LOGUNIT_ASSERT_EQUAL(LEN, v.size());
+                LOGUNIT_ASSERT(v[0]->getMessage() == LOG4CXX_STR("message0"));
+                LOGUNIT_ASSERT(v[LEN - 1]->getMessage() == LOG4CXX_STR("message199"));
+                LOGUNIT_ASSERT_EQUAL(true, vectorAppender->isClosed());
+        }
+
+        /**
+         * Tests that a full non-blocking ring buffer
+         * summarizes the events it discards.
+         */
+        void testRingBufferDiscard() {
+            BlockableVectorAppenderPtr blockableAppender = new BlockableVectorAppender();
+            AsyncAppenderPtr async = new AsyncAppender();
+            async->addAppender(blockableAppender);
+            async->setBufferSize(2);
+            async->setBlocking(false);
+            async->setRingBuffer(true);
+            Pool p;
+            async->activateOptions(p);
+            LoggerPtr rootLogger = Logger::getRootLogger();
+            rootLogger->addAppender(async);
+            {
+                synchronized sync(blockableAppender->getBlocker());
+                for (int i = 0; i < 140; i++) {
+                       LOG4CXX_INFO(rootLogger, "Hello, World");
+                       Thread::sleep(1);
+                }
+                LOG4CXX_ERROR(rootLogger, "That's all folks.");
+            }
+            async->close();
+            const std::vector<spi::LoggingEventPtr>& events = blockableAppender->getVector();
+            LOGUNIT_ASSERT(events.size() > 0);
+            LoggingEventPtr initialEvent = events[0];
+            LoggingEventPtr discardEvent = events[events.size() - 1];
+            LOGUNIT_ASSERT(initialEvent->getMessage() == LOG4CXX_STR("Hello, World"));
+            LOGUNIT_ASSERT(discardEvent->getMessage().substr(0,10) == LOG4CXX_STR("Discarded "));
+        }
+
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(AsyncAppenderTestCase);
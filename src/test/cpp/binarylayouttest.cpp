@@ -0,0 +1,234 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "logunit.h"
+#include <log4cxx/logger.h>
+#include <log4cxx/binarylayout.h>
+#include <log4cxx/patternlayout.h>
+#include <log4cxx/fileappender.h>
+#include <log4cxx/ndc.h>
+#include <log4cxx/mdc.h>
+#include <log4cxx/helpers/binarylogreader.h>
+#include <log4cxx/helpers/fileinputstream.h>
+#include <log4cxx/helpers/fileoutputstream.h>
+#include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/helpers/bytebuffer.h>
+#include <log4cxx/helpers/exception.h>
+#include <log4cxx/helpers/pool.h>
+#include <log4cxx/spi/loggingevent.h>
+#include <vector>
+
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::spi;
+
+#define FILENAME LOG4CXX_STR("output/binarylayout.bin")
+
+/**
+ * Tests for BinaryLayout and BinaryLogReader.
+ *
+ */
+LOGUNIT_CLASS(BinaryLayoutTest) {
+        LOGUNIT_TEST_SUITE(BinaryLayoutTest);
+                LOGUNIT_TEST(testGetContentType);
+                LOGUNIT_TEST(testRoundTrip);
+                LOGUNIT_TEST(testRender);
+                LOGUNIT_TEST(testAppendedFiles);
+                LOGUNIT_TEST(testTruncated);
+                LOGUNIT_TEST(testBufferedIO);
+        LOGUNIT_TEST_SUITE_END();
+
+  /**
+   * Owns the location strings of the events last read back.
+   */
+  BinaryLogReaderPtr reader;
+
+public:
+  void setUp() {
+      NDC::clear();
+      MDC::clear();
+  }
+
+  void tearDown() {
+      setUp();
+      reader = 0;
+  }
+
+  void testGetContentType() {
+    LogString expected(LOG4CXX_STR("application/octet-stream"));
+    LogString actual(BinaryLayout().getContentType());
+    LOGUNIT_ASSERT(expected == actual);
+  }
+
+  /**
+   * Reads back events written with every optional field.
+   */
+  void testRoundTrip() {
+    std::vector<LoggingEventPtr> events(createEvents());
+    write(events, false);
+    std::vector<LoggingEventPtr> actual(read());
+    LOGUNIT_ASSERT_EQUAL(events.size(), actual.size());
+
+    for(size_t i = 0; i < events.size(); i++) {
+      LOGUNIT_ASSERT_EQUAL(events[i]->getTimeStamp(), actual[i]->getTimeStamp());
+      LOGUNIT_ASSERT(events[i]->getLevel()->equals(actual[i]->getLevel()));
+      LOGUNIT_ASSERT_EQUAL(events[i]->getLoggerName(), actual[i]->getLoggerName());
+      LOGUNIT_ASSERT_EQUAL(events[i]->getThreadName(), actual[i]->getThreadName());
+      LOGUNIT_ASSERT_EQUAL(events[i]->getMessage(), actual[i]->getMessage());
+      LogString expectedNDC, actualNDC;
+      LOGUNIT_ASSERT_EQUAL(events[i]->getNDC(expectedNDC), actual[i]->getNDC(actualNDC));
+      LOGUNIT_ASSERT_EQUAL(expectedNDC, actualNDC);
+      const LocationInfo& expectedLocation = events[i]->getLocationInformation();
+      const LocationInfo& actualLocation = actual[i]->getLocationInformation();
+      LOGUNIT_ASSERT_EQUAL(std::string(expectedLocation.getFileName()),
+          std::string(actualLocation.getFileName()));
+      LOGUNIT_ASSERT_EQUAL(expectedLocation.getMethodName(), actualLocation.getMethodName());
+      LOGUNIT_ASSERT_EQUAL(expectedLocation.getLineNumber(), actualLocation.getLineNumber());
+    }
+
+    LogString value;
+    LOGUNIT_ASSERT_EQUAL(true, actual[1]->getMDC(LOG4CXX_STR("user"), value));
+    LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("alice"), value);
+    value.erase();
+    LOGUNIT_ASSERT_EQUAL(true, actual[2]->getProperty(LOG4CXX_STR("request"), value));
+    LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("42"), value);
+  }
+
+  /**
+   * Events read back render the same through PatternLayout.
+   */
+  void testRender() {
+    std::vector<LoggingEventPtr> events(createEvents());
+    write(events, false);
+    std::vector<LoggingEventPtr> actual(read());
+    LOGUNIT_ASSERT_EQUAL(events.size(), actual.size());
+    PatternLayout layout(LOG4CXX_STR("%d{ISO8601} %-5p %c [%t] %x %X{user} %F:%L %M - %m%n"));
+    Pool p;
+
+    for(size_t i = 0; i < events.size(); i++) {
+      LogString expected, rendered;
+      layout.format(expected, events[i], p);
+      layout.format(rendered, actual[i], p);
+      LOGUNIT_ASSERT_EQUAL(expected, rendered);
+    }
+  }
+
+  /**
+   * Appending to a file starts a new header, which resets the dictionary.
+   */
+  void testAppendedFiles() {
+    std::vector<LoggingEventPtr> events(createEvents());
+    write(events, false);
+    write(events, true);
+    std::vector<LoggingEventPtr> actual(read());
+    LOGUNIT_ASSERT_EQUAL(2 * events.size(), actual.size());
+    LOGUNIT_ASSERT_EQUAL(events[0]->getLoggerName(), actual[events.size()]->getLoggerName());
+    LOGUNIT_ASSERT_EQUAL(events[0]->getTimeStamp(), actual[events.size()]->getTimeStamp());
+  }
+
+  /**
+   * A record cut short is reported.
+   */
+  void testTruncated() {
+    BinaryLayout layout;
+    std::string bytes;
+    layout.formatHeader(bytes);
+    Pool p;
+    layout.formatRecord(bytes, createEvents()[0], p);
+    bytes.resize(bytes.size() - 1);
+
+    std::vector<char> copy(bytes.begin(), bytes.end());
+    OutputStreamPtr out(new FileOutputStream(FILENAME, false));
+    ByteBuffer buf(&copy[0], copy.size());
+    out->write(buf, p);
+    out->close(p);
+
+    try {
+      read();
+      LOGUNIT_FAIL("Expected IOException");
+    } catch(IOException&) {
+    }
+  }
+
+  /**
+   * BufferedIO does not swallow the records.
+   */
+  void testBufferedIO() {
+    std::vector<LoggingEventPtr> events(createEvents());
+    write(events, false, true);
+    std::vector<LoggingEventPtr> actual(read());
+    LOGUNIT_ASSERT_EQUAL(events.size(), actual.size());
+    LOGUNIT_ASSERT_EQUAL(events[2]->getLoggerName(), actual[2]->getLoggerName());
+  }
+
+private:
+  static std::vector<LoggingEventPtr> createEvents() {
+    std::vector<LoggingEventPtr> events;
+    events.push_back(new LoggingEvent(
+        LOG4CXX_STR("org.example.Foo"), Level::getInfo(), LOG4CXX_STR("Hello, World"),
+        LocationInfo("foo.cpp", "void example::Foo::bar(int)", 42)));
+    NDC::push("ndc goes here");
+    MDC::put("user", "alice");
+    LogString message(LOG4CXX_STR("caf"));
+    Transcoder::encode(0xE9, message);
+    events.push_back(new LoggingEvent(
+        LOG4CXX_STR("org.example.Bar"), Level::getWarn(), message,
+        LocationInfo("bar.cpp", "int example::Bar::baz()", 7)));
+    LogString ndc;
+    events.back()->getNDC(ndc);
+    events.back()->getMDCCopy();
+    NDC::pop();
+    MDC::remove("user");
+    events.push_back(new LoggingEvent(
+        LOG4CXX_STR("org.example.Foo"), Level::getError(), LogString(),
+        LocationInfo("foo.cpp", "void example::Foo::bar(int)", 43)));
+    events.back()->setProperty(LOG4CXX_STR("request"), LOG4CXX_STR("42"));
+    return events;
+  }
+
+  static void write(const std::vector<LoggingEventPtr>& events, bool append,
+      bool bufferedIO = false) {
+    BinaryLayoutPtr layout(new BinaryLayout());
+    layout->setLocationInfo(true);
+    layout->setProperties(true);
+    FileAppenderPtr appender(new FileAppender(layout, FILENAME, append,
+        bufferedIO, 8 * 1024));
+    Pool p;
+
+    for(std::vector<LoggingEventPtr>::const_iterator iter = events.begin();
+        iter != events.end();
+        iter++) {
+      appender->doAppend(*iter, p);
+    }
+
+    appender->close();
+  }
+
+  std::vector<LoggingEventPtr> read() {
+    reader = new BinaryLogReader(new FileInputStream(FILENAME));
+    std::vector<LoggingEventPtr> events;
+
+    for(LoggingEventPtr event(reader->read()); event != NULL; event = reader->read()) {
+      events.push_back(event);
+    }
+
+    return events;
+  }
+};
+
+LOGUNIT_TEST_SUITE_REGISTRATION(BinaryLayoutTest);
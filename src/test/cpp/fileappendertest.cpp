@@ -17,10 +17,32 @@
 #include <log4cxx/helpers/pool.h>
 #include <log4cxx/fileappender.h>
 #include <log4cxx/patternlayout.h>
+#include <log4cxx/spi/loggingevent.h>
+#include <log4cxx/helpers/thread.h>
+#include <log4cxx/helpers/stringhelper.h>
 #include "logunit.h"
+#include "util/compare.h"
 
 using namespace log4cxx;
 using namespace log4cxx::helpers;
+using namespace log4cxx::spi;
+
+/**
+ *  FileAppender counting the events that reach subAppend.
+ */
+class CountingFileAppender : public FileAppender {
+public:
+  int counter;
+
+  CountingFileAppender() : counter(0) {
+  }
+
+protected:
+  void subAppend(const LoggingEventPtr& event, Pool& p) {
+      counter++;
+      FileAppender::subAppend(event, p);
+  }
+};
 
 
 /**
@@ -32,6 +54,10 @@ LOGUNIT_CLASS(FileAppenderTest) {
           LOGUNIT_TEST(testDirectoryCreation);
           LOGUNIT_TEST(testgetSetThreshold);
           LOGUNIT_TEST(testIsAsSevereAsThreshold);
+          LOGUNIT_TEST(testGroupCommit);
+          LOGUNIT_TEST(testAppendAll);
+          LOGUNIT_TEST(testAppendAllSubclass);
+          LOGUNIT_TEST(testIOUring);
   LOGUNIT_TEST_SUITE_END();
 public:
   /**
@@ -77,6 +103,132 @@ public:
     LevelPtr debug = Level::getDebug();
     LOGUNIT_ASSERT(appender->isAsSevereAsThreshold(debug));
   }
+
+  /**
+   * Tests that output from a GroupCommit appender reaches the file
+   * without waiting for close, and that close writes the rest.
+   */
+  void testGroupCommit() {
+      Pool p;
+      File file(LOG4CXX_STR("output/groupcommit.log"));
+
+      FileAppenderPtr appender(new FileAppender());
+      appender->setFile(LOG4CXX_STR("output/groupcommit.log"));
+      appender->setAppend(false);
+      appender->setLayout(new PatternLayout(LOG4CXX_STR("%m%n")));
+      appender->setOption(LOG4CXX_STR("GroupCommit"), LOG4CXX_STR("true"));
+      appender->setOption(LOG4CXX_STR("GroupCommitLatency"), LOG4CXX_STR("5"));
+      appender->activateOptions(p);
+      LOGUNIT_ASSERT_EQUAL(true, appender->getGroupCommit());
+      LOGUNIT_ASSERT_EQUAL(5, appender->getGroupCommitLatency());
+
+      LoggingEventPtr event(new LoggingEvent(
+          LOG4CXX_STR("org.example.GroupCommit"), Level::getInfo(),
+          LOG4CXX_STR("0123456789"), LocationInfo::getLocationUnavailable()));
+      appender->doAppend(event, p);
+
+      for(int i = 0; i < 500 && file.length(p) == 0; i++) {
+          Thread::sleep(10);
+      }
+      size_t eventLength = file.length(p);
+      LOGUNIT_ASSERT(eventLength > 0);
+
+      for(int i = 1; i < 1000; i++) {
+          appender->doAppend(event, p);
+      }
+      appender->close();
+      LOGUNIT_ASSERT_EQUAL(1000 * eventLength, file.length(p));
+  }
+
+  /**
+   * Tests that a batch passed to doAppendAll writes the same file as
+   * appending the events one at a time, threshold included.
+   */
+  void testAppendAll() {
+      Pool p;
+      LoggingEventList events;
+      for(int i = 0; i < 100; i++) {
+          LogString msg(LOG4CXX_STR("message "));
+          StringHelper::toString(i, p, msg);
+          events.push_back(new LoggingEvent(
+              LOG4CXX_STR("org.example.AppendAll"),
+              (i % 3 == 0) ? Level::getDebug() : Level::getInfo(),
+              msg, LocationInfo::getLocationUnavailable()));
+      }
+
+      FileAppenderPtr single(new FileAppender(
+          new PatternLayout(LOG4CXX_STR("%p %m%n")),
+          LOG4CXX_STR("output/appendall-single.log"), false));
+      single->setThreshold(Level::getInfo());
+      for(LoggingEventList::iterator iter = events.begin();
+          iter != events.end();
+          iter++) {
+          single->doAppend(*iter, p);
+      }
+      single->close();
+
+      FileAppenderPtr batch(new FileAppender(
+          new PatternLayout(LOG4CXX_STR("%p %m%n")),
+          LOG4CXX_STR("output/appendall-batch.log"), false));
+      batch->setThreshold(Level::getInfo());
+      batch->doAppendAll(events, p);
+      batch->close();
+
+      File singleFile(LOG4CXX_STR("output/appendall-single.log"));
+      File batchFile(LOG4CXX_STR("output/appendall-batch.log"));
+      LOGUNIT_ASSERT(singleFile.length(p) > 0);
+      LOGUNIT_ASSERT(Compare::compare(singleFile, batchFile));
+  }
+
+  /**
+   * Tests that a batch passed to a subclass overriding subAppend
+   * still goes through subAppend one event at a time.
+   */
+  void testAppendAllSubclass() {
+      Pool p;
+      LoggingEventList events;
+      for(int i = 0; i < 10; i++) {
+          events.push_back(new LoggingEvent(
+              LOG4CXX_STR("org.example.AppendAll"), Level::getInfo(),
+              LOG4CXX_STR("message"), LocationInfo::getLocationUnavailable()));
+      }
+
+      ObjectPtrT<CountingFileAppender> appender(new CountingFileAppender());
+      appender->setFile(LOG4CXX_STR("output/appendall-subclass.log"));
+      appender->setAppend(false);
+      appender->setLayout(new PatternLayout(LOG4CXX_STR("%m%n")));
+      appender->activateOptions(p);
+      appender->doAppendAll(events, p);
+      appender->close();
+      LOGUNIT_ASSERT_EQUAL(10, appender->counter);
+  }
+
+  /**
+   * Tests that an IOUring appender writes every event by close,
+   * whether or not io_uring is available.
+   */
+  void testIOUring() {
+      Pool p;
+      File file(LOG4CXX_STR("output/iouring.log"));
+
+      FileAppenderPtr appender(new FileAppender());
+      appender->setFile(LOG4CXX_STR("output/iouring.log"));
+      appender->setAppend(false);
+      appender->setLayout(new PatternLayout(LOG4CXX_STR("%m\n")));
+      appender->setOption(LOG4CXX_STR("IOUring"), LOG4CXX_STR("true"));
+      appender->setOption(LOG4CXX_STR("BufferSize"), LOG4CXX_STR("1000"));
+      appender->activateOptions(p);
+      LOGUNIT_ASSERT_EQUAL(true, appender->getIOUring());
+
+      LoggingEventPtr event(new LoggingEvent(
+          LOG4CXX_STR("org.example.IOUring"), Level::getInfo(),
+          LOG4CXX_STR("0123456789"), LocationInfo::getLocationUnavailable()));
+      for(int i = 0; i < 1000; i++) {
+          appender->doAppend(event, p);
+      }
+      appender->close();
+      LOGUNIT_ASSERT_EQUAL((size_t) 11000, file.length(p));
+  }
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(FileAppenderTest);
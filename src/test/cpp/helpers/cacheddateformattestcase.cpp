@@ -25,6 +25,7 @@
 #include <apr.h>
 #include <apr_time.h>
 #include "localechanger.h"
+#include <log4cxx/helpers/thread.h>
 
 using namespace log4cxx;
 using namespace log4cxx::helpers;
@@ -76,6 +77,7 @@ LOGUNIT_CLASS(CachedDateFormatTestCase)
      LOGUNIT_TEST(test19);
      LOGUNIT_TEST(test20);
      LOGUNIT_TEST(test21);
+     LOGUNIT_TEST(test22);
      LOGUNIT_TEST_SUITE_END();
 
 #define MICROSECONDS_PER_DAY APR_INT64_C(86400000000)
@@ -642,6 +644,56 @@ void test21() {
     LOGUNIT_ASSERT_EQUAL(1000, maxValid);
 }
 
+  /**
+   * Threads sharing one cached format must each get the same
+   * result as the uncached format.
+   */
+void test22() {
+    FormatArgs args[THREAD_COUNT];
+    Thread threads[THREAD_COUNT];
+    DateFormatPtr baseFormat = new AbsoluteTimeDateFormat();
+    DateFormatPtr cachedFormat = new CachedDateFormat(baseFormat, 1000000);
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        args[i].baseFormat = baseFormat;
+        args[i].cachedFormat = cachedFormat;
+        args[i].offset = i * 7000;
+        args[i].mismatches = 0;
+        threads[i].run(formatDates, &args[i]);
+    }
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        threads[i].join();
+        LOGUNIT_ASSERT_EQUAL(0, args[i].mismatches);
+    }
+}
+
+private:
+  enum { THREAD_COUNT = 4 };
+
+  struct FormatArgs {
+      DateFormatPtr baseFormat;
+      DateFormatPtr cachedFormat;
+      int offset;
+      int mismatches;
+  };
+
+  static void* LOG4CXX_THREAD_FUNC formatDates(apr_thread_t*, void* data) {
+      FormatArgs* args = (FormatArgs*) data;
+      Pool p;
+      apr_time_t jul2 = MICROSECONDS_PER_DAY * 12602;
+      for (int i = 0; i < 5000; i++) {
+          //  steps through milliseconds and, every few calls, seconds
+          apr_time_t ticks = jul2 + (apr_time_t) (args->offset + i * 337) * 1000;
+          LogString expected;
+          args->baseFormat->format(expected, ticks, p);
+          LogString actual;
+          args->cachedFormat->format(actual, ticks, p);
+          if (expected != actual) {
+              args->mismatches++;
+          }
+      }
+      return 0;
+  }
+
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(CachedDateFormatTestCase);
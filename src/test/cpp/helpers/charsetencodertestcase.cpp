@@ -19,6 +19,7 @@
 #include "../logunit.h"
 #include "../insertwide.h"
 #include <log4cxx/helpers/bytebuffer.h>
+#include <log4cxx/helpers/transcoder.h>
 #include <log4cxx/helpers/thread.h>
 #include <log4cxx/helpers/mutex.h>
 #include <log4cxx/helpers/condition.h>
@@ -38,6 +39,7 @@ LOGUNIT_CLASS(CharsetEncoderTestCase)
                 LOGUNIT_TEST(encode2);
                 LOGUNIT_TEST(encode3);
                 LOGUNIT_TEST(encode4);
+                LOGUNIT_TEST(encodeAll);
 #if APR_HAS_THREADS        
                 LOGUNIT_TEST(thread1);
 #endif                
@@ -172,6 +174,36 @@ public:
           LOGUNIT_ASSERT(iter == greeting.end());
         }
         
+        /**
+         *  encodeAll agrees with encoding through a fixed buffer,
+         *  including unmappable characters and strings longer
+         *  than the buffer.
+         */
+        void encodeAll() {
+          const logchar* charsets[] = { LOG4CXX_STR("US-ASCII"), LOG4CXX_STR("ISO-8859-1"),
+              LOG4CXX_STR("UTF-8"), LOG4CXX_STR("UTF-16BE"), LOG4CXX_STR("UTF-16LE") };
+          LogString text;
+          for(int i = 0; i < 400; i++) {
+            text.append(LOG4CXX_STR("Hello, "));
+            Transcoder::encode(0xE9, text);
+            Transcoder::encode(0x20AC, text);
+          }
+          for(int i = 0; i < 5; i++) {
+            CharsetEncoderPtr enc(CharsetEncoder::getEncoder(charsets[i]));
+            std::string expected("prefix");
+            char buf[BUFSIZE];
+            LogString::const_iterator iter = text.begin();
+            while(iter != text.end()) {
+              ByteBuffer out(buf, BUFSIZE);
+              CharsetEncoder::encode(enc, text, iter, out);
+              expected.append(buf, out.position());
+            }
+            std::string actual("prefix");
+            enc->encodeAll(text, actual);
+            LOGUNIT_ASSERT_EQUAL(expected, actual);
+          }
+        }
+
 #if APR_HAS_THREADS        
         class ThreadPackage {
         public:
@@ -0,0 +1,143 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/helpers/deferredmessage.h>
+#include "../logunit.h"
+
+#include <log4cxx/logger.h>
+#include <log4cxx/logmanager.h>
+#include <log4cxx/spi/loggingevent.h>
+#include "../vectorappender.h"
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::spi;
+
+LOGUNIT_CLASS(DeferredMessageTestCase)
+{
+   LOGUNIT_TEST_SUITE(DeferredMessageTestCase);
+      LOGUNIT_TEST(testLiteral);
+      LOGUNIT_TEST(testIntegers);
+      LOGUNIT_TEST(testBooleanAndChar);
+      LOGUNIT_TEST(testFloating);
+      LOGUNIT_TEST(testStrings);
+      LOGUNIT_TEST(testEscapes);
+      LOGUNIT_TEST(testMissingArguments);
+      LOGUNIT_TEST(testCopyLarge);
+      LOGUNIT_TEST(testMacro);
+   LOGUNIT_TEST_SUITE_END();
+
+   static LogString render(const DeferredMessage& msg)
+   {
+      LogString result;
+      msg.render(result);
+      return result;
+   }
+
+public:
+   void tearDown()
+   {
+      LogManager::shutdown();
+   }
+
+   void testLiteral()
+   {
+      LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("plain"),
+         render(DeferredMessage::capture("plain")));
+   }
+
+   void testIntegers()
+   {
+      long long smallest = -9223372036854775807LL - 1;
+      unsigned long long largest = 18446744073709551615ULL;
+      short s = -7;
+      LOGUNIT_ASSERT_EQUAL(
+         (LogString) LOG4CXX_STR("0 -42 7 -7 -9223372036854775808 18446744073709551615"),
+         render(DeferredMessage::capture("{} {} {} {} {} {}",
+            0, -42, 7u, s, smallest, largest)));
+   }
+
+   void testBooleanAndChar()
+   {
+      LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("true false x"),
+         render(DeferredMessage::capture("{} {} {}", true, false, 'x')));
+   }
+
+   void testFloating()
+   {
+      LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("1.5 -0.25"),
+         render(DeferredMessage::capture("{} {}", 1.5, -0.25f)));
+   }
+
+   void testStrings()
+   {
+      const char* pointer = "pointer";
+      std::string str("string");
+      LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("literal pointer string "),
+         render(DeferredMessage::capture("{} {} {} {}",
+            "literal", pointer, str, std::string())));
+   }
+
+   void testEscapes()
+   {
+      LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("{} {1} }"),
+         render(DeferredMessage::capture("{{}} {{{}}} }", 1)));
+   }
+
+   void testMissingArguments()
+   {
+      LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("1 {}"),
+         render(DeferredMessage::capture("{} {}", 1)));
+      LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("1"),
+         render(DeferredMessage::capture("{}", 1, 2)));
+   }
+
+   /**
+    *  Arguments beyond the inline buffer must survive a copy.
+    */
+   void testCopyLarge()
+   {
+      std::string large(200, 'a');
+      DeferredMessage msg(DeferredMessage::capture("{}-{}-{}", large, 5, large));
+      DeferredMessage copy(msg);
+      LogString expected(large.begin(), large.end());
+      expected.append(LOG4CXX_STR("-5-"));
+      expected.append(large.begin(), large.end());
+      LOGUNIT_ASSERT_EQUAL(expected, render(copy));
+      LOGUNIT_ASSERT_EQUAL(expected, render(msg));
+   }
+
+   void testMacro()
+   {
+      LoggerPtr logger(Logger::getLogger("DeferredMessageTestCase.testMacro"));
+      VectorAppenderPtr appender(new VectorAppender());
+      logger->addAppender(appender);
+      logger->setLevel(Level::getInfo());
+
+      LOG4CXX_INFO_FMT(logger, "x={} y={}", 1, "two");
+      LOG4CXX_DEBUG_FMT(logger, "hidden {}", 3);
+      LOG4CXX_WARN_FMT(logger, "no arguments");
+
+      const std::vector<LoggingEventPtr>& events = appender->getVector();
+      LOGUNIT_ASSERT_EQUAL((size_t) 2, events.size());
+      LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("x=1 y=two"), events[0]->getMessage());
+      LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("x=1 y=two"), events[0]->getRenderedMessage());
+      LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("no arguments"), events[1]->getMessage());
+   }
+};
+
+LOGUNIT_TEST_SUITE_REGISTRATION(DeferredMessageTestCase);
@@ -0,0 +1,174 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <log4cxx/helpers/eventringbuffer.h>
+#include "../logunit.h"
+
+#include <log4cxx/logmanager.h>
+#include <log4cxx/logger.h>
+#include <log4cxx/spi/loggingevent.h>
+#include <log4cxx/spi/location/locationinfo.h>
+#include <log4cxx/helpers/thread.h>
+#include "../testchar.h"
+#include <apr_thread_proc.h>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::spi;
+
+#define MAX 1000
+
+LOGUNIT_CLASS(EventRingBufferTestCase)
+{
+   LOGUNIT_TEST_SUITE(EventRingBufferTestCase);
+      LOGUNIT_TEST(testCapacity);
+      LOGUNIT_TEST(testOrder);
+      LOGUNIT_TEST(testFull);
+      LOGUNIT_TEST(testWrap);
+      LOGUNIT_TEST(testProducers);
+   LOGUNIT_TEST_SUITE_END();
+
+   std::vector<LoggingEventPtr> e;
+
+public:
+   void setUp()
+   {
+      e.reserve(MAX);
+      LoggingEventPtr event;
+      for (int i = 0; i < MAX; i++)
+      {
+         event = new LoggingEvent(LOG4CXX_STR("x"), Level::getDebug(), LOG4CXX_STR("e"),
+                          log4cxx::spi::LocationInfo::getLocationUnavailable());
+         e.push_back(event);
+      }
+   }
+
+   void tearDown()
+   {
+      e.clear();
+      LogManager::shutdown();
+   }
+
+   void testCapacity()
+   {
+      LOGUNIT_ASSERT_EQUAL(2, EventRingBuffer(1).getCapacity());
+      LOGUNIT_ASSERT_EQUAL(8, EventRingBuffer(5).getCapacity());
+      LOGUNIT_ASSERT_EQUAL(128, EventRingBuffer(128).getCapacity());
+   }
+
+   void testOrder()
+   {
+      EventRingBuffer ring(8);
+      LOGUNIT_ASSERT(ring.isEmpty());
+      for (int i = 0; i < 5; i++)
+      {
+         LOGUNIT_ASSERT(ring.offer(e[i]));
+      }
+      LOGUNIT_ASSERT(!ring.isEmpty());
+
+      LoggingEventList events;
+      LOGUNIT_ASSERT_EQUAL((size_t) 3, ring.drain(events, 3));
+      LOGUNIT_ASSERT_EQUAL((size_t) 2, ring.drain(events, 8));
+      LOGUNIT_ASSERT(ring.isEmpty());
+      for (int i = 0; i < 5; i++)
+      {
+         LOGUNIT_ASSERT_EQUAL(e[i], events[i]);
+      }
+   }
+
+   void testFull()
+   {
+      EventRingBuffer ring(4);
+      for (int i = 0; i < 4; i++)
+      {
+         LOGUNIT_ASSERT(ring.offer(e[i]));
+      }
+      LOGUNIT_ASSERT(!ring.offer(e[4]));
+
+      LoggingEventList events;
+      LOGUNIT_ASSERT_EQUAL((size_t) 1, ring.drain(events, 1));
+      LOGUNIT_ASSERT(ring.offer(e[4]));
+      LOGUNIT_ASSERT(!ring.offer(e[5]));
+   }
+
+   void testWrap()
+   {
+      EventRingBuffer ring(4);
+      LoggingEventList events;
+      for (int i = 0; i < MAX; i++)
+      {
+         LOGUNIT_ASSERT(ring.offer(e[i]));
+         if (i % 3 == 2)
+         {
+            ring.drain(events, 4);
+         }
+      }
+      ring.drain(events, 4);
+      LOGUNIT_ASSERT_EQUAL((size_t) MAX, events.size());
+      for (int i = 0; i < MAX; i++)
+      {
+         LOGUNIT_ASSERT_EQUAL(e[i], events[i]);
+      }
+   }
+
+   /**
+    * Several threads fill the ring while this thread drains it,
+    * every event must arrive exactly once.
+    */
+   void testProducers()
+   {
+      EventRingBuffer ring(16);
+      Thread threads[4];
+      for (int i = 0; i < 4; i++)
+      {
+         threads[i].run(produce, &ring);
+      }
+
+      LoggingEventList events;
+      while (events.size() < 4 * MAX)
+      {
+         if (ring.drain(events, 16) == 0)
+         {
+            apr_thread_yield();
+         }
+      }
+      for (int i = 0; i < 4; i++)
+      {
+         threads[i].join();
+      }
+
+      LOGUNIT_ASSERT(ring.isEmpty());
+      LOGUNIT_ASSERT_EQUAL((size_t) 4 * MAX, events.size());
+   }
+
+private:
+   static void* LOG4CXX_THREAD_FUNC produce(apr_thread_t*, void* data)
+   {
+      EventRingBuffer* ring = (EventRingBuffer*) data;
+      LoggingEventPtr event(new LoggingEvent(LOG4CXX_STR("x"), Level::getDebug(), LOG4CXX_STR("e"),
+                          log4cxx::spi::LocationInfo::getLocationUnavailable()));
+      for (int i = 0; i < MAX; i++)
+      {
+         while (!ring->offer(event))
+         {
+            apr_thread_yield();
+         }
+      }
+      return 0;
+   }
+};
+
+LOGUNIT_TEST_SUITE_REGISTRATION(EventRingBufferTestCase);
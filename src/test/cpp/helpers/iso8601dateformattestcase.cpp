@@ -25,6 +25,7 @@
 #include "../insertwide.h"
 #include <log4cxx/helpers/pool.h>
 #include <log4cxx/helpers/date.h>
+#include <log4cxx/helpers/fixeddateformat.h>
 
 
 
@@ -44,6 +45,8 @@ LOGUNIT_CLASS(ISO8601DateFormatTestCase) {
      LOGUNIT_TEST( test5 );
      LOGUNIT_TEST( test6 );
      LOGUNIT_TEST( test7 );
+     LOGUNIT_TEST( test8 );
+     LOGUNIT_TEST( test9 );
      LOGUNIT_TEST_SUITE_END();
 
   /**
@@ -153,6 +156,50 @@ public:
     LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("87"), number);
   }
 
+  /**
+   * Checks that the fixed formatter agrees with SimpleDateFormat
+   * across days, leap years and time zones.
+   */
+  void test8() {
+    const logchar* zones[] = { LOG4CXX_STR("GMT"), LOG4CXX_STR("GMT-5"),
+        LOG4CXX_STR("GMT+5:45"), LOG4CXX_STR("GMT+14") };
+    Pool p;
+    for (int i = 0; i < 4; i++) {
+      TimeZonePtr zone(TimeZone::getTimeZone(zones[i]));
+      ISO8601DateFormat formatter;
+      formatter.setTimeZone(zone);
+      SimpleDateFormat simple(LOG4CXX_STR("yyyy-MM-dd HH:mm:ss,SSS"));
+      simple.setTimeZone(zone);
+      //  from before 1970 to 2100 in steps of a little over 17 days
+      for (log4cxx_time_t date = - Date::getMicrosecondsPerDay() * 3;
+           date < Date::getMicrosecondsPerDay() * 47482;
+           date += APR_INT64_C(1500000123457)) {
+        LogString expected;
+        simple.format(expected, date, p);
+        LogString actual;
+        formatter.format(actual, date, p);
+        LOGUNIT_ASSERT_EQUAL(expected, actual);
+      }
+    }
+  }
+
+  /**
+   * Convert 29 Feb 2004 23:59:59.123456 GMT with microseconds.
+   */
+  void test9() {
+    log4cxx_time_t feb29 = Date::getMicrosecondsPerDay() * 12477
+        + APR_INT64_C(86399123456);
+    FixedDateFormat formatter(FixedDateFormat::ISO8601_MICROS);
+    formatter.setTimeZone(TimeZone::getGMT());
+    LogString actual;
+    Pool p;
+    formatter.format(actual, feb29, p);
+    LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("2004-02-29 23:59:59,123456"), actual);
+    actual.erase();
+    formatter.format(actual, - Date::getMicrosecondsPerDay() + 7, p);
+    LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("1969-12-31 00:00:00,000007"), actual);
+  }
+
 
 
 };
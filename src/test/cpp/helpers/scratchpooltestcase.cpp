@@ -0,0 +1,65 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <log4cxx/helpers/threadspecificdata.h>
+#include "../logunit.h"
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+
+
+/**
+   Unit test for ScratchPool.
+
+   */
+LOGUNIT_CLASS(ScratchPoolTestCase) {
+  LOGUNIT_TEST_SUITE(ScratchPoolTestCase);
+          LOGUNIT_TEST(testReused);
+          LOGUNIT_TEST(testNested);
+  LOGUNIT_TEST_SUITE_END();
+
+  public:
+  /**
+   * Successive scratch pools on one thread share the same APR pool.
+   */
+  void testReused() {
+    apr_pool_t* first = 0;
+    {
+      ScratchPool p;
+      first = p.getAPRPool();
+      LOGUNIT_ASSERT(p.pstrdup("scratch") != 0);
+    }
+    ScratchPool p;
+    LOGUNIT_ASSERT(first == p.getAPRPool());
+  }
+
+  /**
+   * A scratch pool requested while another is live gets its own pool.
+   */
+  void testNested() {
+    ScratchPool outer;
+    char* s = outer.pstrdup("outer");
+    {
+      ScratchPool inner;
+      LOGUNIT_ASSERT(outer.getAPRPool() != inner.getAPRPool());
+      inner.pstrdup("inner");
+    }
+    LOGUNIT_ASSERT_EQUAL(std::string("outer"), std::string(s));
+  }
+
+};
+
+LOGUNIT_TEST_SUITE_REGISTRATION(ScratchPoolTestCase);
@@ -16,6 +16,11 @@
  */
 
 #include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/helpers/charsetencoder.h>
+#include <log4cxx/helpers/charsetdecoder.h>
+#include <log4cxx/helpers/bytebuffer.h>
+#include <apr_errno.h>
+#include <stdlib.h>
 #include "../insertwide.h"
 #include "../logunit.h"
 
@@ -53,6 +58,10 @@ LOGUNIT_CLASS(TranscoderTestCase)
                 LOGUNIT_TEST(testDecodeUTF8_2);
                 LOGUNIT_TEST(testDecodeUTF8_3);
                 LOGUNIT_TEST(testDecodeUTF8_4);
+                LOGUNIT_TEST(testRandomDecodeUTF8);
+                LOGUNIT_TEST(testRandomEncodeUTF8);
+                LOGUNIT_TEST(testRandomEncoders);
+                LOGUNIT_TEST(testRandomDecoders);
 #if LOG4CXX_UNICHAR_API
                 LOGUNIT_TEST(udecode2);
                 LOGUNIT_TEST(udecode4);
@@ -251,6 +260,109 @@ public:
         LOGUNIT_ASSERT_EQUAL(true, iter == out.end());
     }
 
+    /**
+     *   Compares decodeUTF8 with the scalar code point loop on random
+     *   bytes.  Runs of ASCII of every length between the multibyte and
+     *   malformed sequences reach both the vector body and the tail.
+     */
+    void testRandomDecodeUTF8() {
+        srand(23);
+        for(int i = 0; i < 20000; i++) {
+            std::string src(randomBytes());
+            LogString expected(LOG4CXX_STR("x"));
+            std::string::const_iterator iter = src.begin();
+            while(iter != src.end()) {
+                unsigned int sv = Transcoder::decode(src, iter);
+                if (sv == 0xFFFF) {
+                    expected.append(1, Transcoder::LOSSCHAR);
+                    iter++;
+                } else {
+                    Transcoder::encode(sv, expected);
+                }
+            }
+            LogString actual(LOG4CXX_STR("x"));
+            Transcoder::decodeUTF8(src, actual);
+            LOGUNIT_ASSERT_EQUAL(expected, actual);
+        }
+    }
+
+    void testRandomEncodeUTF8() {
+        srand(29);
+        for(int i = 0; i < 20000; i++) {
+            LogString src(randomString());
+            std::string expected("x");
+            referenceEncode(src, "UTF-8", expected);
+            std::string actual("x");
+            Transcoder::encodeUTF8(src, actual);
+            LOGUNIT_ASSERT_EQUAL(expected, actual);
+        }
+    }
+
+    /**
+     *   Runs the built-in encoders over random text through small
+     *   buffers so that ASCII runs are cut short by the buffer end.
+     */
+    void testRandomEncoders() {
+        const char* charsets[] = { "US-ASCII", "ISO-8859-1", "UTF-8", "UTF-16BE", "UTF-16LE" };
+        srand(31);
+        for(int c = 0; c < 5; c++) {
+            LogString charset;
+            Transcoder::decode(charsets[c], charset);
+            CharsetEncoderPtr encoder(CharsetEncoder::getEncoder(charset));
+            for(int i = 0; i < 5000; i++) {
+                LogString src(randomString());
+                std::string expected;
+                referenceEncode(src, charsets[c], expected);
+
+                std::string actual;
+                char buf[64];
+                LogString::const_iterator iter = src.begin();
+                while(iter != src.end()) {
+                    ByteBuffer out(buf, 8 + rand() % (sizeof(buf) - 8));
+                    log4cxx_status_t stat = encoder->encode(src, iter, out);
+                    out.flip();
+                    actual.append(out.data(), out.limit());
+                    if (stat != APR_SUCCESS) {
+                        break;
+                    }
+                }
+                LOGUNIT_ASSERT_EQUAL(expected, actual);
+            }
+        }
+    }
+
+    void testRandomDecoders() {
+        const char* charsets[] = { "US-ASCII", "ISO-8859-1", "UTF-8" };
+        srand(37);
+        for(int c = 0; c < 3; c++) {
+            LogString charset;
+            Transcoder::decode(charsets[c], charset);
+            CharsetDecoderPtr decoder(CharsetDecoder::getDecoder(charset));
+            for(int i = 0; i < 5000; i++) {
+                LogString expected;
+                std::string src;
+                if (c == 2) {
+                    expected = randomString();
+                    referenceEncode(expected, "UTF-8", src);
+                } else {
+                    src = randomBytes();
+                    for(std::string::const_iterator iter = src.begin(); iter != src.end(); iter++) {
+                        unsigned int sv = (unsigned char) *iter;
+                        if (c == 0 && sv > 0x7F) {
+                            break;
+                        }
+                        Transcoder::encode(sv, expected);
+                    }
+                }
+
+                LogString actual;
+                ByteBuffer in(const_cast<char*>(src.data()), src.length());
+                decoder->decode(in, actual);
+                LOGUNIT_ASSERT_EQUAL(expected, actual);
+            }
+        }
+    }
+
 
 #if LOG4CXX_UNICHAR_API
         void udecode2() {
@@ -337,6 +449,68 @@ public:
         }
 #endif
 
+private:
+    /**
+     *   Random bytes with ASCII runs between UTF-8 sequences and
+     *   bytes that are not valid UTF-8.
+     */
+    static std::string randomBytes() {
+        const char* specials[] = { "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+            "\x80", "\xC3", "\xFF" };
+        int length = rand() % 100;
+        int density = 1 + rand() % 40;
+        std::string s;
+        for(int i = 0; i < length; i++) {
+            if (rand() % density == 0) {
+                s.append(specials[rand() % 6]);
+            } else {
+                s.append(1, (char) (0x20 + rand() % 0x5F));
+            }
+        }
+        return s;
+    }
+
+    static LogString randomString() {
+        const unsigned int specials[] = { 0x0A, 0x7F, 0xE9, 0xFF, 0x20AC, 0x1F600 };
+        int length = rand() % 100;
+        int density = 1 + rand() % 40;
+        LogString s;
+        for(int i = 0; i < length; i++) {
+            if (rand() % density == 0) {
+                Transcoder::encode(specials[rand() % 6], s);
+            } else {
+                s.append(1, (logchar) (0x20 + rand() % 0x5F));
+            }
+        }
+        return s;
+    }
+
+    /**
+     *   Encodes one code point at a time, stopping at the first code
+     *   point that the single byte charsets cannot represent.
+     */
+    static void referenceEncode(const LogString& src, const std::string& charset, std::string& dst) {
+        LogString::const_iterator iter = src.begin();
+        while(iter != src.end()) {
+            unsigned int sv = Transcoder::decode(src, iter);
+            char buf[8];
+            ByteBuffer out(buf, sizeof(buf));
+            if (charset == "US-ASCII" || charset == "ISO-8859-1") {
+                if (sv > (charset == "US-ASCII" ? 0x7Fu : 0xFFu)) {
+                    break;
+                }
+                out.put((char) sv);
+            } else if (charset == "UTF-8") {
+                Transcoder::encodeUTF8(sv, out);
+            } else if (charset == "UTF-16BE") {
+                Transcoder::encodeUTF16BE(sv, out);
+            } else {
+                Transcoder::encodeUTF16LE(sv, out);
+            }
+            out.flip();
+            dst.append(out.data(), out.limit());
+        }
+    }
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(TranscoderTestCase);
@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/helpers/transform.h>
+#include "../logunit.h"
+#include "../insertwide.h"
+#include <stdlib.h>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+
+LOGUNIT_CLASS(TransformTestCase)
+{
+   LOGUNIT_TEST_SUITE(TransformTestCase);
+      LOGUNIT_TEST(testEscapingTags);
+      LOGUNIT_TEST(testEscapingCDATA);
+      LOGUNIT_TEST(testRandomTags);
+      LOGUNIT_TEST(testRandomCDATA);
+   LOGUNIT_TEST_SUITE_END();
+
+public:
+   void testEscapingTags() {
+      LogString buf(LOG4CXX_STR("prefix:"));
+      Transform::appendEscapingTags(buf,
+         LOG4CXX_STR("<a href=\"x\">Fish & Chips</a> and a long tail of plain text"));
+      LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("prefix:&lt;a href=&quot;x&quot;&gt;Fish &amp; Chips&lt;/a&gt; and a long tail of plain text"), buf);
+   }
+
+   void testEscapingCDATA() {
+      LogString buf;
+      Transform::appendEscapingCDATA(buf, LOG4CXX_STR("a]]>b]]]>c]]"));
+      LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("a]]>]]&gt;<![CDATA[b]]]>]]&gt;<![CDATA[c]]"), buf);
+   }
+
+   /**
+    *   Compares appendEscapingTags with the original character by
+    *   character implementation on random strings.  Lengths run past
+    *   several vector widths so that specials land in every lane and
+    *   in the scalar tail.
+    */
+   void testRandomTags() {
+      srand(17);
+      for(int i = 0; i < 20000; i++) {
+         LogString input(randomString());
+         LogString expected(LOG4CXX_STR("x"));
+         referenceEscapingTags(expected, input);
+         LogString actual(LOG4CXX_STR("x"));
+         Transform::appendEscapingTags(actual, input);
+         LOGUNIT_ASSERT_EQUAL(expected, actual);
+      }
+   }
+
+   void testRandomCDATA() {
+      srand(19);
+      for(int i = 0; i < 20000; i++) {
+         LogString input(randomString());
+         LogString expected;
+         referenceEscapingCDATA(expected, input);
+         LogString actual;
+         Transform::appendEscapingCDATA(actual, input);
+         LOGUNIT_ASSERT_EQUAL(expected, actual);
+      }
+   }
+
+private:
+   static LogString randomString() {
+      const logchar alphabet[] = { 0x22, 0x26, 0x3C, 0x3E, 0x5D, 0x5D, 0x00, 0x0A,
+         (logchar) 0xC3, (logchar) 0xA9,
+#if LOG4CXX_LOGCHAR_IS_WCHAR || LOG4CXX_LOGCHAR_IS_UNICHAR
+         (logchar) 0x20AC, (logchar) 0xFFFF,
+#endif
+         0x20 };
+      const int alphabetSize = sizeof(alphabet) / sizeof(alphabet[0]);
+      int length = rand() % 100;
+      int density = 1 + rand() % 20;
+      LogString s;
+      for(int i = 0; i < length; i++) {
+         if (rand() % density == 0) {
+            s.append(1, alphabet[rand() % alphabetSize]);
+         } else {
+            s.append(1, (logchar) (0x61 + rand() % 26));
+         }
+      }
+      return s;
+   }
+
+   static void referenceEscapingTags(LogString& buf, const LogString& input) {
+      for(LogString::const_iterator iter = input.begin(); iter != input.end(); iter++) {
+         switch(*iter) {
+            case 0x22: buf.append(LOG4CXX_STR("&quot;")); break;
+            case 0x26: buf.append(LOG4CXX_STR("&amp;")); break;
+            case 0x3C: buf.append(LOG4CXX_STR("&lt;")); break;
+            case 0x3E: buf.append(LOG4CXX_STR("&gt;")); break;
+            default: buf.append(1, *iter); break;
+         }
+      }
+   }
+
+   static void referenceEscapingCDATA(LogString& buf, const LogString& input) {
+      const LogString end(LOG4CXX_STR("]]>"));
+      LogString::size_type start = 0;
+      LogString::size_type found = input.find(end);
+      while(found != LogString::npos) {
+         buf.append(input, start, found - start);
+         buf.append(LOG4CXX_STR("]]>]]&gt;<![CDATA["));
+         start = found + end.length();
+         found = input.find(end, start);
+      }
+      buf.append(input, start, input.length() - start);
+   }
+};
+
+LOGUNIT_TEST_SUITE_REGISTRATION(TransformTestCase);
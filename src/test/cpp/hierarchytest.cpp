@@ -20,8 +20,16 @@
 #include <log4cxx/hierarchy.h>
 #include "logunit.h"
 #include "insertwide.h"
+#include <log4cxx/helpers/thread.h>
+#include <log4cxx/helpers/stringhelper.h>
+#include <log4cxx/helpers/pool.h>
 
 using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::spi;
+
+#define NAME_COUNT 200
+#define THREAD_COUNT 4
 
 /**
  * Tests hierarchy.
@@ -30,6 +38,8 @@ using namespace log4cxx;
 LOGUNIT_CLASS(HierarchyTest) {
   LOGUNIT_TEST_SUITE(HierarchyTest);
           LOGUNIT_TEST(testGetParent);
+          LOGUNIT_TEST(testManyLoggers);
+          LOGUNIT_TEST(testConcurrentGetLogger);
   LOGUNIT_TEST_SUITE_END();
 public:
 
@@ -51,6 +61,76 @@ public:
           logger2->getParent()->getName());
   }
 
+
+    /**
+     * Tests that loggers stay reachable as the lookup table grows.
+     */
+  void testManyLoggers() {
+      LoggerRepositoryPtr hierarchy(new Hierarchy());
+      std::vector<LoggerPtr> loggers;
+      for (int i = 0; i < NAME_COUNT; i++) {
+          loggers.push_back(hierarchy->getLogger(getName(i)));
+      }
+      for (int i = 0; i < NAME_COUNT; i++) {
+          LOGUNIT_ASSERT(loggers[i] == hierarchy->getLogger(getName(i)));
+          LOGUNIT_ASSERT(loggers[i] == hierarchy->exists(getName(i)));
+      }
+      LOGUNIT_ASSERT(hierarchy->exists(LOG4CXX_STR("HierarchyTest.missing")) == 0);
+  }
+
+    /**
+     * Tests that threads looking up and creating the same loggers
+     * all get the same, fully linked instances.
+     */
+  void testConcurrentGetLogger() {
+      LoggerRepositoryPtr hierarchy(new Hierarchy());
+      LookupArgs args[THREAD_COUNT];
+      Thread threads[THREAD_COUNT];
+      for (int i = 0; i < THREAD_COUNT; i++) {
+          args[i].hierarchy = hierarchy;
+          threads[i].run(lookup, &args[i]);
+      }
+      for (int i = 0; i < THREAD_COUNT; i++) {
+          threads[i].join();
+      }
+      for (int j = 0; j < NAME_COUNT; j++) {
+          LoggerPtr logger(hierarchy->exists(getName(j)));
+          LOGUNIT_ASSERT(logger != 0);
+          for (int i = 0; i < THREAD_COUNT; i++) {
+              LOGUNIT_ASSERT(args[i].loggers[j] == logger);
+          }
+          if (j % 2 == 1) {
+              LOGUNIT_ASSERT(logger->getParent().operator->() == args[0].loggers[j - 1]);
+          }
+      }
+  }
+
+private:
+  struct LookupArgs {
+      LoggerRepositoryPtr hierarchy;
+      Logger* loggers[NAME_COUNT];
+  };
+
+  /**
+   * Even indices name a parent of the name that follows.
+   */
+  static LogString getName(int i) {
+      Pool p;
+      LogString name(LOG4CXX_STR("HierarchyTest."));
+      StringHelper::toString(i / 2, p, name);
+      if (i % 2 == 1) {
+          name.append(LOG4CXX_STR(".child"));
+      }
+      return name;
+  }
+
+  static void* LOG4CXX_THREAD_FUNC lookup(apr_thread_t*, void* data) {
+      LookupArgs* args = (LookupArgs*) data;
+      for (int i = NAME_COUNT - 1; i >= 0; i--) {
+          args->loggers[i] = args->hierarchy->getLogger(getName(i));
+      }
+      return 0;
+  }
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(HierarchyTest);
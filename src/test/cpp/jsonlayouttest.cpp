@@ -0,0 +1,220 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "logunit.h"
+#include <log4cxx/logger.h>
+#include <log4cxx/jsonlayout.h>
+#include <log4cxx/ndc.h>
+#include <log4cxx/mdc.h>
+#include <log4cxx/helpers/transform.h>
+#include <log4cxx/helpers/iso8601dateformat.h>
+#include <log4cxx/helpers/pool.h>
+#include <log4cxx/spi/loggingevent.h>
+#include "testchar.h"
+#include <stdlib.h>
+
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::spi;
+
+/**
+ * Test for JSONLayout.
+ *
+ */
+LOGUNIT_CLASS(JSONLayoutTest) {
+        LOGUNIT_TEST_SUITE(JSONLayoutTest);
+                LOGUNIT_TEST(testGetContentType);
+                LOGUNIT_TEST(testFormat);
+                LOGUNIT_TEST(testFormatWithNDC);
+                LOGUNIT_TEST(testLocationInfo);
+                LOGUNIT_TEST(testProperties);
+                LOGUNIT_TEST(testProblemCharacters);
+                LOGUNIT_TEST(testEscapingRandomStrings);
+        LOGUNIT_TEST_SUITE_END();
+
+public:
+    /**
+     * Clear MDC and NDC before test.
+     */
+  void setUp() {
+      NDC::clear();
+      MDC::clear();
+  }
+
+    /**
+     * Clear MDC and NDC after test.
+     */
+  void tearDown() {
+      setUp();
+  }
+
+  /**
+   * Tests getContentType.
+   */
+  void testGetContentType() {
+    LogString expected(LOG4CXX_STR("application/json"));
+    LogString actual(JSONLayout().getContentType());
+    LOGUNIT_ASSERT(expected == actual);
+  }
+
+  /**
+   * Tests formatted results.
+   */
+  void testFormat() {
+    LoggingEventPtr event = createEvent(LOG4CXX_STR("Hello, World"));
+    LogString expected(getPrefix(event));
+    expected.append(LOG4CXX_STR(",\"message\":\"Hello, World\"}"));
+    expected.append(LOG4CXX_EOL);
+    LOGUNIT_ASSERT_EQUAL(expected, format(JSONLayout(), event));
+  }
+
+  /**
+   * Tests formatted results with an NDC.
+   */
+  void testFormatWithNDC() {
+    NDC::push("NDC goes here");
+    LoggingEventPtr event = createEvent(LOG4CXX_STR("Hello, World"));
+    LogString expected(getPrefix(event));
+    expected.append(LOG4CXX_STR(",\"message\":\"Hello, World\",\"ndc\":\"NDC goes here\"}"));
+    expected.append(LOG4CXX_EOL);
+    LOGUNIT_ASSERT_EQUAL(expected, format(JSONLayout(), event));
+    NDC::pop();
+  }
+
+  /**
+   * Tests the LocationInfo option.
+   */
+  void testLocationInfo() {
+    LoggingEventPtr event(new LoggingEvent(
+        LOG4CXX_STR("org.example.JSONLayoutTest"), Level::getInfo(), LOG4CXX_STR("msg"),
+        LocationInfo("foo.cpp", "void example::Foo::bar(int)", 42)));
+    JSONLayout layout;
+    layout.setOption(LOG4CXX_STR("LocationInfo"), LOG4CXX_STR("true"));
+    LOGUNIT_ASSERT_EQUAL(true, layout.getLocationInfo());
+    LogString expected(getPrefix(event));
+    expected.append(LOG4CXX_STR(",\"message\":\"msg\",\"locationInfo\":{"
+        "\"class\":\"example::Foo\",\"method\":\"bar\",\"file\":\"foo.cpp\",\"line\":42}}"));
+    expected.append(LOG4CXX_EOL);
+    LOGUNIT_ASSERT_EQUAL(expected, format(layout, event));
+  }
+
+  /**
+   * Tests the Properties option.
+   */
+  void testProperties() {
+    MDC::put("key1", "val1");
+    MDC::put("key2", "val\"2");
+    LoggingEventPtr event = createEvent(LOG4CXX_STR("msg"));
+    JSONLayout layout;
+    layout.setOption(LOG4CXX_STR("Properties"), LOG4CXX_STR("true"));
+    LogString expected(getPrefix(event));
+    expected.append(LOG4CXX_STR(",\"message\":\"msg\","
+        "\"properties\":{\"key1\":\"val1\",\"key2\":\"val\\\"2\"}}"));
+    expected.append(LOG4CXX_EOL);
+    LOGUNIT_ASSERT_EQUAL(expected, format(layout, event));
+  }
+
+  /**
+   * Tests quotation marks, reverse solidi and control characters,
+   * both in short strings and past the first 16 characters.
+   */
+  void testProblemCharacters() {
+    LoggingEventPtr event = createEvent(
+        LOG4CXX_STR("\"quoted\" \\ path\tand a long run of ordinary text\r\n\x01"));
+    LogString expected(getPrefix(event));
+    expected.append(LOG4CXX_STR(",\"message\":\"\\\"quoted\\\" \\\\ path\\tand a long run "
+        "of ordinary text\\r\\n\\u0001\"}"));
+    expected.append(LOG4CXX_EOL);
+    LOGUNIT_ASSERT_EQUAL(expected, format(JSONLayout(), event));
+  }
+
+  /**
+   * Compares Transform::appendEscapingJSON with a character by character
+   * escaper on random strings of random lengths.
+   */
+  void testEscapingRandomStrings() {
+    const logchar alphabet[] = { 0x61, 0x62, 0x20, 0x22, 0x5C, 0x0A, 0x01, 0x1F, 0x7F, 0x7E };
+    srand(23);
+    for (int n = 0; n < 2000; n++) {
+      LogString input;
+      int length = rand() % 80;
+      for (int i = 0; i < length; i++) {
+        if (rand() % 5 == 0) {
+          input.append(1, alphabet[rand() % 10]);
+        } else {
+          input.append(1, (logchar) (0x61 + rand() % 26));
+        }
+      }
+      LogString actual(LOG4CXX_STR("x"));
+      Transform::appendEscapingJSON(actual, input);
+      LOGUNIT_ASSERT_EQUAL(LOG4CXX_STR("x") + escape(input), actual);
+    }
+  }
+
+private:
+  static LoggingEventPtr createEvent(const LogString& message) {
+    return new LoggingEvent(LOG4CXX_STR("org.example.JSONLayoutTest"),
+        Level::getInfo(), message, LOG4CXX_LOCATION);
+  }
+
+  /**
+   * The members that precede the message.
+   */
+  static LogString getPrefix(const LoggingEventPtr& event) {
+    Pool p;
+    ISO8601DateFormat dateFormat;
+    dateFormat.setTimeZone(TimeZone::getGMT());
+    LogString prefix(LOG4CXX_STR("{\"timestamp\":\""));
+    dateFormat.format(prefix, event->getTimeStamp(), p);
+    prefix.append(LOG4CXX_STR("\",\"level\":\"INFO\",\"logger\":\"org.example.JSONLayoutTest\",\"thread\":\""));
+    prefix.append(event->getThreadName());
+    prefix.append(LOG4CXX_STR("\""));
+    return prefix;
+  }
+
+  static LogString format(const Layout& layout, const LoggingEventPtr& event) {
+    Pool p;
+    LogString result;
+    layout.format(result, event, p);
+    return result;
+  }
+
+  static LogString escape(const LogString& input) {
+    const logchar hex[] = { 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+        0x38, 0x39, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66 };
+    LogString result;
+    for (LogString::const_iterator iter = input.begin(); iter != input.end(); iter++) {
+      logchar c = *iter;
+      if (c == 0x22 || c == 0x5C) {
+        result.append(1, (logchar) 0x5C);
+        result.append(1, c);
+      } else if (c == 0x0A) {
+        result.append(LOG4CXX_STR("\\n"));
+      } else if (c >= 0 && c < 0x20) {
+        result.append(LOG4CXX_STR("\\u00"));
+        result.append(1, hex[c >> 4]);
+        result.append(1, hex[c & 0x0F]);
+      } else {
+        result.append(1, c);
+      }
+    }
+    return result;
+  }
+};
+
+LOGUNIT_TEST_SUITE_REGISTRATION(JSONLayoutTest);
@@ -44,6 +44,7 @@ LOGUNIT_CLASS(LevelTestCase)
                 LOGUNIT_TEST(testCFStringToTrace);
 #endif
                 LOGUNIT_TEST(testTrimmedToTrace);
+                LOGUNIT_TEST(testInterned);
         LOGUNIT_TEST_SUITE_END();
 
 public:
@@ -124,6 +125,17 @@ public:
       LOGUNIT_ASSERT(trace->toString() == LOG4CXX_STR("TRACE"));
   }
 
+    /**
+     * Tests that built-in levels are shared instances.
+     */
+  void testInterned() {
+      LOGUNIT_ASSERT(&*Level::getDebug() == &*Level::getDebug());
+      LOGUNIT_ASSERT(&*Level::toLevel("info") == &*Level::getInfo());
+      LOGUNIT_ASSERT(&*Level::toLevel(Level::WARN_INT) == &*Level::getWarn());
+      LOGUNIT_ASSERT(Level::getError() == Level::toLevel(Level::ERROR_INT));
+      LOGUNIT_ASSERT(Level::getError() != Level::getFatal());
+  }
+
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(LevelTestCase);
@@ -30,6 +30,7 @@
 #include "logunit.h"
 #include <log4cxx/helpers/locale.h>
 #include "vectorappender.h"
+#include <log4cxx/helpers/thread.h>
 
 using namespace log4cxx;
 using namespace log4cxx::spi;
@@ -42,10 +43,18 @@ class CountingAppender : public AppenderSkeleton
 {
 public:
         int counter;
+        bool* released;
 
-        CountingAppender() : counter(0)
+        CountingAppender() : counter(0), released(0)
                 {}
 
+        ~CountingAppender()
+                {
+                  if (released != 0) {
+                    *released = true;
+                  }
+                }
+
         void close()
                 {}
 
@@ -72,6 +81,10 @@ LOGUNIT_CLASS(LoggerTestCase)
                 LOGUNIT_TEST(testHierarchy1);
                 LOGUNIT_TEST(testTrace);
                 LOGUNIT_TEST(testIsTraceEnabled);
+                LOGUNIT_TEST(testIsEnabledAfterChange);
+                LOGUNIT_TEST(testAppendersAfterChange);
+                LOGUNIT_TEST(testRemovedAppenderReleased);
+                LOGUNIT_TEST(testRemovedAppenderNotCalled);
         LOGUNIT_TEST_SUITE_END();
 
 public:
@@ -453,6 +466,131 @@ public:
         LOGUNIT_ASSERT_EQUAL(false, root->isTraceEnabled());
     }
 
+    /**
+     * Tests that the cached effective level follows changes
+     * to ancestors and to the repository threshold.
+     */
+    void testIsEnabledAfterChange() {
+        VectorAppenderPtr appender = new VectorAppender();
+        LoggerPtr root = Logger::getRootLogger();
+        root->addAppender(appender);
+        root->setLevel(Level::getInfo());
+
+        LoggerPtr deep = Logger::getLogger("com.example.a.b.c.d.e.Deep");
+        LOGUNIT_ASSERT_EQUAL(false, deep->isDebugEnabled());
+        LOGUNIT_ASSERT_EQUAL(true, deep->isInfoEnabled());
+
+        LoggerPtr ancestor = Logger::getLogger("com.example.a");
+        ancestor->setLevel(Level::getDebug());
+        LOGUNIT_ASSERT_EQUAL(true, deep->isDebugEnabled());
+
+        LogManager::getLoggerRepository()->setThreshold(Level::getWarn());
+        LOGUNIT_ASSERT_EQUAL(false, deep->isDebugEnabled());
+        LOGUNIT_ASSERT_EQUAL(false, deep->isInfoEnabled());
+        LOGUNIT_ASSERT_EQUAL(true, deep->isWarnEnabled());
+
+        LogManager::getLoggerRepository()->setThreshold(Level::getAll());
+        ancestor->setLevel(0);
+        LOGUNIT_ASSERT_EQUAL(false, deep->isDebugEnabled());
+        root->setLevel(Level::getTrace());
+        LOGUNIT_ASSERT_EQUAL(true, deep->isTraceEnabled());
+        LOGUNIT_ASSERT_EQUAL(true, deep->isEnabledFor(Level::getDebug()));
+    }
+
+    /**
+     * Tests that the appenders called for a logger follow changes
+     * to its ancestors made after it has logged.
+     */
+    void testAppendersAfterChange() {
+        LoggerPtr a = Logger::getLogger(LOG4CXX_TEST_STR("a"));
+        LoggerPtr abc = Logger::getLogger(LOG4CXX_TEST_STR("a.b.c"));
+        CountingAppenderPtr caA = new CountingAppender();
+        CountingAppenderPtr caAB = new CountingAppender();
+        a->addAppender(caA);
+
+        abc->debug(MSG);
+        LOGUNIT_ASSERT_EQUAL(1, caA->counter);
+
+        LoggerPtr ab = Logger::getLogger(LOG4CXX_TEST_STR("a.b"));
+        ab->addAppender(caAB);
+        abc->debug(MSG);
+        LOGUNIT_ASSERT_EQUAL(2, caA->counter);
+        LOGUNIT_ASSERT_EQUAL(1, caAB->counter);
+
+        ab->setAdditivity(false);
+        abc->debug(MSG);
+        LOGUNIT_ASSERT_EQUAL(2, caA->counter);
+        LOGUNIT_ASSERT_EQUAL(2, caAB->counter);
+
+        ab->removeAppender(caAB);
+        abc->debug(MSG);
+        LOGUNIT_ASSERT_EQUAL(2, caA->counter);
+        LOGUNIT_ASSERT_EQUAL(2, caAB->counter);
+
+        ab->setAdditivity(true);
+        abc->debug(MSG);
+        LOGUNIT_ASSERT_EQUAL(3, caA->counter);
+    }
+
+    void testRemovedAppenderReleased() {
+        LoggerPtr a = Logger::getLogger(LOG4CXX_TEST_STR("a"));
+        LoggerPtr abc = Logger::getLogger(LOG4CXX_TEST_STR("a.b.c"));
+        bool released = false;
+        {
+          CountingAppenderPtr caA = new CountingAppender();
+          caA->released = &released;
+          a->addAppender(caA);
+          a->debug(MSG);
+          abc->debug(MSG);
+          LOGUNIT_ASSERT_EQUAL(2, caA->counter);
+          a->removeAppender(caA);
+        }
+        // neither logger's appender snapshot still holds it
+        LOGUNIT_ASSERT_EQUAL(true, released);
+    }
+
+    /**
+     * Tests that an appender removed while another thread logs
+     * is no longer called once the removal has returned.
+     */
+    void testRemovedAppenderNotCalled() {
+        LoggerPtr a = Logger::getLogger(LOG4CXX_TEST_STR("a"));
+        CountingAppenderPtr caA = new CountingAppender();
+        CountingAppenderPtr caABC = new CountingAppender();
+        a->addAppender(caA);
+        LogRepeatedly args = { Logger::getLogger(LOG4CXX_TEST_STR("a.b.c")), false };
+        args.logger->addAppender(caABC);
+
+        Thread thread;
+        thread.run(logRepeatedly, &args);
+        waitForCounter(caA, 1);
+        a->removeAppender(caA);
+        int counter = caA->counter;
+        waitForCounter(caABC, caABC->counter + 1000);
+        args.stop = true;
+        thread.join();
+        LOGUNIT_ASSERT_EQUAL(counter, caA->counter);
+    }
+
+    struct LogRepeatedly {
+        LoggerPtr logger;
+        volatile bool stop;
+    };
+
+    static void* LOG4CXX_THREAD_FUNC logRepeatedly(apr_thread_t*, void* data) {
+        LogRepeatedly* args = (LogRepeatedly*) data;
+        while(!args->stop) {
+            args->logger->debug(MSG);
+        }
+        return 0;
+    }
+
+    static void waitForCounter(const CountingAppenderPtr& appender, int counter) {
+        while(*(volatile int*) &appender->counter < counter) {
+            Thread::sleep(1);
+        }
+    }
+
 protected:
         static LogString MSG;
         LoggerPtr logger;
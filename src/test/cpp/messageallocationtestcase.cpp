@@ -0,0 +1,145 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logger.h>
+#include <log4cxx/logmanager.h>
+#include <log4cxx/spi/loggingevent.h>
+#include <log4cxx/spi/location/locationinfo.h>
+#include "logunit.h"
+#include "vectorappender.h"
+#include <log4cxx/private/log4cxx_private.h>
+#include <new>
+#include <stdlib.h>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::spi;
+
+#if LOG4CXX_CHARSET_UTF8 && LOG4CXX_LOGCHAR_IS_UTF8
+
+//
+//   Counts the heap allocations big enough to hold the
+//   test message, which are the copies of the message itself.
+//
+#define MESSAGE_SIZE 4096
+
+static bool countAllocations = false;
+static int messageAllocations = 0;
+
+#if __cplusplus >= 201103L
+void* operator new(size_t size)
+#else
+void* operator new(size_t size) throw(std::bad_alloc)
+#endif
+{
+        if (countAllocations && size >= MESSAGE_SIZE)
+        {
+                messageAllocations++;
+        }
+
+        void* ptr = malloc(size == 0 ? 1 : size);
+
+        if (ptr == 0)
+        {
+                throw std::bad_alloc();
+        }
+
+        return ptr;
+}
+
+void operator delete(void* ptr) throw()
+{
+        free(ptr);
+}
+
+/**
+ *  Checks that a message is copied once on its way
+ *  from the logging request into the event.
+ */
+LOGUNIT_CLASS(MessageAllocationTestCase)
+{
+        LOGUNIT_TEST_SUITE(MessageAllocationTestCase);
+                LOGUNIT_TEST(testMacro);
+                LOGUNIT_TEST(testView);
+                LOGUNIT_TEST(testSwap);
+        LOGUNIT_TEST_SUITE_END();
+
+        LoggerPtr logger;
+        VectorAppenderPtr appender;
+        std::string message;
+
+public:
+        void setUp()
+        {
+                logger = Logger::getLogger("MessageAllocationTestCase");
+                appender = new VectorAppender();
+                logger->addAppender(appender);
+                logger->setLevel(Level::getInfo());
+                message.assign(MESSAGE_SIZE, 'x');
+                appender->vector.reserve(10);
+                //  warm up per-thread caches
+                LOG4CXX_INFO(logger, "warm up");
+                appender->vector.clear();
+        }
+
+        void tearDown()
+        {
+                countAllocations = false;
+                appender = 0;
+                logger = 0;
+                LogManager::shutdown();
+        }
+
+        void testMacro()
+        {
+                messageAllocations = 0;
+                countAllocations = true;
+                LOG4CXX_INFO(logger, message);
+                countAllocations = false;
+                LOGUNIT_ASSERT_EQUAL(1, messageAllocations);
+                LOGUNIT_ASSERT_EQUAL((size_t) 1, appender->vector.size());
+                LOGUNIT_ASSERT(appender->vector[0]->getMessage() == message);
+        }
+
+        void testView()
+        {
+                messageAllocations = 0;
+                countAllocations = true;
+                logger->forcedLog(Level::getInfo(), message.data(), message.size(),
+                        LocationInfo::getLocationUnavailable());
+                countAllocations = false;
+                LOGUNIT_ASSERT_EQUAL(1, messageAllocations);
+                LOGUNIT_ASSERT(appender->vector[0]->getMessage() == message);
+        }
+
+        void testSwap()
+        {
+                std::string copy(message);
+                messageAllocations = 0;
+                countAllocations = true;
+                logger->forcedLogSwap(Level::getInfo(), copy,
+                        LocationInfo::getLocationUnavailable());
+                countAllocations = false;
+                LOGUNIT_ASSERT_EQUAL(0, messageAllocations);
+                LOGUNIT_ASSERT(copy.empty());
+                LOGUNIT_ASSERT(appender->vector[0]->getMessage() == message);
+        }
+};
+
+LOGUNIT_TEST_SUITE_REGISTRATION(MessageAllocationTestCase);
+
+#endif
@@ -34,6 +34,7 @@
 #include <log4cxx/pattern/loggerpatternconverter.h>
 #include <log4cxx/pattern/literalpatternconverter.h>
 #include <log4cxx/helpers/loglog.h>
+#include <log4cxx/helpers/internedstrings.h>
 #include <log4cxx/pattern/classnamepatternconverter.h>
 #include <log4cxx/pattern/datepatternconverter.h>
 #include <log4cxx/pattern/filedatepatternconverter.h>
@@ -71,6 +72,7 @@ LOGUNIT_CLASS(PatternParserTestCase)
       LOGUNIT_TEST(testBasic1);
       LOGUNIT_TEST(testBasic2);
       LOGUNIT_TEST(testMultiOption);
+      LOGUNIT_TEST(testCachedAbbreviation);
    LOGUNIT_TEST_SUITE_END();
 
    LoggingEventPtr event;
@@ -231,6 +233,54 @@ public:
        expected);
    }
 
+   /**
+    * Abbreviations are cached after the first event, check that
+    * repeated and interleaved names still get their own abbreviation,
+    * and that logger names that are not interned are not cached.
+    */
+   void testCachedAbbreviation()  {
+     std::vector<LogString> options;
+     options.push_back(LOG4CXX_STR("1"));
+     PatternConverterPtr loggerConverter(LoggerPatternConverter::newInstance(options));
+     PatternConverterPtr classConverter(ClassNamePatternConverter::newInstance(options));
+
+     LogString foo(LOG4CXX_STR("org.foobar.Foo"));
+     LogString bar(LOG4CXX_STR("org.foobar.Bar"));
+     const char* function = "void org::foobar::Foo::method(int)";
+     LoggingEventPtr events[] = {
+        new LoggingEvent(foo, Level::getInfo(), LOG4CXX_STR("msg"),
+            LocationInfo("foo.cpp", function, 10), InternedStrings::intern(foo)),
+        new LoggingEvent(bar, Level::getInfo(), LOG4CXX_STR("msg"),
+            LocationInfo("bar.cpp", "void org::foobar::Bar::method()", 20),
+            InternedStrings::intern(bar)),
+        new LoggingEvent(foo, Level::getInfo(), LOG4CXX_STR("msg"),
+            LocationInfo("foo.cpp", function, 30), InternedStrings::intern(foo)),
+        new LoggingEvent(LOG4CXX_STR("org.foobar.Baz"), Level::getInfo(), LOG4CXX_STR("msg"),
+            LocationInfo("baz.cpp", "void org::foobar::Baz::method()", 40))
+     };
+     const logchar* expected[] = { LOG4CXX_STR("Foo"), LOG4CXX_STR("Bar"), LOG4CXX_STR("Foo"),
+        LOG4CXX_STR("Baz") };
+     //  class names are separated by "::", not abbreviated
+     const logchar* expectedClass[] = { LOG4CXX_STR("org::foobar::Foo"),
+        LOG4CXX_STR("org::foobar::Bar"), LOG4CXX_STR("org::foobar::Foo"),
+        LOG4CXX_STR("org::foobar::Baz") };
+
+     LOGUNIT_ASSERT(InternedStrings::intern(foo) == InternedStrings::intern(LogString(foo)));
+     LOGUNIT_ASSERT(InternedStrings::intern(foo) != InternedStrings::intern(bar));
+
+     Pool p;
+     for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < 4; i++) {
+           LogString actual(LOG4CXX_STR("x"));
+           loggerConverter->format(events[i], actual, p);
+           LOGUNIT_ASSERT_EQUAL(LogString(LOG4CXX_STR("x")) + expected[i], actual);
+           actual = LOG4CXX_STR("x");
+           classConverter->format(events[i], actual, p);
+           LOGUNIT_ASSERT_EQUAL(LogString(LOG4CXX_STR("x")) + expectedClass[i], actual);
+        }
+     }
+   }
+
 };
 
 //
@@ -40,6 +40,7 @@
 #include "logunit.h"
 #include <log4cxx/spi/loggerrepository.h>
 #include <log4cxx/helpers/stringhelper.h>
+#include <log4cxx/spi/loggingevent.h>
 
 
 #define REGEX_STR(x) x
@@ -77,6 +78,7 @@ LOGUNIT_CLASS(PatternLayoutTest)
                 LOGUNIT_TEST(test12);
                 LOGUNIT_TEST(testMDC1);
                 LOGUNIT_TEST(testMDC2);
+                LOGUNIT_TEST(testCompiledPattern);
         LOGUNIT_TEST_SUITE_END();
 
         LoggerPtr root;
@@ -505,6 +507,44 @@ public:
                 LOGUNIT_ASSERT(Compare::compare(OUTPUT_FILE, WITNESS_FILE));
         }
 
+        /**
+         * Checks fused literals, padding and truncation of the
+         * built-in steps, and formatting after existing output.
+         */
+        void testCompiledPattern()
+        {
+                spi::LoggingEventPtr event(new spi::LoggingEvent(
+                        LOG4CXX_STR("org.example.Foo"), Level::getInfo(), LOG4CXX_STR("hello"),
+                        spi::LocationInfo::getLocationUnavailable()));
+
+                LogString expected(LOG4CXX_STR("xINFO | INFO|FO|[org.example.Foo]|Foo|hello"));
+                expected.append(LOG4CXX_EOL);
+                LOGUNIT_ASSERT_EQUAL(expected,
+                        format(LOG4CXX_STR("%-5p|%5p|%.2p|[%c]|%c{1}|%m%n"), event, LOG4CXX_STR("x")));
+
+                expected = LOG4CXX_STR("a");
+                expected.append(LOG4CXX_EOL);
+                expected.append(LOG4CXX_STR("bohellohello"));
+                LOGUNIT_ASSERT_EQUAL(expected,
+                        format(LOG4CXX_STR("a%nb%3.1m%m%m"), event, LogString()));
+
+                LogString thread(event->getThreadName());
+                thread.append(LOG4CXX_STR("|"));
+                thread.append(event->getThreadName());
+                LOGUNIT_ASSERT_EQUAL(thread,
+                        format(LOG4CXX_STR("%t|%thread"), event, LogString()));
+        }
+
+        static LogString format(const LogString& pattern,
+                const spi::LoggingEventPtr& event, const LogString& initial)
+        {
+                PatternLayout layout(pattern);
+                LogString output(initial);
+                Pool p;
+                layout.format(output, event, p);
+                return output;
+        }
+
        std::string createMessage(Pool& pool, int i) {
          std::string msg("Message ");
          msg.append(pool.itoa(i));
@@ -32,6 +32,7 @@
 #include <log4cxx/consoleappender.h>
 #include <log4cxx/helpers/exception.h>
 #include <log4cxx/helpers/fileoutputstream.h>
+#include <log4cxx/private/log4cxx_private.h>
 
 
 using namespace log4cxx;
@@ -55,6 +56,10 @@ LOGUNIT_CLASS(SizeBasedRollingTest)  {
            LOGUNIT_TEST(test4);
            LOGUNIT_TEST(test5);
            LOGUNIT_TEST(test6);
+           LOGUNIT_TEST(test7);
+#if LOG4CXX_HAVE_ZSTD
+           LOGUNIT_TEST(test8);
+#endif
    LOGUNIT_TEST_SUITE_END();
 
    LoggerPtr root;
@@ -195,14 +200,22 @@ LOGUNIT_CLASS(SizeBasedRollingTest)  {
     root->addAppender(rfa);
 
     common(logger, 100);
+    // waits for the background compression
+    rfa->close();
 
     LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test3.log").exists(p));
     LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test3.0.gz").exists(p));
     LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test3.1.gz").exists(p));
 
     LOGUNIT_ASSERT_EQUAL(true, Compare::compare(File("output/sbr-test3.log"),  File("witness/rolling/sbr-test3.log")));
+#if LOG4CXX_HAVE_ZLIB
+    // the gzip command also stores the file name, so only the contents match
+    LOGUNIT_ASSERT_EQUAL(true, Compare::gzCompare(File("output/sbr-test3.0.gz"), File("witness/rolling/sbr-test3.0.gz")));
+    LOGUNIT_ASSERT_EQUAL(true, Compare::gzCompare(File("output/sbr-test3.1.gz"), File("witness/rolling/sbr-test3.1.gz")));
+#else
     LOGUNIT_ASSERT_EQUAL(File("witness/rolling/sbr-test3.0.gz").length(p), File("output/sbr-test3.0.gz").length(p));
     LOGUNIT_ASSERT_EQUAL(File("witness/rolling/sbr-test3.1.gz").length(p), File("output/sbr-test3.1.gz").length(p));
+#endif
   }
 
   /**
@@ -337,6 +350,7 @@ LOGUNIT_CLASS(SizeBasedRollingTest)  {
     root->addAppender(rfa);
 
     common(logger, 100);
+    rfa->close();
 
     LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test6.log").exists(p));
     LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test6.0.zip").exists(p));
@@ -344,7 +358,93 @@ LOGUNIT_CLASS(SizeBasedRollingTest)  {
 
     LOGUNIT_ASSERT_EQUAL(true, Compare::compare(File("output/sbr-test6.log"),  File("witness/rolling/sbr-test3.log")));
   }
-  
+
+  /**
+   * Same as test2 but writing through a memory mapping, so rolled
+   * files must be truncated to their content.
+   */
+  void test7() {
+    PatternLayoutPtr layout = new PatternLayout(LOG4CXX_STR("%m\n"));
+    RollingFileAppenderPtr rfa = new RollingFileAppender();
+    rfa->setName(LOG4CXX_STR("ROLLING"));
+    rfa->setAppend(false);
+    rfa->setLayout(layout);
+    rfa->setFile(LOG4CXX_STR("output/sizeBased-test7.log"));
+    rfa->setMemoryMapped(true);
+
+    FixedWindowRollingPolicyPtr swrp = new FixedWindowRollingPolicy();
+    SizeBasedTriggeringPolicyPtr sbtp = new SizeBasedTriggeringPolicy();
+
+    sbtp->setMaxFileSize(100);
+    swrp->setMinIndex(0);
+
+    swrp->setFileNamePattern(LOG4CXX_STR("output/sizeBased-test7.%i"));
+    Pool p;
+    swrp->activateOptions(p);
+
+    rfa->setRollingPolicy(swrp);
+    rfa->setTriggeringPolicy(sbtp);
+    rfa->activateOptions(p);
+    root->addAppender(rfa);
+
+    common(logger, 0);
+    rfa->close();
+
+    LOGUNIT_ASSERT_EQUAL(true, File("output/sizeBased-test7.log").exists(p));
+    LOGUNIT_ASSERT_EQUAL(true, File("output/sizeBased-test7.0").exists(p));
+    LOGUNIT_ASSERT_EQUAL(true, File("output/sizeBased-test7.1").exists(p));
+
+    LOGUNIT_ASSERT_EQUAL(true, Compare::compare(File("output/sizeBased-test7.log"),
+     File("witness/rolling/sbr-test2.log")));
+    LOGUNIT_ASSERT_EQUAL(true, Compare::compare(File("output/sizeBased-test7.0"),
+     File("witness/rolling/sbr-test2.0")));
+    LOGUNIT_ASSERT_EQUAL(true, Compare::compare(File("output/sizeBased-test7.1"),
+     File("witness/rolling/sbr-test2.1")));
+  }
+
+#if LOG4CXX_HAVE_ZSTD
+  /**
+   * Same as test3 but compressing into zstd on several threads.
+   */
+  void test8() {
+    PatternLayoutPtr layout = new PatternLayout(LOG4CXX_STR("%m\n"));
+    RollingFileAppenderPtr rfa = new RollingFileAppender();
+    rfa->setAppend(false);
+    rfa->setLayout(layout);
+
+    FixedWindowRollingPolicyPtr  fwrp = new FixedWindowRollingPolicy();
+    SizeBasedTriggeringPolicyPtr sbtp = new SizeBasedTriggeringPolicy();
+
+    sbtp->setMaxFileSize(100);
+    fwrp->setMinIndex(0);
+    rfa->setFile(LOG4CXX_STR("output/sbr-test8.log"));
+    fwrp->setFileNamePattern(LOG4CXX_STR("output/sbr-test8.%i.zst"));
+    fwrp->setOption(LOG4CXX_STR("CompressionLevel"), LOG4CXX_STR("19"));
+    fwrp->setOption(LOG4CXX_STR("CompressionThreads"), LOG4CXX_STR("2"));
+    LOGUNIT_ASSERT_EQUAL(19, fwrp->getCompressionLevel());
+    LOGUNIT_ASSERT_EQUAL(2, fwrp->getCompressionThreads());
+    Pool p;
+    fwrp->activateOptions(p);
+    rfa->setRollingPolicy(fwrp);
+    rfa->setTriggeringPolicy(sbtp);
+    rfa->activateOptions(p);
+    root->addAppender(rfa);
+
+    common(logger, 100);
+    rfa->close();
+
+    LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test8.log").exists(p));
+    LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test8.0.zst").exists(p));
+    LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test8.1.zst").exists(p));
+    LOGUNIT_ASSERT_EQUAL(false, File("output/sbr-test8.0").exists(p));
+
+    LOGUNIT_ASSERT_EQUAL(true, Compare::compare(File("output/sbr-test8.log"),  File("witness/rolling/sbr-test3.log")));
+    // the compression level and threads do not change the contents
+    LOGUNIT_ASSERT_EQUAL(true, Compare::zstdCompare(File("output/sbr-test8.0.zst"), File("witness/rolling/sbr-test3.0.zst")));
+    LOGUNIT_ASSERT_EQUAL(true, Compare::zstdCompare(File("output/sbr-test8.1.zst"), File("witness/rolling/sbr-test3.1.zst")));
+  }
+#endif
+
 };
 
 
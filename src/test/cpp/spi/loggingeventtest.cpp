@@ -19,6 +19,9 @@
 #include <log4cxx/logmanager.h>
 #include <log4cxx/ndc.h>
 #include <log4cxx/mdc.h>
+#include <log4cxx/helpers/thread.h>
+#include <log4cxx/helpers/threadname.h>
+#include <vector>
 #include "../logunit.h"
 
 using namespace log4cxx;
@@ -38,6 +41,10 @@ LOGUNIT_CLASS(LoggingEventTest)
                 LOGUNIT_TEST(testSerializationWithLocation);
                 LOGUNIT_TEST(testSerializationNDC);
                 LOGUNIT_TEST(testSerializationMDC);
+                LOGUNIT_TEST(testRecycled);
+                LOGUNIT_TEST(testReleasedOnOtherThread);
+                LOGUNIT_TEST(testThreadNameShared);
+                LOGUNIT_TEST(testSetThreadName);
          LOGUNIT_TEST_SUITE_END();
 
 public:
@@ -116,6 +123,93 @@ public:
       "witness/serialization/mdc.bin", event, 237));
   }
 
+  /**
+   * An event released on the thread that created it
+   * is reused by the next event created on that thread.
+   */
+  void testRecycled() {
+    LoggingEventPtr event =
+      new LoggingEvent(
+        LOG4CXX_STR("root"), Level::getInfo(), LOG4CXX_STR("Hello, world."), LocationInfo::getLocationUnavailable());
+    const LoggingEvent* first = event;
+    event = 0;
+
+    event = new LoggingEvent(
+        LOG4CXX_STR("root"), Level::getInfo(), LOG4CXX_STR("Hello, again."), LocationInfo::getLocationUnavailable());
+    LOGUNIT_ASSERT(first == (const LoggingEvent*) event);
+    LOGUNIT_ASSERT(LOG4CXX_STR("Hello, again.") == event->getMessage());
+  }
+
+  /**
+   * An event released by another thread, as by the AsyncAppender
+   * dispatcher, goes back to the thread that created it.
+   */
+  void testReleasedOnOtherThread() {
+    LoggingEventPtr event =
+      new LoggingEvent(
+        LOG4CXX_STR("root"), Level::getInfo(), LOG4CXX_STR("Hello, world."), LocationInfo::getLocationUnavailable());
+    const LoggingEvent* first = event;
+    LoggingEvent* released = event;
+    released->addRef();
+    event = 0;
+
+    Thread thread;
+    thread.run(release, released);
+    thread.join();
+
+    //
+    //   blocks returned by other threads are taken over
+    //      once the recycled blocks on this thread run out
+    std::vector<LoggingEventPtr> events;
+    bool reused = false;
+    for(int i = 0; i < 1000 && !reused; i++) {
+      events.push_back(new LoggingEvent(
+        LOG4CXX_STR("root"), Level::getInfo(), LOG4CXX_STR("Hello, again."), LocationInfo::getLocationUnavailable()));
+      reused = (first == (const LoggingEvent*) events.back());
+    }
+    LOGUNIT_ASSERT(reused);
+  }
+
+  /**
+   * Events created by one thread share its rendered name.
+   */
+  void testThreadNameShared() {
+    LoggingEventPtr first =
+      new LoggingEvent(
+        LOG4CXX_STR("root"), Level::getInfo(), LOG4CXX_STR("Hello, world."), LocationInfo::getLocationUnavailable());
+    LoggingEventPtr second =
+      new LoggingEvent(
+        LOG4CXX_STR("root"), Level::getInfo(), LOG4CXX_STR("Hello, again."), LocationInfo::getLocationUnavailable());
+    LOGUNIT_ASSERT(&first->getThreadName() == &second->getThreadName());
+    LOGUNIT_ASSERT(ThreadName::getCurrentThreadId() == first->getThreadName());
+  }
+
+  /**
+   * A name set for the thread is used by events created afterwards
+   * while events created before keep the name they were created with.
+   */
+  void testSetThreadName() {
+    LoggingEventPtr before =
+      new LoggingEvent(
+        LOG4CXX_STR("root"), Level::getInfo(), LOG4CXX_STR("Hello, world."), LocationInfo::getLocationUnavailable());
+    LogString original(before->getThreadName());
+
+    ThreadName::setCurrentThreadName(LOG4CXX_STR("main"));
+    LoggingEventPtr after =
+      new LoggingEvent(
+        LOG4CXX_STR("root"), Level::getInfo(), LOG4CXX_STR("Hello, again."), LocationInfo::getLocationUnavailable());
+    ThreadName::setCurrentThreadName(original);
+
+    LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("main"), after->getThreadName());
+    LOGUNIT_ASSERT_EQUAL(original, before->getThreadName());
+  }
+
+private:
+  static void* LOG4CXX_THREAD_FUNC release(apr_thread_t*, void* data) {
+    reinterpret_cast<LoggingEvent*>(data)->releaseRef();
+    return NULL;
+  }
+
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(LoggingEventTest);
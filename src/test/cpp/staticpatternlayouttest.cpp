@@ -0,0 +1,258 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logger.h>
+#include <log4cxx/staticpatternlayout.h>
+#include <log4cxx/patternlayout.h>
+#include <log4cxx/fileappender.h>
+#include <log4cxx/pattern/loggerpatternconverter.h>
+#include <log4cxx/spi/loggerrepository.h>
+#include <log4cxx/helpers/pool.h>
+
+#include "util/compare.h"
+#include "testchar.h"
+#include "logunit.h"
+
+//
+//   patterns are parsed while compiling where the pattern string
+//      is a constant expression
+//
+#if (__cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1910)) \
+        && !LOG4CXX_LOGCHAR_IS_UNICHAR
+        #define PARSED_PATTERNS 1
+#else
+        #define PARSED_PATTERNS 0
+#endif
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::pattern;
+
+namespace
+{
+struct AbsoluteOption
+{
+        static const logchar* value()
+        {
+                return LOG4CXX_STR("ABSOLUTE");
+        }
+};
+
+struct PrecisionOption
+{
+        static const logchar* value()
+        {
+                return LOG4CXX_STR("1");
+        }
+};
+
+//  %-5p - %m%n
+typedef StaticPatternLayout<Formatted<LevelField, true, 5>,
+        Text<' ', '-', ' '>, MessageField, LineSeparatorField> Layout1;
+
+//  %d{ABSOLUTE} [%t] %-5p %.16c - %m%n
+typedef StaticPatternLayout<ConverterField<DatePatternConverter, AbsoluteOption>,
+        Text<' ', '['>, ThreadField, Text<']', ' '>,
+        Formatted<LevelField, true, 5>, Text<' '>,
+        Formatted<LoggerField, false, 0, 16>,
+        Text<' ', '-', ' '>, MessageField, LineSeparatorField> Layout2;
+
+//  %r|%5p|%.2p|%c{1}|%x|%d|%m%n
+typedef StaticPatternLayout<RelativeTimeField, Text<'|'>,
+        Formatted<LevelField, false, 5>, Text<'|'>,
+        Formatted<LevelField, false, 0, 2>, Text<'|'>,
+        ConverterField<LoggerPatternConverter, PrecisionOption>, Text<'|'>,
+        NDCField, Text<'|'>, DateField, Text<'|'>,
+        MessageField, LineSeparatorField> Layout3;
+
+#if PARSED_PATTERNS
+#define STATIC_PATTERN(name, pattern) \
+        struct name \
+        { \
+                static constexpr const logchar* value() \
+                { \
+                        return LOG4CXX_STR(pattern); \
+                } \
+        }
+
+STATIC_PATTERN(Pattern1, "%-5p - %m%n");
+STATIC_PATTERN(Pattern2, "%d{ABSOLUTE} [%t] %-5p %.16c - %m%n");
+STATIC_PATTERN(Pattern3, "%r|%5p|%.2p|%c{1}|%x|%d|%m%n");
+STATIC_PATTERN(Pattern4, "%level %-20.10logger{2} 100%% %mx%n");
+STATIC_PATTERN(Pattern5, "%date{HH:mm:ss}{GMT} %C %X{user}%message %");
+#endif
+}
+
+LOGUNIT_CLASS(StaticPatternLayoutTest)
+{
+        LOGUNIT_TEST_SUITE(StaticPatternLayoutTest);
+                LOGUNIT_TEST(testWitness);
+                LOGUNIT_TEST(testSameAsPatternLayout);
+#if PARSED_PATTERNS
+                LOGUNIT_TEST(testParsedWitness);
+                LOGUNIT_TEST(testParsedSameAsPatternLayout);
+#endif
+        LOGUNIT_TEST_SUITE_END();
+
+        LoggerPtr root;
+        LoggerPtr logger;
+
+public:
+        void setUp()
+        {
+                root = Logger::getRootLogger();
+                logger = Logger::getLogger(LOG4CXX_TEST_STR("java.org.apache.log4j.PatternLayoutTest"));
+        }
+
+        void tearDown()
+        {
+                root->getLoggerRepository()->resetConfiguration();
+        }
+
+        /**
+         *   Writes the same events as PatternLayoutTest::test1.
+         */
+        void testWitness()
+        {
+                assertWitness(new Layout1());
+        }
+
+        void testSameAsPatternLayout()
+        {
+                spi::LoggingEventPtr event(createEvent());
+                spi::LoggingEventPtr longer(createLongerEvent());
+
+                Layout1 layout1;
+                assertSame(LOG4CXX_STR("%-5p - %m%n"), layout1, event);
+                assertSame(LOG4CXX_STR("%-5p - %m%n"), layout1, longer);
+
+                Layout2 layout2;
+                assertSame(LOG4CXX_STR("%d{ABSOLUTE} [%t] %-5p %.16c - %m%n"), layout2, event);
+                assertSame(LOG4CXX_STR("%d{ABSOLUTE} [%t] %-5p %.16c - %m%n"), layout2, longer);
+
+                Layout3 layout3;
+                assertSame(LOG4CXX_STR("%r|%5p|%.2p|%c{1}|%x|%d|%m%n"), layout3, event);
+                assertSame(LOG4CXX_STR("%r|%5p|%.2p|%c{1}|%x|%d|%m%n"), layout3, longer);
+        }
+
+#if PARSED_PATTERNS
+        void testParsedWitness()
+        {
+                assertWitness(new StaticPatternLayout<Parsed<Pattern1> >());
+        }
+
+        void testParsedSameAsPatternLayout()
+        {
+                spi::LoggingEventPtr event(createEvent());
+                spi::LoggingEventPtr longer(createLongerEvent());
+                longer->setProperty(LOG4CXX_STR("user"), LOG4CXX_STR("alice"));
+                assertParsed<Pattern1>(event, longer);
+                assertParsed<Pattern2>(event, longer);
+                assertParsed<Pattern3>(event, longer);
+                assertParsed<Pattern4>(event, longer);
+                assertParsed<Pattern5>(event, longer);
+        }
+#endif
+
+private:
+        void assertWitness(const LayoutPtr& layout)
+        {
+                AppenderPtr appender(new FileAppender(layout, TEMP, false));
+                root->addAppender(appender);
+
+                Pool pool;
+
+                for (int i = 0; i < 5; i++)
+                {
+                        LevelPtr level;
+
+                        switch (i)
+                        {
+                                case 0:
+                                        level = Level::getDebug();
+                                        break;
+
+                                case 1:
+                                        level = Level::getInfo();
+                                        break;
+
+                                case 2:
+                                        level = Level::getWarn();
+                                        break;
+
+                                case 3:
+                                        level = Level::getError();
+                                        break;
+
+                                default:
+                                        level = Level::getFatal();
+                        }
+
+                        std::string msg("Message ");
+                        msg.append(pool.itoa(i));
+                        LOG4CXX_LOG(logger, level, msg);
+                        LOG4CXX_LOG(root, level, msg);
+                }
+
+                root->removeAppender(appender);
+                appender->close();
+                LOGUNIT_ASSERT(Compare::compare(TEMP, LOG4CXX_FILE("witness/patternLayout.1")));
+        }
+
+        void assertSame(const LogString& pattern, const Layout& layout,
+                const spi::LoggingEventPtr& event)
+        {
+                Pool p;
+                PatternLayout patternLayout(pattern);
+                LogString expected(LOG4CXX_STR("x"));
+                patternLayout.format(expected, event, p);
+                LogString actual(LOG4CXX_STR("x"));
+                layout.format(actual, event, p);
+                LOGUNIT_ASSERT_EQUAL(expected, actual);
+        }
+
+#if PARSED_PATTERNS
+        template<class Pattern>
+        void assertParsed(const spi::LoggingEventPtr& event,
+                const spi::LoggingEventPtr& longer)
+        {
+                StaticPatternLayout<Parsed<Pattern> > layout;
+                assertSame(Pattern::value(), layout, event);
+                assertSame(Pattern::value(), layout, longer);
+        }
+#endif
+
+        static spi::LoggingEventPtr createEvent()
+        {
+                return new spi::LoggingEvent(
+                        LOG4CXX_STR("org.example.Foo"), Level::getInfo(), LOG4CXX_STR("hello"),
+                        spi::LocationInfo::getLocationUnavailable());
+        }
+
+        static spi::LoggingEventPtr createLongerEvent()
+        {
+                return new spi::LoggingEvent(
+                        LOG4CXX_STR("org.example.deeply.nested.Foo"), Level::getError(), LOG4CXX_STR("world"),
+                        spi::LocationInfo::getLocationUnavailable());
+        }
+
+        static const LogString TEMP;
+};
+
+const LogString StaticPatternLayoutTest::TEMP(LOG4CXX_STR("output/temp"));
+
+LOGUNIT_TEST_SUITE_REGISTRATION(StaticPatternLayoutTest);
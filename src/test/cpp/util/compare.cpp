@@ -22,6 +22,17 @@
 #include <log4cxx/helpers/fileinputstream.h>
 #include <log4cxx/helpers/inputstreamreader.h>
 #include <log4cxx/helpers/systemoutwriter.h>
+#include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/private/log4cxx_private.h>
+
+#if LOG4CXX_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#if LOG4CXX_HAVE_ZSTD
+#include <zstd.h>
+#include <stdio.h>
+#include <vector>
+#endif
 
 using namespace log4cxx;
 using namespace log4cxx::helpers;
@@ -96,6 +107,75 @@ bool Compare::compare(const File& file1, const File& file2)
         return true;
 }
 
+#if LOG4CXX_HAVE_ZLIB
+namespace {
+    bool gunzip(const File& file, std::string& contents)
+    {
+        LOG4CXX_ENCODE_CHAR(path, file.getPath());
+        gzFile gz = gzopen(path.c_str(), "rb");
+        if (gz == NULL) {
+            return false;
+        }
+        char buf[4096];
+        int count;
+        while ((count = gzread(gz, buf, sizeof(buf))) > 0) {
+            contents.append(buf, count);
+        }
+        gzclose(gz);
+        return count == 0;
+    }
+}
+
+bool Compare::gzCompare(const File& file1, const File& file2)
+{
+    std::string in1;
+    std::string in2;
+    return gunzip(file1, in1) && gunzip(file2, in2) && in1 == in2;
+}
+#endif
+
+#if LOG4CXX_HAVE_ZSTD
+namespace {
+    bool unzstd(const File& file, std::string& contents)
+    {
+        LOG4CXX_ENCODE_CHAR(path, file.getPath());
+        FILE* in = fopen(path.c_str(), "rb");
+        if (in == NULL) {
+            return false;
+        }
+        ZSTD_DCtx* dctx = ZSTD_createDCtx();
+        std::vector<char> inBuf(ZSTD_DStreamInSize());
+        std::vector<char> outBuf(ZSTD_DStreamOutSize());
+        size_t remaining = 0;
+        size_t count;
+        while ((count = fread(&inBuf[0], 1, inBuf.size(), in)) > 0) {
+            ZSTD_inBuffer input = { &inBuf[0], count, 0 };
+            while (input.pos < input.size) {
+                ZSTD_outBuffer output = { &outBuf[0], outBuf.size(), 0 };
+                remaining = ZSTD_decompressStream(dctx, &output, &input);
+                if (ZSTD_isError(remaining)) {
+                    ZSTD_freeDCtx(dctx);
+                    fclose(in);
+                    return false;
+                }
+                contents.append(&outBuf[0], output.pos);
+            }
+        }
+        ZSTD_freeDCtx(dctx);
+        fclose(in);
+        // a complete frame leaves nothing to be flushed
+        return remaining == 0;
+    }
+}
+
+bool Compare::zstdCompare(const File& file1, const File& file2)
+{
+    std::string in1;
+    std::string in2;
+    return unzstd(file1, in1) && unzstd(file2, in2) && in1 == in2;
+}
+#endif
+
 void Compare::outputFile(const File& file,
                         const LogString& contents,
                         log4cxx::helpers::Pool& pool)
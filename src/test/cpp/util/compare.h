@@ -30,6 +30,16 @@ namespace log4cxx
                 static bool compare(const File& file1,
                   const File& file2);
 
+                /// Compares the decompressed contents of two gzip files,
+                /// available when built with zlib.
+                static bool gzCompare(const File& file1,
+                  const File& file2);
+
+                /// Compares the decompressed contents of two zstd files,
+                /// available when built with libzstd.
+                static bool zstdCompare(const File& file1,
+                  const File& file2);
+
         private:
                 /// Prints file on the console.
                 static void outputFile(const File& file,